@@ -0,0 +1,223 @@
+#include "coinbase_dtc_core/core/util/decimal.hpp"
+#include "coinbase_dtc_core/exchanges/coinbase/message_parser.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Microbenchmark: find()/substr()/stod() field extraction (the previous feed
+// parsing) vs. the single-pass parse_feed_message() over recorded feed data,
+// and std::stod vs. util::parse_decimal on the prices and sizes it contains.
+//
+// Usage: bench_coinbase_parser [feed.jsonl] [passes]
+
+using namespace open_dtc_server::feed::coinbase;
+
+#ifndef BENCH_DATA_DIR
+#define BENCH_DATA_DIR "benchmarks/data"
+#endif
+
+namespace
+{
+    volatile uint64_t g_sink = 0;
+
+    template <typename Fn>
+    void run(const std::string &name, const std::vector<std::string> &messages, size_t passes, Fn &&fn)
+    {
+        uint64_t checksum = 0;
+
+        // Warm up caches and the allocator
+        for (const std::string &message : messages)
+        {
+            checksum += fn(message);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for (size_t pass = 0; pass < passes; pass++)
+        {
+            for (const std::string &message : messages)
+            {
+                checksum += fn(message);
+            }
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        g_sink = g_sink + checksum;
+
+        double count = static_cast<double>(passes * messages.size());
+        double ns = std::chrono::duration<double, std::nano>(elapsed).count() / count;
+        std::cout << "  " << std::left << std::setw(44) << name
+                  << std::right << std::setw(8) << std::fixed << std::setprecision(2) << ns << " ns/msg"
+                  << std::setw(12) << std::setprecision(2) << (1000.0 / ns) << " M msgs/sec/core" << std::endl;
+    }
+
+    // Extraction the client used before parse_feed_message
+    std::string legacy_field(const std::string &message, const std::string &key)
+    {
+        size_t start = message.find(key);
+        if (start == std::string::npos)
+        {
+            return std::string();
+        }
+        start += key.size();
+        size_t end = message.find('"', start);
+        return end == std::string::npos ? std::string() : message.substr(start, end - start);
+    }
+
+    uint64_t legacy_parse(const std::string &message)
+    {
+        uint64_t sum = 0;
+        if (message.find("\"type\":\"match\"") != std::string::npos)
+        {
+            std::string product = legacy_field(message, "\"product_id\":\"");
+            std::string price = legacy_field(message, "\"price\":\"");
+            std::string size = legacy_field(message, "\"size\":\"");
+            std::string side = legacy_field(message, "\"side\":\"");
+            sum += product.size() + side.size();
+            sum += static_cast<uint64_t>(std::stod(price) + std::stod(size));
+        }
+        else if (message.find("\"type\":\"l2update\"") != std::string::npos ||
+                 message.find("\"type\":\"snapshot\"") != std::string::npos)
+        {
+            sum += legacy_field(message, "\"product_id\":\"").size();
+            size_t pos = message.find(":[[");
+            while (pos != std::string::npos)
+            {
+                size_t open = message.find('[', pos + 2);
+                size_t close = message.find(']', open);
+                if (open == std::string::npos || close == std::string::npos)
+                {
+                    break;
+                }
+                std::string row = message.substr(open, close - open);
+                size_t quote = row.rfind("\",\"");
+                if (quote != std::string::npos)
+                {
+                    sum += static_cast<uint64_t>(std::stod(row.substr(quote + 3)));
+                }
+                pos = message[close + 1] == ',' ? close + 1 : std::string::npos;
+            }
+        }
+        else if (message.find("\"type\":\"ticker\"") != std::string::npos)
+        {
+            sum += static_cast<uint64_t>(std::stod(legacy_field(message, "\"best_bid\":\"")));
+        }
+        return sum + message.size();
+    }
+
+    double decimal(std::string_view text)
+    {
+        double value = 0.0;
+        open_dtc_server::util::parse_decimal(text, value);
+        return value;
+    }
+
+    uint64_t simd_parse(const std::string &message)
+    {
+        FeedMessage msg;
+        if (!parse_feed_message(message, msg))
+        {
+            return 0;
+        }
+
+        uint64_t sum = static_cast<uint64_t>(msg.type) + msg.product_id.size() + msg.side.size();
+        switch (msg.type)
+        {
+        case FeedMessageType::MATCH:
+            sum += static_cast<uint64_t>(decimal(msg.price) + decimal(msg.size));
+            break;
+        case FeedMessageType::L2UPDATE:
+        case FeedMessageType::SNAPSHOT:
+            for (std::string_view levels : {msg.changes, msg.bids, msg.asks})
+            {
+                FeedArrayReader reader(levels);
+                std::string_view fields[3];
+                size_t count;
+                while ((count = reader.next(fields, 3)) >= 2)
+                {
+                    sum += static_cast<uint64_t>(decimal(fields[count - 1]));
+                }
+            }
+            break;
+        case FeedMessageType::TICKER:
+            sum += static_cast<uint64_t>(decimal(msg.best_bid));
+            break;
+        default:
+            break;
+        }
+        return sum;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::string path = argc > 1 ? argv[1] : BENCH_DATA_DIR "/coinbase_feed_sample.jsonl";
+    size_t passes = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 200000;
+
+    std::vector<std::string> messages;
+    std::ifstream file(path);
+    std::string line;
+    size_t bytes = 0;
+    while (std::getline(file, line))
+    {
+        if (!line.empty())
+        {
+            bytes += line.size();
+            messages.push_back(line);
+        }
+    }
+    if (messages.empty())
+    {
+        std::cerr << "No messages read from " << path << std::endl;
+        return 1;
+    }
+
+    std::cout << "Coinbase feed parser benchmark (" << messages.size() << " recorded messages, "
+              << bytes / messages.size() << " bytes avg, " << passes << " passes)" << std::endl;
+    run("find() + substr() + stod()", messages, passes, legacy_parse);
+    run("parse_feed_message() + FeedArrayReader", messages, passes, simd_parse);
+
+    // Every price and size in the recording
+    std::vector<std::string> decimals;
+    for (const std::string &message : messages)
+    {
+        FeedMessage msg;
+        if (!parse_feed_message(message, msg))
+        {
+            continue;
+        }
+        for (std::string_view field : {msg.price, msg.size})
+        {
+            if (!field.empty())
+            {
+                decimals.emplace_back(field);
+            }
+        }
+        for (std::string_view levels : {msg.changes, msg.bids, msg.asks})
+        {
+            FeedArrayReader reader(levels);
+            std::string_view fields[3];
+            size_t count;
+            while ((count = reader.next(fields, 3)) >= 2)
+            {
+                decimals.emplace_back(fields[count - 2]);
+                decimals.emplace_back(fields[count - 1]);
+            }
+        }
+    }
+
+    std::cout << "Decimal conversion (" << decimals.size() << " prices and sizes):" << std::endl;
+    run("std::stod(std::string)", decimals, passes, [](const std::string &text)
+        { return static_cast<uint64_t>(std::stod(text) * 1e8); });
+    run("util::parse_decimal()", decimals, passes, [](const std::string &text)
+        { return static_cast<uint64_t>(decimal(text) * 1e8); });
+    run("util::parse_fixed_point(scale 8)", decimals, passes, [](const std::string &text)
+        {
+            int64_t value = 0;
+            open_dtc_server::util::parse_fixed_point(text, 8, value);
+            return static_cast<uint64_t>(value); });
+
+    return 0;
+}
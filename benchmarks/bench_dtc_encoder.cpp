@@ -0,0 +1,83 @@
+#include "coinbase_dtc_core/core/dtc/protocol.hpp"
+#include "coinbase_dtc_core/core/dtc/binary_encoder.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+// Microbenchmark: heap-allocating serialize() path vs. in-place binary encoder
+// for the hot outbound market data messages.
+//
+// Usage: bench_dtc_encoder [iterations]
+
+using namespace open_dtc_server::core::dtc;
+
+namespace
+{
+    volatile uint64_t g_sink = 0;
+
+    template <typename Fn>
+    void run(const std::string &name, size_t iterations, Fn &&fn)
+    {
+        uint64_t checksum = 0;
+
+        // Warm up caches and the allocator
+        for (size_t i = 0; i < iterations / 10; i++)
+        {
+            checksum += fn(i);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; i++)
+        {
+            checksum += fn(i);
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        g_sink = g_sink + checksum;
+
+        double ns = std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(iterations);
+        std::cout << "  " << std::left << std::setw(44) << name
+                  << std::right << std::setw(8) << std::fixed << std::setprecision(2) << ns << " ns/msg" << std::endl;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 5000000;
+    Protocol protocol;
+    const uint64_t now = Protocol::get_current_timestamp();
+
+    std::cout << "DTC encoder benchmark (" << iterations << " iterations)" << std::endl;
+
+    std::cout << "MarketDataUpdateTrade:" << std::endl;
+    run("create_trade_update() + serialize()", iterations, [&](size_t i)
+        {
+            auto update = protocol.create_trade_update(static_cast<uint16_t>(i & 0xFF), 65000.0 + (i & 0x3F), 0.01, now);
+            auto bytes = update->serialize();
+            return static_cast<uint64_t>(bytes[4]) + bytes.size(); });
+
+    uint8_t buffer[MAX_ENCODED_MARKET_DATA_SIZE];
+    run("encode_trade_update() into caller buffer", iterations, [&](size_t i)
+        {
+            uint16_t size = encode_trade_update(buffer, sizeof(buffer), static_cast<uint32_t>(i & 0xFF),
+                                                65000.0 + (i & 0x3F), 0.01, static_cast<double>(now));
+            return static_cast<uint64_t>(buffer[4]) + size; });
+
+    std::cout << "MarketDataUpdateBidAsk:" << std::endl;
+    run("create_bid_ask_update() + serialize()", iterations, [&](size_t i)
+        {
+            auto update = protocol.create_bid_ask_update(static_cast<uint16_t>(i & 0xFF), 64999.0 + (i & 0x3F), 1.5f,
+                                                         65001.0 + (i & 0x3F), 2.5f, now);
+            auto bytes = update->serialize();
+            return static_cast<uint64_t>(bytes[4]) + bytes.size(); });
+
+    run("encode_bid_ask_update() into caller buffer", iterations, [&](size_t i)
+        {
+            uint16_t size = encode_bid_ask_update(buffer, sizeof(buffer), static_cast<uint32_t>(i & 0xFF),
+                                                  64999.0 + (i & 0x3F), 1.5f, 65001.0 + (i & 0x3F), 2.5f,
+                                                  static_cast<uint32_t>(now));
+            return static_cast<uint64_t>(buffer[4]) + size; });
+
+    return 0;
+}
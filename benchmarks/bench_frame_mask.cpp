@@ -0,0 +1,131 @@
+#include "coinbase_dtc_core/exchanges/coinbase/frame_decoder.hpp"
+#include "coinbase_dtc_core/exchanges/coinbase/frame_encoder.hpp"
+#include "coinbase_dtc_core/exchanges/coinbase/frame_mask.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Microbenchmark: byte-at-a-time WebSocket masking and the push_back frame
+// builder the client used before, vs. mask_websocket_payload() and
+// WebSocketFrameEncoder, for a subscribe message, a 4 KB batched subscribe
+// and a 64 KB payload.
+//
+// Usage: bench_frame_mask [iterations]
+
+using namespace open_dtc_server::feed::coinbase;
+
+namespace
+{
+    volatile uint64_t g_sink = 0;
+
+    const uint8_t MASK_KEY[4] = {0x37, 0xFA, 0x21, 0x3D};
+
+    template <typename Fn>
+    void run(const std::string &name, size_t bytes, size_t iterations, Fn &&fn)
+    {
+        uint64_t checksum = 0;
+        for (size_t i = 0; i < iterations / 10 + 1; i++)
+        {
+            checksum += fn();
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; i++)
+        {
+            checksum += fn();
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        g_sink = g_sink + checksum;
+
+        double ns = std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(iterations);
+        std::cout << "  " << std::left << std::setw(40) << name << std::right << std::fixed
+                  << std::setw(10) << std::setprecision(1) << ns << " ns/frame"
+                  << std::setw(9) << std::setprecision(2) << static_cast<double>(bytes) / ns << " GB/s" << std::endl;
+    }
+
+    // The client's encoder before WebSocketFrameEncoder
+    std::string legacy_encode(const std::string &payload)
+    {
+        std::vector<uint8_t> frame;
+        frame.push_back(0x81);
+        uint64_t len = payload.length();
+        if (len < 126)
+        {
+            frame.push_back(0x80 | static_cast<uint8_t>(len));
+        }
+        else if (len < 65536)
+        {
+            frame.push_back(0x80 | 126);
+            frame.push_back((len >> 8) & 0xFF);
+            frame.push_back(len & 0xFF);
+        }
+        else
+        {
+            frame.push_back(0x80 | 127);
+            for (int i = 7; i >= 0; i--)
+            {
+                frame.push_back((len >> (i * 8)) & 0xFF);
+            }
+        }
+        for (int i = 0; i < 4; i++)
+        {
+            frame.push_back(MASK_KEY[i]);
+        }
+        for (size_t i = 0; i < payload.length(); i++)
+        {
+            frame.push_back(payload[i] ^ MASK_KEY[i % 4]);
+        }
+        return std::string(frame.begin(), frame.end());
+    }
+
+    void byte_unmask(uint8_t *payload, size_t size)
+    {
+        for (size_t i = 0; i < size; i++)
+        {
+            payload[i] ^= MASK_KEY[i & 3];
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000;
+
+    std::string subscribe = "{\"type\":\"subscribe\",\"product_ids\":[\"BTC-USD\"],\"channels\":[\"matches\"]}";
+    std::string batch = "{\"type\":\"subscribe\",\"product_ids\":[";
+    while (batch.size() < 4000)
+    {
+        batch += "\"BTC-USD\",\"ETH-USD\",\"SOL-USD\",";
+    }
+    batch += "\"XRP-USD\"],\"channels\":[\"level2_batch\",\"matches\"]}";
+    std::string large(64 * 1024, 'x');
+
+    std::cout << "WebSocket frame masking benchmark (" << iterations << " iterations)" << std::endl;
+
+    WebSocketFrameEncoder encoder;
+    for (const std::string *payload : {&subscribe, &batch, &large})
+    {
+        std::string label = std::to_string(payload->size()) + " B ";
+        size_t count = payload == &large ? iterations / 20 + 1 : iterations;
+
+        run(label + "push_back encoder", payload->size(), count, [&]()
+            { return static_cast<uint64_t>(legacy_encode(*payload).size()); });
+        run(label + "WebSocketFrameEncoder", payload->size(), count, [&]()
+            { return static_cast<uint64_t>(encoder.encode(*payload, WebSocketFrameDecoder::OPCODE_TEXT, MASK_KEY).size()); });
+
+        std::vector<uint8_t> buffer(payload->begin(), payload->end());
+        run(label + "byte-wise unmask", payload->size(), count, [&]()
+            {
+                byte_unmask(buffer.data(), buffer.size());
+                return static_cast<uint64_t>(buffer[0]); });
+        run(label + "mask_websocket_payload (in place)", payload->size(), count, [&]()
+            {
+                mask_websocket_payload(buffer.data(), buffer.data(), buffer.size(), MASK_KEY);
+                return static_cast<uint64_t>(buffer[0]); });
+    }
+    return 0;
+}
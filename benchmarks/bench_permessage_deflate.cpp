@@ -0,0 +1,173 @@
+#include "coinbase_dtc_core/exchanges/coinbase/message_parser.hpp"
+#include "coinbase_dtc_core/exchanges/coinbase/permessage_deflate.hpp"
+#include <zlib.h>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Microbenchmark: what permessage-deflate costs and saves on a Coinbase feed.
+// The recorded messages are replayed with their low digits varied (so the
+// compressor cannot simply match whole earlier messages), compressed the way
+// a server does, and inflated with MessageInflater. Reported per message:
+// wire bytes with and without compression, inflate time, and for scale the
+// time to parse the inflated text.
+//
+// Usage: bench_permessage_deflate [feed.jsonl] [messages]
+
+using namespace open_dtc_server::feed::coinbase;
+
+#ifndef BENCH_DATA_DIR
+#define BENCH_DATA_DIR "benchmarks/data"
+#endif
+
+namespace
+{
+    volatile uint64_t g_sink = 0;
+
+    // Replace the last two digits of every number with pseudo-random ones
+    std::string vary(const std::string &message, uint32_t &seed)
+    {
+        std::string out = message;
+        for (size_t i = 0; i < out.size(); i++)
+        {
+            bool last = out[i] >= '0' && out[i] <= '9' && (i + 1 == out.size() || out[i + 1] < '0' || out[i + 1] > '9');
+            if (last && i > 0 && out[i - 1] >= '0' && out[i - 1] <= '9')
+            {
+                seed = seed * 1664525u + 1013904223u;
+                out[i] = static_cast<char>('0' + (seed >> 24) % 10);
+                out[i - 1] = static_cast<char>('0' + (seed >> 16) % 10);
+            }
+        }
+        return out;
+    }
+
+    // Server side: raw deflate, sync flush per message, 00 00 FF FF tail stripped
+    std::vector<std::string> compress(const std::vector<std::string> &messages, bool context_takeover)
+    {
+        z_stream stream{};
+        deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY);
+
+        std::vector<std::string> compressed;
+        compressed.reserve(messages.size());
+        for (const std::string &message : messages)
+        {
+            std::string out(deflateBound(&stream, static_cast<uLong>(message.size())) + 16, '\0');
+            stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(message.data()));
+            stream.avail_in = static_cast<uInt>(message.size());
+            stream.next_out = reinterpret_cast<Bytef *>(&out[0]);
+            stream.avail_out = static_cast<uInt>(out.size());
+            deflate(&stream, Z_SYNC_FLUSH);
+            out.resize(out.size() - stream.avail_out - 4);
+            compressed.push_back(out);
+            if (!context_takeover)
+            {
+                deflateReset(&stream);
+            }
+        }
+        deflateEnd(&stream);
+        return compressed;
+    }
+
+    size_t total_size(const std::vector<std::string> &messages)
+    {
+        size_t bytes = 0;
+        for (const std::string &message : messages)
+        {
+            bytes += message.size();
+        }
+        return bytes;
+    }
+
+    // Time one full pass in ns per message
+    template <typename Fn>
+    double time_pass(const std::vector<std::string> &messages, Fn &&fn)
+    {
+        uint64_t checksum = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (const std::string &message : messages)
+        {
+            checksum += fn(message);
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        g_sink = g_sink + checksum;
+        return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(messages.size());
+    }
+
+    void report(const std::string &name, size_t raw_bytes, size_t wire_bytes, size_t count, double inflate_ns)
+    {
+        double per_message = static_cast<double>(wire_bytes) / static_cast<double>(count);
+        double saved = static_cast<double>(raw_bytes - wire_bytes) / static_cast<double>(count);
+        std::cout << "  " << std::left << std::setw(28) << name << std::right << std::fixed
+                  << std::setw(8) << std::setprecision(1) << per_message << " B/msg"
+                  << std::setw(7) << std::setprecision(2) << static_cast<double>(raw_bytes) / static_cast<double>(wire_bytes) << "x"
+                  << std::setw(9) << std::setprecision(1) << inflate_ns << " ns/msg inflate"
+                  << std::setw(9) << std::setprecision(2) << (inflate_ns > 0 ? saved / inflate_ns : 0.0)
+                  << " B saved/ns" << std::endl;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::string path = argc > 1 ? argv[1] : BENCH_DATA_DIR "/coinbase_feed_sample.jsonl";
+    size_t count = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 200000;
+
+    std::vector<std::string> recorded;
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (!line.empty())
+        {
+            recorded.push_back(line);
+        }
+    }
+    if (recorded.empty() || count == 0)
+    {
+        std::cerr << "No messages read from " << path << std::endl;
+        return 1;
+    }
+
+    uint32_t seed = 12345;
+    std::vector<std::string> messages;
+    messages.reserve(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        messages.push_back(vary(recorded[i % recorded.size()], seed));
+    }
+    size_t raw_bytes = total_size(messages);
+
+    std::cout << "permessage-deflate benchmark (" << count << " messages, "
+              << raw_bytes / count << " bytes avg uncompressed)" << std::endl;
+
+    double parse_ns = time_pass(messages, [](const std::string &message)
+                                {
+                                    FeedMessage msg;
+                                    return parse_feed_message(message, msg) ? static_cast<uint64_t>(msg.type) : 0; });
+    report("uncompressed", raw_bytes, raw_bytes, count, 0.0);
+
+    for (bool takeover : {true, false})
+    {
+        std::vector<std::string> compressed = compress(messages, takeover);
+
+        DeflateParameters params;
+        params.server_no_context_takeover = !takeover;
+        MessageInflater inflater;
+        inflater.start(params);
+        double inflate_ns = time_pass(compressed, [&](const std::string &payload)
+                                      {
+                                          std::string_view text;
+                                          return inflater.inflate(payload, text) ? static_cast<uint64_t>(text.size()) : 0; });
+
+        report(takeover ? "deflate, context takeover" : "deflate, no context takeover",
+               raw_bytes, total_size(compressed), count, inflate_ns);
+    }
+
+    std::cout << "  (parse_feed_message on the inflated text: " << std::fixed << std::setprecision(1)
+              << parse_ns << " ns/msg)" << std::endl;
+    return 0;
+}
@@ -0,0 +1,123 @@
+#include "coinbase_dtc_core/core/util/spsc_ring.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+
+// Microbenchmark: handing feed messages from a reader thread to a parser
+// thread through a mutex + condition variable + std::queue<std::string> (the
+// layout CoinbaseFeed declared) vs. util::SpscByteRing, for a typical
+// 300-byte l2update.
+//
+// Usage: bench_spsc_ring [messages]
+
+using open_dtc_server::util::SpscByteRing;
+
+namespace
+{
+    volatile uint64_t g_sink = 0;
+
+    void report(const std::string &name, size_t messages, std::chrono::steady_clock::duration elapsed)
+    {
+        double ns = std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(messages);
+        std::cout << "  " << std::left << std::setw(32) << name << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(8) << ns << " ns/msg" << std::setw(8) << std::setprecision(2) << 1000.0 / ns
+                  << " M msg/s" << std::endl;
+    }
+
+    void bench_locked_queue(const std::string &message, size_t messages)
+    {
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::queue<std::string> queue;
+
+        auto start = std::chrono::steady_clock::now();
+        std::thread consumer([&]()
+                             {
+                                 uint64_t checksum = 0;
+                                 for (size_t received = 0; received < messages; received++)
+                                 {
+                                     std::unique_lock<std::mutex> lock(mutex);
+                                     cv.wait(lock, [&]()
+                                             { return !queue.empty(); });
+                                     std::string item = std::move(queue.front());
+                                     queue.pop();
+                                     lock.unlock();
+                                     checksum += static_cast<uint8_t>(item[received % item.size()]);
+                                 }
+                                 g_sink = g_sink + checksum; });
+
+        for (size_t i = 0; i < messages; i++)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                queue.push(message);
+            }
+            cv.notify_one();
+        }
+        consumer.join();
+        report("mutex + std::queue<std::string>", messages, std::chrono::steady_clock::now() - start);
+    }
+
+    void bench_ring(const std::string &message, size_t messages)
+    {
+        SpscByteRing ring(32 * 1024 * 1024);
+
+        auto start = std::chrono::steady_clock::now();
+        std::thread consumer([&]()
+                             {
+                                 uint64_t checksum = 0;
+                                 const uint8_t *data;
+                                 size_t size;
+                                 for (size_t received = 0; received < messages;)
+                                 {
+                                     if (!ring.try_peek(data, size))
+                                     {
+                                         std::this_thread::yield();
+                                         continue;
+                                     }
+                                     checksum += data[received % size];
+                                     ring.release();
+                                     received++;
+                                 }
+                                 g_sink = g_sink + checksum; });
+
+        for (size_t i = 0; i < messages; i++)
+        {
+            uint8_t *slot;
+            while (!(slot = ring.try_reserve(message.size())))
+            {
+                std::this_thread::yield();
+            }
+            std::memcpy(slot, message.data(), message.size());
+            ring.commit(message.size());
+        }
+        consumer.join();
+        report("SpscByteRing", messages, std::chrono::steady_clock::now() - start);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    size_t messages = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+
+    std::string message = "{\"type\":\"l2update\",\"product_id\":\"BTC-USD\",\"changes\":[[\"buy\",\"50000.00\",\"1.5\"]],"
+                          "\"time\":\"2024-01-01T00:00:00.123456Z\"}";
+    while (message.size() < 300)
+    {
+        message += ' ';
+    }
+
+    std::cout << "Reader -> parser handoff benchmark (" << messages << " x " << message.size() << " B, "
+              << std::thread::hardware_concurrency() << " hardware threads)" << std::endl;
+    bench_locked_queue(message, messages);
+    bench_ring(message, messages);
+    return 0;
+}
@@ -0,0 +1,507 @@
+#pragma once
+
+#include "coinbase_dtc_core/core/dtc/protocol.hpp"
+#include "coinbase_dtc_core/core/dtc/wire_format.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace open_dtc_server
+{
+    namespace core
+    {
+        namespace dtc
+        {
+
+            /**
+             * Zero-allocation encoders for the hot outbound market data messages.
+             *
+             * Each encoder writes one complete, spec-exact DTC message into a
+             * caller-provided buffer and returns the number of bytes written, or 0
+             * if the buffer is too small. Nothing is allocated, so these can be used
+             * directly against a socket send buffer on the broadcast path.
+             */
+
+            /** Upper bound for any market data message produced by the encoders below */
+            constexpr size_t MAX_ENCODED_MARKET_DATA_SIZE = 64;
+
+            /** Market data message family negotiated with a client at logon */
+            enum class MarketDataEncoding : uint8_t
+            {
+                STANDARD = 0, // MARKET_DATA_UPDATE_TRADE / MARKET_DATA_UPDATE_BID_ASK
+                COMPACT = 1,  // *_COMPACT: float prices, 4-byte timestamps
+                INTEGER = 2   // *_INT: scaled int32 prices and quantities
+            };
+
+            constexpr size_t MARKET_DATA_ENCODING_COUNT = 3;
+
+            /**
+             * Per-symbol scaling for the *_INT messages: the wire value is
+             * round(value * multiplier), and the client divides by the multiplier
+             * it received in the symbol's security definition.
+             */
+            struct IntegerPriceScale
+            {
+                uint32_t price_multiplier = 1;
+                uint32_t volume_multiplier = 1;
+
+                bool operator==(const IntegerPriceScale &other) const
+                {
+                    return price_multiplier == other.price_multiplier && volume_multiplier == other.volume_multiplier;
+                }
+            };
+
+            /**
+             * Scale a value to the int32 wire representation.
+             * @param scaled Set to round(value * multiplier)
+             * @return false if the result does not fit an int32, or a nonzero value
+             *         rounds to 0; clamping would send the client a wrong value
+             */
+            inline bool to_integer_price(double value, uint32_t multiplier, int32_t &scaled)
+            {
+                double rounded = std::nearbyint(value * multiplier);
+                if (!(rounded < 2147483648.0 && rounded >= -2147483648.0) || (rounded == 0.0 && value != 0.0))
+                {
+                    return false;
+                }
+                scaled = static_cast<int32_t>(rounded);
+                return true;
+            }
+
+            /** Upper bound for any message produced by the encoders below */
+            constexpr size_t MAX_ENCODED_MESSAGE_SIZE = 512;
+
+            /** Copy into a fixed-length, null-terminated DTC string field (truncating) */
+            inline void write_fixed_string(char *field, size_t field_length, std::string_view value)
+            {
+                size_t length = std::min(value.size(), field_length - 1);
+                std::memcpy(field, value.data(), length);
+                std::memset(field + length, 0, field_length - length);
+            }
+
+            template <typename Wire>
+            inline uint16_t write_message(uint8_t *buffer, size_t capacity, Wire &msg, MessageType type)
+            {
+                if (!buffer || capacity < sizeof(Wire))
+                {
+                    return 0;
+                }
+                msg.size = sizeof(Wire);
+                msg.type = static_cast<uint16_t>(type);
+                std::memcpy(buffer, &msg, sizeof(Wire));
+                return msg.size;
+            }
+
+            // ========================================================================
+            // SESSION MESSAGES
+            // ========================================================================
+
+            inline uint16_t encode_logon_request(uint8_t *buffer, size_t capacity, const LogonRequest &request)
+            {
+                wire::LogonRequest msg{};
+                msg.protocol_version = request.protocol_version;
+                write_fixed_string(msg.username, sizeof(msg.username), request.username);
+                write_fixed_string(msg.password, sizeof(msg.password), request.password);
+                write_fixed_string(msg.general_text_data, sizeof(msg.general_text_data), request.general_text_data);
+                msg.integer_1 = request.integer_1;
+                msg.integer_2 = request.integer_2;
+                msg.heartbeat_interval_in_seconds = request.heartbeat_interval_in_seconds;
+                write_fixed_string(msg.trade_account, sizeof(msg.trade_account), request.trade_account);
+                write_fixed_string(msg.hardware_identifier, sizeof(msg.hardware_identifier), request.hardware_identifier);
+                write_fixed_string(msg.client_name, sizeof(msg.client_name), request.client_name);
+                return write_message(buffer, capacity, msg, MessageType::LOGON_REQUEST);
+            }
+
+            inline uint16_t encode_logon_response(uint8_t *buffer, size_t capacity, const LogonResponse &response)
+            {
+                wire::LogonResponse msg{};
+                msg.protocol_version = response.protocol_version;
+                msg.result = static_cast<int32_t>(response.result ? wire::LogonStatus::LOGON_SUCCESS
+                                                                  : wire::LogonStatus::LOGON_ERROR);
+                write_fixed_string(msg.result_text, sizeof(msg.result_text), response.result_text);
+                write_fixed_string(msg.reconnect_address, sizeof(msg.reconnect_address), response.reconnect_address);
+                msg.integer_1 = response.integer_1;
+                write_fixed_string(msg.server_name, sizeof(msg.server_name), response.server_name);
+                msg.market_depth_updates_best_bid_and_ask = response.market_depth_updates_best_bid_and_ask;
+                msg.trading_is_supported = response.trading_is_supported;
+                msg.order_cancel_replace_supported = response.order_cancel_replace_supported;
+                write_fixed_string(msg.symbol_exchange_delimiter, sizeof(msg.symbol_exchange_delimiter),
+                                   response.symbol_exchange_delimiter);
+                msg.security_definitions_supported = response.security_definitions_supported;
+                msg.historical_price_data_supported = response.historical_price_data_supported;
+                msg.resubscribe_when_market_data_feed_available = response.resubscribe_when_market_data_feed_available;
+                msg.market_depth_is_supported = response.market_depth_is_supported;
+                msg.one_historical_price_data_request_per_connection = response.one_historical_price_data_request_per_connection;
+                msg.bracket_orders_supported = response.bracket_order_supported;
+                msg.use_integer_price_order_messages = response.use_integer_price_order_messages;
+                msg.market_data_supported = 1;
+                return write_message(buffer, capacity, msg, MessageType::LOGON_RESPONSE);
+            }
+
+            inline uint16_t encode_heartbeat(uint8_t *buffer, size_t capacity, uint32_t num_drops, int64_t current_date_time)
+            {
+                wire::Heartbeat msg{};
+                msg.num_drops = num_drops;
+                msg.current_date_time = current_date_time;
+                return write_message(buffer, capacity, msg, MessageType::HEARTBEAT);
+            }
+
+            // ========================================================================
+            // MARKET DATA REQUESTS
+            // ========================================================================
+
+            inline uint16_t encode_market_data_request(uint8_t *buffer, size_t capacity, RequestAction action,
+                                                       uint32_t symbol_id, std::string_view symbol,
+                                                       std::string_view exchange)
+            {
+                wire::MarketDataRequest msg{};
+                msg.request_action = static_cast<int32_t>(action);
+                msg.symbol_id = symbol_id;
+                write_fixed_string(msg.symbol, sizeof(msg.symbol), symbol);
+                write_fixed_string(msg.exchange, sizeof(msg.exchange), exchange);
+                return write_message(buffer, capacity, msg, MessageType::MARKET_DATA_REQUEST);
+            }
+
+            inline uint16_t encode_market_data_reject(uint8_t *buffer, size_t capacity, uint32_t symbol_id,
+                                                      std::string_view reject_text)
+            {
+                wire::MarketDataReject msg{};
+                msg.symbol_id = symbol_id;
+                write_fixed_string(msg.reject_text, sizeof(msg.reject_text), reject_text);
+                return write_message(buffer, capacity, msg, MessageType::MARKET_DATA_REJECT);
+            }
+
+            inline uint16_t encode_market_depth_request(uint8_t *buffer, size_t capacity, RequestAction action,
+                                                        uint32_t symbol_id, std::string_view symbol,
+                                                        std::string_view exchange, int32_t num_levels)
+            {
+                wire::MarketDepthRequest msg{};
+                msg.request_action = static_cast<int32_t>(action);
+                msg.symbol_id = symbol_id;
+                write_fixed_string(msg.symbol, sizeof(msg.symbol), symbol);
+                write_fixed_string(msg.exchange, sizeof(msg.exchange), exchange);
+                msg.num_levels = num_levels;
+                return write_message(buffer, capacity, msg, MessageType::MARKET_DEPTH_REQUEST);
+            }
+
+            inline uint16_t encode_market_depth_reject(uint8_t *buffer, size_t capacity, uint32_t symbol_id,
+                                                       std::string_view reject_text)
+            {
+                wire::MarketDepthReject msg{};
+                msg.symbol_id = symbol_id;
+                write_fixed_string(msg.reject_text, sizeof(msg.reject_text), reject_text);
+                return write_message(buffer, capacity, msg, MessageType::MARKET_DEPTH_REJECT);
+            }
+
+            // ========================================================================
+            // MARKET DATA UPDATES
+            // ========================================================================
+
+            inline uint16_t encode_trade_update(uint8_t *buffer, size_t capacity,
+                                                uint32_t symbol_id, double price, double volume,
+                                                double date_time,
+                                                wire::AtBidOrAsk at_bid_or_ask = wire::AtBidOrAsk::BID_ASK_UNSET)
+            {
+                if (!buffer || capacity < sizeof(wire::MarketDataUpdateTrade))
+                {
+                    return 0;
+                }
+
+                wire::MarketDataUpdateTrade msg{};
+                msg.size = sizeof(wire::MarketDataUpdateTrade);
+                msg.type = static_cast<uint16_t>(MessageType::MARKET_DATA_UPDATE_TRADE);
+                msg.symbol_id = symbol_id;
+                msg.at_bid_or_ask = static_cast<uint16_t>(at_bid_or_ask);
+                msg.price = price;
+                msg.volume = volume;
+                msg.date_time = date_time;
+
+                std::memcpy(buffer, &msg, sizeof(msg));
+                return msg.size;
+            }
+
+            inline uint16_t encode_trade_update(uint8_t *buffer, size_t capacity, const MarketDataUpdateTrade &update)
+            {
+                return encode_trade_update(buffer, capacity, update.symbol_id, update.price, update.volume,
+                                           update.date_time,
+                                           static_cast<wire::AtBidOrAsk>(static_cast<uint16_t>(update.at_bid_or_ask)));
+            }
+
+            inline uint16_t encode_bid_ask_update(uint8_t *buffer, size_t capacity,
+                                                  uint32_t symbol_id,
+                                                  double bid_price, float bid_quantity,
+                                                  double ask_price, float ask_quantity,
+                                                  uint32_t date_time)
+            {
+                if (!buffer || capacity < sizeof(wire::MarketDataUpdateBidAsk))
+                {
+                    return 0;
+                }
+
+                wire::MarketDataUpdateBidAsk msg{};
+                msg.size = sizeof(wire::MarketDataUpdateBidAsk);
+                msg.type = static_cast<uint16_t>(MessageType::MARKET_DATA_UPDATE_BID_ASK);
+                msg.symbol_id = symbol_id;
+                msg.bid_price = bid_price;
+                msg.bid_quantity = bid_quantity;
+                msg.ask_price = ask_price;
+                msg.ask_quantity = ask_quantity;
+                msg.date_time = date_time;
+
+                std::memcpy(buffer, &msg, sizeof(msg));
+                return msg.size;
+            }
+
+            inline uint16_t encode_bid_ask_update(uint8_t *buffer, size_t capacity, const MarketDataUpdateBidAsk &update)
+            {
+                return encode_bid_ask_update(buffer, capacity, update.symbol_id,
+                                             update.bid_price, update.bid_quantity,
+                                             update.ask_price, update.ask_quantity,
+                                             static_cast<uint32_t>(update.date_time));
+            }
+
+            // ========================================================================
+            // COMPACT MARKET DATA UPDATES
+            // ========================================================================
+
+            inline uint16_t encode_trade_update_compact(uint8_t *buffer, size_t capacity,
+                                                        uint32_t symbol_id, float price, float volume,
+                                                        uint32_t date_time,
+                                                        wire::AtBidOrAsk at_bid_or_ask = wire::AtBidOrAsk::BID_ASK_UNSET)
+            {
+                wire::MarketDataUpdateTradeCompact msg{};
+                msg.price = price;
+                msg.volume = volume;
+                msg.date_time = date_time;
+                msg.symbol_id = symbol_id;
+                msg.at_bid_or_ask = static_cast<uint16_t>(at_bid_or_ask);
+                return write_message(buffer, capacity, msg, MessageType::MARKET_DATA_UPDATE_TRADE_COMPACT);
+            }
+
+            inline uint16_t encode_bid_ask_update_compact(uint8_t *buffer, size_t capacity,
+                                                          uint32_t symbol_id,
+                                                          float bid_price, float bid_quantity,
+                                                          float ask_price, float ask_quantity,
+                                                          uint32_t date_time)
+            {
+                wire::MarketDataUpdateBidAskCompact msg{};
+                msg.bid_price = bid_price;
+                msg.bid_quantity = bid_quantity;
+                msg.ask_price = ask_price;
+                msg.ask_quantity = ask_quantity;
+                msg.date_time = date_time;
+                msg.symbol_id = symbol_id;
+                return write_message(buffer, capacity, msg, MessageType::MARKET_DATA_UPDATE_BID_ASK_COMPACT);
+            }
+
+            // ========================================================================
+            // INTEGER PRICE MARKET DATA UPDATES
+            // ========================================================================
+
+            inline uint16_t encode_trade_update_int(uint8_t *buffer, size_t capacity,
+                                                    uint32_t symbol_id, int32_t price, int32_t volume,
+                                                    uint32_t date_time,
+                                                    wire::AtBidOrAsk at_bid_or_ask = wire::AtBidOrAsk::BID_ASK_UNSET)
+            {
+                wire::MarketDataUpdateTradeInt msg{};
+                msg.symbol_id = symbol_id;
+                msg.at_bid_or_ask = static_cast<uint16_t>(at_bid_or_ask);
+                msg.price = price;
+                msg.volume = volume;
+                msg.date_time = date_time;
+                return write_message(buffer, capacity, msg, MessageType::MARKET_DATA_UPDATE_TRADE_INT);
+            }
+
+            inline uint16_t encode_bid_ask_update_int(uint8_t *buffer, size_t capacity,
+                                                      uint32_t symbol_id,
+                                                      int32_t bid_price, int32_t bid_quantity,
+                                                      int32_t ask_price, int32_t ask_quantity,
+                                                      uint32_t date_time)
+            {
+                wire::MarketDataUpdateBidAskInt msg{};
+                msg.symbol_id = symbol_id;
+                msg.bid_price = bid_price;
+                msg.bid_quantity = bid_quantity;
+                msg.ask_price = ask_price;
+                msg.ask_quantity = ask_quantity;
+                msg.date_time = date_time;
+                return write_message(buffer, capacity, msg, MessageType::MARKET_DATA_UPDATE_BID_ASK_INT);
+            }
+
+            inline uint16_t encode_depth_update_int(uint8_t *buffer, size_t capacity,
+                                                    uint32_t symbol_id, wire::AtBidOrAsk side,
+                                                    int32_t price, int32_t quantity,
+                                                    wire::MarketDepthUpdateType update_type,
+                                                    double date_time, uint32_t num_orders = 0)
+            {
+                wire::MarketDepthUpdateLevelInt msg{};
+                msg.symbol_id = symbol_id;
+                msg.side = static_cast<uint16_t>(side);
+                msg.price = price;
+                msg.quantity = quantity;
+                msg.update_type = static_cast<uint8_t>(update_type);
+                msg.date_time = date_time;
+                msg.num_orders = num_orders;
+                return write_message(buffer, capacity, msg, MessageType::MARKET_DEPTH_UPDATE_LEVEL_INT);
+            }
+
+            // ========================================================================
+            // MARKET DEPTH
+            // ========================================================================
+
+            /**
+             * Encode one level of a depth snapshot. A snapshot is a batch of these,
+             * best level first per side; an empty book is sent as a single message
+             * with no side and both batch flags set.
+             */
+            inline uint16_t encode_depth_snapshot_level(uint8_t *buffer, size_t capacity,
+                                                        uint32_t symbol_id, wire::AtBidOrAsk side,
+                                                        double price, double quantity, uint16_t level,
+                                                        bool is_first_message_in_batch, bool is_last_message_in_batch,
+                                                        double date_time, uint32_t num_orders = 0)
+            {
+                wire::MarketDepthSnapshotLevel msg{};
+                msg.symbol_id = symbol_id;
+                msg.side = static_cast<uint16_t>(side);
+                msg.price = price;
+                msg.quantity = quantity;
+                msg.level = level;
+                msg.is_first_message_in_batch = is_first_message_in_batch ? 1 : 0;
+                msg.is_last_message_in_batch = is_last_message_in_batch ? 1 : 0;
+                msg.date_time = date_time;
+                msg.num_orders = num_orders;
+                return write_message(buffer, capacity, msg, MessageType::MARKET_DEPTH_SNAPSHOT_LEVEL);
+            }
+
+            inline uint16_t encode_depth_update(uint8_t *buffer, size_t capacity,
+                                                uint32_t symbol_id, wire::AtBidOrAsk side,
+                                                double price, double quantity,
+                                                wire::MarketDepthUpdateType update_type,
+                                                double date_time, uint32_t num_orders = 0)
+            {
+                wire::MarketDepthUpdateLevel msg{};
+                msg.symbol_id = symbol_id;
+                msg.side = static_cast<uint16_t>(side);
+                msg.price = price;
+                msg.quantity = quantity;
+                msg.update_type = static_cast<uint8_t>(update_type);
+                msg.date_time = date_time;
+                msg.num_orders = num_orders;
+                return write_message(buffer, capacity, msg, MessageType::MARKET_DEPTH_UPDATE_LEVEL);
+            }
+
+            /**
+             * Offset of the SymbolID field in a market data update, used to patch a
+             * per-client symbol ID into a message encoded once for many clients.
+             * @return Field offset, or 0 if the message type has no SymbolID
+             */
+            inline size_t symbol_id_offset(MessageType type)
+            {
+                switch (type)
+                {
+                case MessageType::MARKET_DATA_UPDATE_TRADE:
+                    return offsetof(wire::MarketDataUpdateTrade, symbol_id);
+                case MessageType::MARKET_DATA_UPDATE_BID_ASK:
+                    return offsetof(wire::MarketDataUpdateBidAsk, symbol_id);
+                case MessageType::MARKET_DATA_UPDATE_TRADE_COMPACT:
+                    return offsetof(wire::MarketDataUpdateTradeCompact, symbol_id);
+                case MessageType::MARKET_DATA_UPDATE_BID_ASK_COMPACT:
+                    return offsetof(wire::MarketDataUpdateBidAskCompact, symbol_id);
+                case MessageType::MARKET_DATA_UPDATE_TRADE_INT:
+                    return offsetof(wire::MarketDataUpdateTradeInt, symbol_id);
+                case MessageType::MARKET_DATA_UPDATE_BID_ASK_INT:
+                    return offsetof(wire::MarketDataUpdateBidAskInt, symbol_id);
+                case MessageType::MARKET_DEPTH_SNAPSHOT_LEVEL:
+                    return offsetof(wire::MarketDepthSnapshotLevel, symbol_id);
+                case MessageType::MARKET_DEPTH_UPDATE_LEVEL:
+                    return offsetof(wire::MarketDepthUpdateLevel, symbol_id);
+                case MessageType::MARKET_DEPTH_UPDATE_LEVEL_INT:
+                    return offsetof(wire::MarketDepthUpdateLevelInt, symbol_id);
+                default:
+                    return 0;
+                }
+            }
+
+            /**
+             * Encode a trade in the client's negotiated encoding. The full encoding
+             * keeps the sub-second part; compact and integer ones carry whole seconds.
+             * @param timestamp_us Trade time in microseconds since epoch
+             * @return Bytes written, or 0 if an integer encoding cannot represent the
+             *         price or volume at the given scale
+             */
+            inline uint16_t encode_trade_update(MarketDataEncoding encoding, uint8_t *buffer, size_t capacity,
+                                                uint32_t symbol_id, double price, double volume,
+                                                uint64_t timestamp_us, wire::AtBidOrAsk at_bid_or_ask,
+                                                const IntegerPriceScale &scale = IntegerPriceScale())
+            {
+                if (encoding == MarketDataEncoding::INTEGER)
+                {
+                    int32_t integer_price;
+                    int32_t integer_volume;
+                    if (!to_integer_price(price, scale.price_multiplier, integer_price) ||
+                        !to_integer_price(volume, scale.volume_multiplier, integer_volume))
+                    {
+                        return 0;
+                    }
+                    return encode_trade_update_int(buffer, capacity, symbol_id, integer_price, integer_volume,
+                                                   static_cast<uint32_t>(timestamp_us / 1000000), at_bid_or_ask);
+                }
+                if (encoding == MarketDataEncoding::COMPACT)
+                {
+                    return encode_trade_update_compact(buffer, capacity, symbol_id,
+                                                       static_cast<float>(price), static_cast<float>(volume),
+                                                       static_cast<uint32_t>(timestamp_us / 1000000), at_bid_or_ask);
+                }
+                return encode_trade_update(buffer, capacity, symbol_id, price, volume,
+                                           static_cast<double>(timestamp_us) / 1000000.0, at_bid_or_ask);
+            }
+
+            /**
+             * Encode a best bid/ask in the client's negotiated encoding.
+             * @param timestamp_us Quote time in microseconds since epoch
+             * @return Bytes written, or 0 if an integer encoding cannot represent a
+             *         price or quantity at the given scale
+             */
+            inline uint16_t encode_bid_ask_update(MarketDataEncoding encoding, uint8_t *buffer, size_t capacity,
+                                                  uint32_t symbol_id,
+                                                  double bid_price, double bid_quantity,
+                                                  double ask_price, double ask_quantity,
+                                                  uint64_t timestamp_us,
+                                                  const IntegerPriceScale &scale = IntegerPriceScale())
+            {
+                uint32_t date_time = static_cast<uint32_t>(timestamp_us / 1000000);
+                if (encoding == MarketDataEncoding::INTEGER)
+                {
+                    int32_t integer_bid_price;
+                    int32_t integer_bid_quantity;
+                    int32_t integer_ask_price;
+                    int32_t integer_ask_quantity;
+                    if (!to_integer_price(bid_price, scale.price_multiplier, integer_bid_price) ||
+                        !to_integer_price(bid_quantity, scale.volume_multiplier, integer_bid_quantity) ||
+                        !to_integer_price(ask_price, scale.price_multiplier, integer_ask_price) ||
+                        !to_integer_price(ask_quantity, scale.volume_multiplier, integer_ask_quantity))
+                    {
+                        return 0;
+                    }
+                    return encode_bid_ask_update_int(buffer, capacity, symbol_id, integer_bid_price,
+                                                     integer_bid_quantity, integer_ask_price, integer_ask_quantity,
+                                                     date_time);
+                }
+                if (encoding == MarketDataEncoding::COMPACT)
+                {
+                    return encode_bid_ask_update_compact(buffer, capacity, symbol_id,
+                                                         static_cast<float>(bid_price), static_cast<float>(bid_quantity),
+                                                         static_cast<float>(ask_price), static_cast<float>(ask_quantity),
+                                                         date_time);
+                }
+                return encode_bid_ask_update(buffer, capacity, symbol_id,
+                                             bid_price, static_cast<float>(bid_quantity),
+                                             ask_price, static_cast<float>(ask_quantity), date_time);
+            }
+
+        } // namespace dtc
+    } // namespace core
+} // namespace open_dtc_server
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "coinbase_dtc_core/core/dtc/protocol.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+namespace open_dtc_server
+{
+    namespace core
+    {
+        namespace dtc
+        {
+
+            /**
+             * Splits a DTC byte stream into complete messages without copying them.
+             *
+             * Bytes are read straight into the reassembler's buffer (write_position()
+             * / commit()), and next_frame() hands out pointers to complete messages in
+             * place. Partial messages stay buffered until the rest arrives. When the
+             * tail of the buffer runs short the unconsumed bytes are moved to the front;
+             * since the capacity is at least the largest possible DTC message, a
+             * message always fits once the buffer is compacted.
+             *
+             * Frames returned by next_frame() are valid until the next call to
+             * write_position().
+             */
+            class FrameReassembler
+            {
+            public:
+                // Largest encodable DTC message (16-bit size field), rounded up
+                static constexpr size_t DEFAULT_CAPACITY = 64 * 1024;
+
+                // Compact before reading if less than this much contiguous space is left
+                static constexpr size_t MIN_READ_SIZE = 4 * 1024;
+
+                enum class Status
+                {
+                    FRAME,      // data/size point at a complete message
+                    INCOMPLETE, // need more bytes
+                    INVALID     // header declares a size smaller than the header
+                };
+
+                explicit FrameReassembler(size_t capacity = DEFAULT_CAPACITY)
+                    : buffer_(new uint8_t[capacity < DEFAULT_CAPACITY ? DEFAULT_CAPACITY : capacity]),
+                      capacity_(capacity < DEFAULT_CAPACITY ? DEFAULT_CAPACITY : capacity)
+                {
+                }
+
+                /** Start of the contiguous free space to read into */
+                uint8_t *write_position()
+                {
+                    if (read_ == write_)
+                    {
+                        read_ = write_ = 0;
+                    }
+                    else if (capacity_ - write_ < MIN_READ_SIZE && read_ > 0)
+                    {
+                        std::memmove(buffer_.get(), buffer_.get() + read_, write_ - read_);
+                        write_ -= read_;
+                        read_ = 0;
+                    }
+                    return buffer_.get() + write_;
+                }
+
+                /** Bytes available at write_position() */
+                size_t writable() const { return capacity_ - write_; }
+
+                /** Mark bytes written at write_position() as received */
+                void commit(size_t bytes) { write_ += bytes; }
+
+                /**
+                 * Take the next complete message from the buffer.
+                 * @param data Set to the start of the message on FRAME
+                 * @param size Set to the message size on FRAME
+                 */
+                Status next_frame(const uint8_t *&data, uint16_t &size)
+                {
+                    size_t available = write_ - read_;
+                    if (available < sizeof(MessageHeader))
+                    {
+                        return Status::INCOMPLETE;
+                    }
+
+                    uint16_t message_size;
+                    std::memcpy(&message_size, buffer_.get() + read_, sizeof(message_size));
+                    if (message_size < sizeof(MessageHeader))
+                    {
+                        return Status::INVALID;
+                    }
+                    if (available < message_size)
+                    {
+                        return Status::INCOMPLETE;
+                    }
+
+                    data = buffer_.get() + read_;
+                    size = message_size;
+                    read_ += message_size;
+                    return Status::FRAME;
+                }
+
+                /** Bytes received but not yet returned as frames */
+                size_t buffered() const { return write_ - read_; }
+                size_t capacity() const { return capacity_; }
+
+            private:
+                std::unique_ptr<uint8_t[]> buffer_;
+                size_t capacity_;
+                size_t read_ = 0;
+                size_t write_ = 0;
+            };
+
+        } // namespace dtc
+    } // namespace core
+} // namespace open_dtc_server
@@ -0,0 +1,153 @@
+#pragma once
+
+#include "coinbase_dtc_core/core/dtc/protocol.hpp"
+#include "coinbase_dtc_core/core/dtc/wire_format.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace open_dtc_server
+{
+    namespace core
+    {
+        namespace dtc
+        {
+
+            /**
+             * Zero-copy read-only views over inbound DTC messages.
+             *
+             * A view wraps the bytes of one complete message in the receive buffer and
+             * decodes fields on access. String fields come back as std::string_view into
+             * the buffer, so parsing a request never allocates. Views are only valid
+             * while the underlying buffer is.
+             *
+             * DTC allows a sender to transmit a shorter message than the current
+             * structure (older protocol revisions); fields that lie beyond the
+             * transmitted size read as their default value.
+             */
+            template <typename Wire, MessageType Type>
+            class MessageView
+            {
+            public:
+                MessageView(const uint8_t *data, size_t size)
+                    : data_(data), size_(size)
+                {
+                    if (data_ && size_ >= sizeof(MessageHeader))
+                    {
+                        uint16_t declared_size;
+                        std::memcpy(&declared_size, data_, sizeof(declared_size));
+                        if (declared_size < size_)
+                        {
+                            size_ = declared_size;
+                        }
+                    }
+                }
+
+                /** True if the buffer holds a message of the expected type */
+                bool is_valid() const
+                {
+                    if (!data_ || size_ < sizeof(MessageHeader))
+                    {
+                        return false;
+                    }
+                    uint16_t type;
+                    std::memcpy(&type, data_ + offsetof(Wire, type), sizeof(type));
+                    return type == static_cast<uint16_t>(Type);
+                }
+
+                uint16_t size() const { return static_cast<uint16_t>(size_); }
+                const uint8_t *data() const { return data_; }
+
+            protected:
+                template <typename T>
+                T read(size_t offset, T default_value = T()) const
+                {
+                    if (offset + sizeof(T) > size_)
+                    {
+                        return default_value;
+                    }
+                    T value;
+                    std::memcpy(&value, data_ + offset, sizeof(T));
+                    return value;
+                }
+
+                std::string_view read_string(size_t offset, size_t length) const
+                {
+                    if (offset >= size_)
+                    {
+                        return {};
+                    }
+                    size_t available = std::min(length, size_ - offset);
+                    const char *begin = reinterpret_cast<const char *>(data_ + offset);
+                    const void *terminator = std::memchr(begin, '\0', available);
+                    size_t string_length = terminator ? static_cast<const char *>(terminator) - begin : available;
+                    return std::string_view(begin, string_length);
+                }
+
+            private:
+                const uint8_t *data_;
+                size_t size_;
+            };
+
+            class LogonRequestView : public MessageView<wire::LogonRequest, MessageType::LOGON_REQUEST>
+            {
+            public:
+                using MessageView::MessageView;
+
+                int32_t protocol_version() const { return read<int32_t>(offsetof(wire::LogonRequest, protocol_version)); }
+                std::string_view username() const { return read_string(offsetof(wire::LogonRequest, username), wire::USERNAME_PASSWORD_LENGTH); }
+                std::string_view password() const { return read_string(offsetof(wire::LogonRequest, password), wire::USERNAME_PASSWORD_LENGTH); }
+                std::string_view general_text_data() const { return read_string(offsetof(wire::LogonRequest, general_text_data), wire::GENERAL_IDENTIFIER_LENGTH); }
+                int32_t integer_1() const { return read<int32_t>(offsetof(wire::LogonRequest, integer_1)); }
+                int32_t integer_2() const { return read<int32_t>(offsetof(wire::LogonRequest, integer_2)); }
+                int32_t heartbeat_interval_in_seconds() const { return read<int32_t>(offsetof(wire::LogonRequest, heartbeat_interval_in_seconds)); }
+                std::string_view trade_account() const { return read_string(offsetof(wire::LogonRequest, trade_account), wire::TRADE_ACCOUNT_LENGTH); }
+                std::string_view hardware_identifier() const { return read_string(offsetof(wire::LogonRequest, hardware_identifier), wire::GENERAL_IDENTIFIER_LENGTH); }
+                std::string_view client_name() const { return read_string(offsetof(wire::LogonRequest, client_name), wire::CLIENT_NAME_LENGTH); }
+            };
+
+            class HeartbeatView : public MessageView<wire::Heartbeat, MessageType::HEARTBEAT>
+            {
+            public:
+                using MessageView::MessageView;
+
+                uint32_t num_drops() const { return read<uint32_t>(offsetof(wire::Heartbeat, num_drops)); }
+                int64_t current_date_time() const { return read<int64_t>(offsetof(wire::Heartbeat, current_date_time)); }
+            };
+
+            class MarketDataRequestView : public MessageView<wire::MarketDataRequest, MessageType::MARKET_DATA_REQUEST>
+            {
+            public:
+                using MessageView::MessageView;
+
+                RequestAction request_action() const
+                {
+                    return static_cast<RequestAction>(read<int32_t>(offsetof(wire::MarketDataRequest, request_action),
+                                                                    static_cast<int32_t>(RequestAction::SUBSCRIBE)));
+                }
+                uint32_t symbol_id() const { return read<uint32_t>(offsetof(wire::MarketDataRequest, symbol_id)); }
+                std::string_view symbol() const { return read_string(offsetof(wire::MarketDataRequest, symbol), wire::SYMBOL_LENGTH); }
+                std::string_view exchange() const { return read_string(offsetof(wire::MarketDataRequest, exchange), wire::EXCHANGE_LENGTH); }
+            };
+
+            class MarketDepthRequestView : public MessageView<wire::MarketDepthRequest, MessageType::MARKET_DEPTH_REQUEST>
+            {
+            public:
+                using MessageView::MessageView;
+
+                RequestAction request_action() const
+                {
+                    return static_cast<RequestAction>(read<int32_t>(offsetof(wire::MarketDepthRequest, request_action),
+                                                                    static_cast<int32_t>(RequestAction::SUBSCRIBE)));
+                }
+                uint32_t symbol_id() const { return read<uint32_t>(offsetof(wire::MarketDepthRequest, symbol_id)); }
+                std::string_view symbol() const { return read_string(offsetof(wire::MarketDepthRequest, symbol), wire::SYMBOL_LENGTH); }
+                std::string_view exchange() const { return read_string(offsetof(wire::MarketDepthRequest, exchange), wire::EXCHANGE_LENGTH); }
+                int32_t num_levels() const { return read<int32_t>(offsetof(wire::MarketDepthRequest, num_levels)); }
+            };
+
+        } // namespace dtc
+    } // namespace core
+} // namespace open_dtc_server
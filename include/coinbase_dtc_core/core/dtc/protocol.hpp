@@ -40,6 +40,13 @@ namespace open_dtc_server
                 MARKET_DATA_UPDATE_SESSION_LOW = 115,
                 MARKET_DATA_UPDATE_SESSION_VOLUME = 113,
                 MARKET_DATA_UPDATE_OPEN_INTEREST = 124,
+                MARKET_DEPTH_REQUEST = 102,
+                MARKET_DEPTH_REJECT = 121,
+                MARKET_DEPTH_SNAPSHOT_LEVEL = 122,
+                MARKET_DEPTH_UPDATE_LEVEL = 106,
+                MARKET_DEPTH_UPDATE_LEVEL_INT = 125,
+                MARKET_DATA_UPDATE_TRADE_INT = 126,
+                MARKET_DATA_UPDATE_BID_ASK_INT = 128,
 
                 // Trading Messages
                 SUBMIT_NEW_SINGLE_ORDER = 208,
@@ -164,8 +171,8 @@ namespace open_dtc_server
                 std::string username;
                 std::string password;
                 std::string general_text_data;
-                std::string integer_1;
-                std::string integer_2;
+                int32_t integer_1 = 0;
+                int32_t integer_2 = 0;
                 uint8_t heartbeat_interval_in_seconds = 0;
                 uint8_t unused_1 = 0;
                 std::string trade_account;
@@ -269,7 +276,7 @@ namespace open_dtc_server
                 double at_bid_or_ask = 0;
                 double price = 0.0;
                 double volume = 0.0;
-                uint64_t date_time = 0;
+                double date_time = 0.0; // seconds since epoch, with sub-second part
 
                 MessageType get_type() const override { return MessageType::MARKET_DATA_UPDATE_TRADE; }
                 uint16_t get_size() const override;
@@ -420,6 +427,7 @@ namespace open_dtc_server
                 float currency_value_per_increment = 0.0f;
                 uint8_t has_market_depth_data = 1;
                 float display_price_multiplier = 1.0f;
+                uint32_t integer_price_multiplier = 1; // *_INT prices are price * multiplier
                 std::string exchange_symbol;
                 float initial_margin_requirement = 0.0f;
                 float maintenance_margin_requirement = 0.0f;
@@ -456,13 +464,15 @@ namespace open_dtc_server
                 void set_connected(bool connected) { is_connected_ = connected; }
 
                 // Message processing
+                // NOTE: parse_message() allocates a message object per call. Hot inbound
+                // paths should use the zero-copy views in message_views.hpp instead.
                 std::unique_ptr<DTCMessage> parse_message(const uint8_t *data, uint16_t size);
                 std::vector<uint8_t> create_message(const DTCMessage &message);
 
                 // Protocol helpers - factory methods for common messages
                 std::unique_ptr<LogonResponse> create_logon_response(bool success, const std::string &message = "");
                 std::unique_ptr<MarketDataUpdateTrade> create_trade_update(
-                    uint16_t symbol_id, double price, double volume, uint64_t timestamp);
+                    uint16_t symbol_id, double price, double volume, double date_time);
                 std::unique_ptr<MarketDataUpdateBidAsk> create_bid_ask_update(
                     uint16_t symbol_id, double bid_price, float bid_qty,
                     double ask_price, float ask_qty, uint64_t timestamp);
@@ -471,7 +481,8 @@ namespace open_dtc_server
                     uint32_t request_id, const std::string &symbol, const std::string &exchange);
 
                 // Utility functions
-                static uint64_t get_current_timestamp();
+                static uint64_t get_current_timestamp(); // whole seconds
+                static double get_current_date_time();   // seconds with microsecond resolution
                 static MessageType get_message_type(const uint8_t *data, uint16_t size);
                 static bool validate_message_header(const uint8_t *data, uint16_t size);
                 static std::string message_type_to_string(MessageType type);
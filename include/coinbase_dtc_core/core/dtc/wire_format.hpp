@@ -0,0 +1,361 @@
+#pragma once
+
+#include "coinbase_dtc_core/core/dtc/protocol.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace open_dtc_server
+{
+    namespace core
+    {
+        namespace dtc
+        {
+            namespace wire
+            {
+
+                /**
+                 * Fixed-layout DTC binary message structures.
+                 *
+                 * These mirror the structures in the DTC specification (DTCProtocol.h,
+                 * which is compiled with 8-byte packing). We declare them with 1-byte
+                 * packing and spell out the alignment padding explicitly so the layout
+                 * does not depend on compiler settings. All fields are little-endian.
+                 */
+
+#if defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__)
+                static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__,
+                              "DTC binary encoding requires a little-endian host");
+#endif
+
+                // Fixed string field lengths from the DTC specification
+                constexpr size_t USERNAME_PASSWORD_LENGTH = 32;
+                constexpr size_t SYMBOL_EXCHANGE_DELIMITER_LENGTH = 4;
+                constexpr size_t SYMBOL_LENGTH = 64;
+                constexpr size_t EXCHANGE_LENGTH = 16;
+                constexpr size_t TEXT_DESCRIPTION_LENGTH = 96;
+                constexpr size_t GENERAL_IDENTIFIER_LENGTH = 64;
+                constexpr size_t TRADE_ACCOUNT_LENGTH = 32;
+                constexpr size_t CLIENT_NAME_LENGTH = 32;
+                constexpr size_t SERVER_NAME_LENGTH = 60;
+
+                // DTC LogonStatusEnum (int32_t on the wire)
+                enum class LogonStatus : int32_t
+                {
+                    LOGON_SUCCESS = 1,
+                    LOGON_ERROR = 2,
+                    LOGON_ERROR_NO_RECONNECT = 3,
+                    LOGON_RECONNECT_NEW_ADDRESS = 4
+                };
+
+                // Integer_1 bit a client sets in LogonRequest to ask for the compact
+                // market data messages; the server echoes it in LogonResponse Integer_1
+                // when it will send them
+                constexpr int32_t LOGON_FLAG_COMPACT_MARKET_DATA = 0x01;
+
+                // Integer_1 bit a client sets in LogonRequest to ask for the *_INT
+                // market data messages; granted via UseIntegerPriceOrderMessages
+                constexpr int32_t LOGON_FLAG_INTEGER_PRICES = 0x02;
+
+                // DTC AtBidOrAskEnum (uint16_t on the wire)
+                enum class AtBidOrAsk : uint16_t
+                {
+                    BID_ASK_UNSET = 0,
+                    AT_BID = 1,
+                    AT_ASK = 2
+                };
+
+                // DTC MarketDepthUpdateTypeEnum (uint8_t on the wire)
+                enum class MarketDepthUpdateType : uint8_t
+                {
+                    DEPTH_UNSET = 0,
+                    MARKET_DEPTH_INSERT_UPDATE_LEVEL = 1,
+                    MARKET_DEPTH_DELETE_LEVEL = 2
+                };
+
+#pragma pack(push, 1)
+                // s_LogonRequest (type 1)
+                struct LogonRequest
+                {
+                    uint16_t size;
+                    uint16_t type;
+                    int32_t protocol_version;
+                    char username[USERNAME_PASSWORD_LENGTH];
+                    char password[USERNAME_PASSWORD_LENGTH];
+                    char general_text_data[GENERAL_IDENTIFIER_LENGTH];
+                    int32_t integer_1;
+                    int32_t integer_2;
+                    int32_t heartbeat_interval_in_seconds;
+                    int32_t trade_mode;
+                    char trade_account[TRADE_ACCOUNT_LENGTH];
+                    char hardware_identifier[GENERAL_IDENTIFIER_LENGTH];
+                    char client_name[CLIENT_NAME_LENGTH];
+                    int32_t market_data_transmission_interval;
+                };
+
+                // s_LogonResponse (type 2)
+                struct LogonResponse
+                {
+                    uint16_t size;
+                    uint16_t type;
+                    int32_t protocol_version;
+                    int32_t result;
+                    char result_text[TEXT_DESCRIPTION_LENGTH];
+                    char reconnect_address[GENERAL_IDENTIFIER_LENGTH];
+                    int32_t integer_1;
+                    char server_name[SERVER_NAME_LENGTH];
+                    uint8_t market_depth_updates_best_bid_and_ask;
+                    uint8_t trading_is_supported;
+                    uint8_t oco_orders_supported;
+                    uint8_t order_cancel_replace_supported;
+                    char symbol_exchange_delimiter[SYMBOL_EXCHANGE_DELIMITER_LENGTH];
+                    uint8_t security_definitions_supported;
+                    uint8_t historical_price_data_supported;
+                    uint8_t resubscribe_when_market_data_feed_available;
+                    uint8_t market_depth_is_supported;
+                    uint8_t one_historical_price_data_request_per_connection;
+                    uint8_t bracket_orders_supported;
+                    uint8_t use_integer_price_order_messages;
+                    uint8_t uses_multiple_positions_per_symbol_and_trade_account;
+                    uint8_t market_data_supported;
+                    uint8_t padding_1[3];
+                };
+
+                // s_Heartbeat (type 3)
+                struct Heartbeat
+                {
+                    uint16_t size;
+                    uint16_t type;
+                    uint32_t num_drops;
+                    int64_t current_date_time; // t_DateTime: seconds since epoch
+                };
+
+                // s_MarketDataRequest (type 101)
+                struct MarketDataRequest
+                {
+                    uint16_t size;
+                    uint16_t type;
+                    int32_t request_action;
+                    uint32_t symbol_id;
+                    char symbol[SYMBOL_LENGTH];
+                    char exchange[EXCHANGE_LENGTH];
+                };
+
+                // s_MarketDataReject (type 103)
+                struct MarketDataReject
+                {
+                    uint16_t size;
+                    uint16_t type;
+                    uint32_t symbol_id;
+                    char reject_text[TEXT_DESCRIPTION_LENGTH];
+                };
+
+                // s_MarketDepthRequest (type 102)
+                struct MarketDepthRequest
+                {
+                    uint16_t size;
+                    uint16_t type;
+                    int32_t request_action;
+                    uint32_t symbol_id;
+                    char symbol[SYMBOL_LENGTH];
+                    char exchange[EXCHANGE_LENGTH];
+                    int32_t num_levels;
+                };
+
+                // s_MarketDepthReject (type 121)
+                struct MarketDepthReject
+                {
+                    uint16_t size;
+                    uint16_t type;
+                    uint32_t symbol_id;
+                    char reject_text[TEXT_DESCRIPTION_LENGTH];
+                };
+
+                // s_MarketDepthSnapshotLevel (type 122)
+                struct MarketDepthSnapshotLevel
+                {
+                    uint16_t size;
+                    uint16_t type;
+                    uint32_t symbol_id;
+                    uint16_t side; // AtBidOrAsk
+                    uint8_t padding_1[6];
+                    double price;
+                    double quantity;
+                    uint16_t level; // 0 = best
+                    uint8_t is_first_message_in_batch;
+                    uint8_t is_last_message_in_batch;
+                    uint8_t padding_2[4];
+                    double date_time; // t_DateTimeWithMilliseconds: seconds since epoch
+                    uint32_t num_orders;
+                    uint8_t padding_3[4];
+                };
+
+                // s_MarketDepthUpdateLevel (type 106)
+                struct MarketDepthUpdateLevel
+                {
+                    uint16_t size;
+                    uint16_t type;
+                    uint32_t symbol_id;
+                    uint16_t side; // AtBidOrAsk
+                    uint8_t padding_1[6];
+                    double price;
+                    double quantity;
+                    uint8_t update_type; // MarketDepthUpdateType
+                    uint8_t padding_2[7];
+                    double date_time; // t_DateTimeWithMilliseconds: seconds since epoch
+                    uint32_t num_orders;
+                    uint8_t padding_3[4];
+                };
+
+                // s_MarketDataUpdateTrade (type 107)
+                struct MarketDataUpdateTrade
+                {
+                    uint16_t size;
+                    uint16_t type;
+                    uint32_t symbol_id;
+                    uint16_t at_bid_or_ask;
+                    uint8_t padding_1[6];
+                    double price;
+                    double volume;
+                    double date_time; // t_DateTimeWithMilliseconds: seconds since epoch
+                };
+
+                // s_MarketDataUpdateBidAsk (type 108)
+                struct MarketDataUpdateBidAsk
+                {
+                    uint16_t size;
+                    uint16_t type;
+                    uint32_t symbol_id;
+                    double bid_price;
+                    float bid_quantity;
+                    uint8_t padding_1[4];
+                    double ask_price;
+                    float ask_quantity;
+                    uint32_t date_time; // t_DateTime4Byte: seconds since epoch
+                };
+
+                // s_MarketDataUpdateTradeCompact (type 112)
+                struct MarketDataUpdateTradeCompact
+                {
+                    uint16_t size;
+                    uint16_t type;
+                    float price;
+                    float volume;
+                    uint32_t date_time; // t_DateTime4Byte: seconds since epoch
+                    uint32_t symbol_id;
+                    uint16_t at_bid_or_ask;
+                    uint8_t padding_1[2];
+                };
+
+                // s_MarketDataUpdateBidAskCompact (type 117)
+                struct MarketDataUpdateBidAskCompact
+                {
+                    uint16_t size;
+                    uint16_t type;
+                    float bid_price;
+                    float bid_quantity;
+                    float ask_price;
+                    float ask_quantity;
+                    uint32_t date_time; // t_DateTime4Byte: seconds since epoch
+                    uint32_t symbol_id;
+                };
+
+                // s_MarketDepthUpdateLevel_Int (type 125)
+                struct MarketDepthUpdateLevelInt
+                {
+                    uint16_t size;
+                    uint16_t type;
+                    uint32_t symbol_id;
+                    uint16_t side; // AtBidOrAsk
+                    uint8_t padding_1[2];
+                    int32_t price;
+                    int32_t quantity;
+                    uint8_t update_type; // MarketDepthUpdateType
+                    uint8_t padding_2[3];
+                    double date_time; // t_DateTimeWithMilliseconds: seconds since epoch
+                    uint32_t num_orders;
+                    uint8_t padding_3[4];
+                };
+
+                // s_MarketDataUpdateTrade_Int (type 126)
+                struct MarketDataUpdateTradeInt
+                {
+                    uint16_t size;
+                    uint16_t type;
+                    uint32_t symbol_id;
+                    uint16_t at_bid_or_ask;
+                    uint8_t padding_1[2];
+                    int32_t price;
+                    int32_t volume;
+                    uint32_t date_time; // t_DateTime4Byte: seconds since epoch
+                };
+
+                // s_MarketDataUpdateBidAsk_Int (type 128)
+                struct MarketDataUpdateBidAskInt
+                {
+                    uint16_t size;
+                    uint16_t type;
+                    uint32_t symbol_id;
+                    int32_t bid_price;
+                    int32_t bid_quantity;
+                    int32_t ask_price;
+                    int32_t ask_quantity;
+                    uint32_t date_time; // t_DateTime4Byte: seconds since epoch
+                };
+#pragma pack(pop)
+
+                static_assert(sizeof(LogonRequest) == 284, "s_LogonRequest must be 284 bytes");
+                static_assert(offsetof(LogonRequest, integer_1) == 136, "s_LogonRequest::Integer_1 offset");
+                static_assert(offsetof(LogonRequest, client_name) == 248, "s_LogonRequest::ClientName offset");
+
+                static_assert(sizeof(LogonResponse) == 256, "s_LogonResponse must be 256 bytes");
+                static_assert(offsetof(LogonResponse, integer_1) == 172, "s_LogonResponse::Integer_1 offset");
+                static_assert(offsetof(LogonResponse, use_integer_price_order_messages) == 250,
+                              "s_LogonResponse::UseIntegerPriceOrderMessages offset");
+
+                static_assert(sizeof(Heartbeat) == 16, "s_Heartbeat must be 16 bytes");
+                static_assert(sizeof(MarketDataRequest) == 92, "s_MarketDataRequest must be 92 bytes");
+                static_assert(sizeof(MarketDataReject) == 104, "s_MarketDataReject must be 104 bytes");
+
+                static_assert(sizeof(MarketDepthRequest) == 96, "s_MarketDepthRequest must be 96 bytes");
+                static_assert(offsetof(MarketDepthRequest, num_levels) == 92, "s_MarketDepthRequest::NumLevels offset");
+                static_assert(sizeof(MarketDepthReject) == 104, "s_MarketDepthReject must be 104 bytes");
+
+                static_assert(sizeof(MarketDepthSnapshotLevel) == 56, "s_MarketDepthSnapshotLevel must be 56 bytes");
+                static_assert(offsetof(MarketDepthSnapshotLevel, level) == 32, "s_MarketDepthSnapshotLevel::Level offset");
+                static_assert(offsetof(MarketDepthSnapshotLevel, date_time) == 40,
+                              "s_MarketDepthSnapshotLevel::DateTime offset");
+
+                static_assert(sizeof(MarketDepthUpdateLevel) == 56, "s_MarketDepthUpdateLevel must be 56 bytes");
+                static_assert(offsetof(MarketDepthUpdateLevel, update_type) == 32,
+                              "s_MarketDepthUpdateLevel::UpdateType offset");
+                static_assert(offsetof(MarketDepthUpdateLevel, date_time) == 40, "s_MarketDepthUpdateLevel::DateTime offset");
+
+                static_assert(sizeof(MarketDataUpdateTrade) == 40, "s_MarketDataUpdateTrade must be 40 bytes");
+                static_assert(offsetof(MarketDataUpdateTrade, price) == 16, "s_MarketDataUpdateTrade::Price offset");
+                static_assert(offsetof(MarketDataUpdateTrade, date_time) == 32, "s_MarketDataUpdateTrade::DateTime offset");
+
+                static_assert(sizeof(MarketDataUpdateBidAsk) == 40, "s_MarketDataUpdateBidAsk must be 40 bytes");
+                static_assert(offsetof(MarketDataUpdateBidAsk, ask_price) == 24, "s_MarketDataUpdateBidAsk::AskPrice offset");
+                static_assert(offsetof(MarketDataUpdateBidAsk, date_time) == 36, "s_MarketDataUpdateBidAsk::DateTime offset");
+
+                static_assert(sizeof(MarketDataUpdateTradeCompact) == 24, "s_MarketDataUpdateTradeCompact must be 24 bytes");
+                static_assert(offsetof(MarketDataUpdateTradeCompact, symbol_id) == 16,
+                              "s_MarketDataUpdateTradeCompact::SymbolID offset");
+
+                static_assert(sizeof(MarketDataUpdateBidAskCompact) == 28, "s_MarketDataUpdateBidAskCompact must be 28 bytes");
+                static_assert(offsetof(MarketDataUpdateBidAskCompact, symbol_id) == 24,
+                              "s_MarketDataUpdateBidAskCompact::SymbolID offset");
+
+                static_assert(sizeof(MarketDepthUpdateLevelInt) == 40, "s_MarketDepthUpdateLevel_Int must be 40 bytes");
+                static_assert(offsetof(MarketDepthUpdateLevelInt, date_time) == 24,
+                              "s_MarketDepthUpdateLevel_Int::DateTime offset");
+
+                static_assert(sizeof(MarketDataUpdateTradeInt) == 24, "s_MarketDataUpdateTrade_Int must be 24 bytes");
+                static_assert(offsetof(MarketDataUpdateTradeInt, price) == 12, "s_MarketDataUpdateTrade_Int::Price offset");
+
+                static_assert(sizeof(MarketDataUpdateBidAskInt) == 28, "s_MarketDataUpdateBidAsk_Int must be 28 bytes");
+
+            } // namespace wire
+        } // namespace dtc
+    } // namespace core
+} // namespace open_dtc_server
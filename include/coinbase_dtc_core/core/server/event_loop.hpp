@@ -0,0 +1,111 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace coinbase_dtc_core
+{
+    namespace core
+    {
+        namespace server
+        {
+
+            /**
+             * Single-threaded epoll reactor.
+             *
+             * Each EventLoop owns one epoll instance and one I/O thread. File
+             * descriptors are registered with a handler that runs on the loop thread
+             * whenever epoll reports events for it. add() and remove() must be called
+             * on the loop thread (or before start()); other threads hand work to the
+             * loop with post().
+             *
+             * The loop thread is named "dtc-io-<index>" and can be pinned to a CPU.
+             * In busy-poll mode it spins on epoll_wait() with a zero timeout rather
+             * than blocking, so it never pays a scheduler wakeup for a ready socket
+             * but keeps its core at 100%.
+             *
+             * Only available on Linux; start() returns false elsewhere.
+             */
+            class EventLoop
+            {
+            public:
+                using EventHandler = std::function<void(uint32_t events)>;
+                using Task = std::function<void()>;
+
+                /**
+                 * @param index Loop number, used in the thread name
+                 * @param cpu CPU to pin the loop thread to (-1 = not pinned)
+                 * @param busy_poll Spin on epoll_wait() instead of blocking in it
+                 */
+                explicit EventLoop(size_t index, int cpu = -1, bool busy_poll = false);
+                ~EventLoop();
+
+                EventLoop(const EventLoop &) = delete;
+                EventLoop &operator=(const EventLoop &) = delete;
+
+                /**
+                 * Create the epoll instance and start the I/O thread.
+                 * @return true if the loop is running, false otherwise
+                 */
+                bool start();
+
+                /**
+                 * Stop the I/O thread and wait for it to exit.
+                 */
+                void stop();
+
+                /**
+                 * Register a file descriptor.
+                 * @param fd Non-blocking file descriptor
+                 * @param events epoll event mask (EPOLLIN, EPOLLOUT, EPOLLET, ...)
+                 * @param handler Called on the loop thread with the ready events
+                 * @return true if the descriptor was registered, false otherwise
+                 */
+                bool add(int fd, uint32_t events, EventHandler handler);
+
+                /**
+                 * Unregister a file descriptor. Safe to call from the descriptor's own handler.
+                 * @param fd File descriptor previously passed to add()
+                 */
+                void remove(int fd);
+
+                /**
+                 * Run a task on the loop thread. Callable from any thread.
+                 * @param task Work to run
+                 */
+                void post(Task task);
+
+                bool is_running() const { return running_; }
+                size_t get_index() const { return index_; }
+                size_t get_fd_count() const { return fd_count_; }
+
+            private:
+                void run();
+                void wake();
+                void run_pending_tasks();
+
+                size_t index_;
+                int cpu_;
+                bool busy_poll_;
+                int epoll_fd_ = -1;
+                int wake_fd_ = -1;
+                std::atomic<bool> running_{false};
+                std::atomic<size_t> fd_count_{0};
+                std::thread thread_;
+
+                // Owned by the loop thread
+                std::unordered_map<int, EventHandler> handlers_;
+                std::vector<EventHandler> retired_handlers_;
+
+                std::vector<Task> pending_tasks_;
+                std::mutex tasks_mutex_;
+            };
+
+        } // namespace server
+    } // namespace core
+} // namespace coinbase_dtc_core
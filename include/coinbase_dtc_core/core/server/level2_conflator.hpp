@@ -0,0 +1,57 @@
+#pragma once
+
+#include "coinbase_dtc_core/exchanges/base/exchange_feed.hpp"
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace coinbase_dtc_core
+{
+    namespace core
+    {
+        namespace server
+        {
+
+            /**
+             * Holds the latest best bid/ask per symbol between the exchange feeds and
+             * client fan-out, so a burst of top-of-book changes reaches clients as one
+             * update per symbol per flush.
+             *
+             * Feeds offer() updates as they arrive; a single flushing thread take()s
+             * everything pending. Symbols are indexed by util::SymbolTable ID.
+             */
+            class Level2Conflator
+            {
+            public:
+                /**
+                 * Replace the pending update for the symbol. The change flags of
+                 * updates conflated together are combined, so a side that moved and
+                 * moved back is still reported.
+                 * @return true if the symbol had no update pending
+                 */
+                bool offer(const open_dtc_server::exchanges::base::MarketLevel2 &level2);
+
+                /**
+                 * Move every pending update into out (cleared first), in the order
+                 * their symbols first became pending.
+                 * @return Number of updates taken
+                 */
+                size_t take(std::vector<open_dtc_server::exchanges::base::MarketLevel2> &out);
+
+                /** @return true if any symbol has an update pending */
+                bool has_pending() const;
+
+                /** Updates replaced by a newer one for the same symbol before a flush */
+                uint64_t get_conflated_count() const;
+
+            private:
+                mutable std::mutex mutex_;
+                std::vector<open_dtc_server::exchanges::base::MarketLevel2> latest_; // by symbol ID
+                std::vector<uint8_t> is_pending_;                                    // by symbol ID
+                std::vector<uint32_t> pending_symbols_;
+                uint64_t conflated_count_ = 0;
+            };
+
+        } // namespace server
+    } // namespace core
+} // namespace coinbase_dtc_core
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/uio.h>
+#else
+struct iovec
+{
+    void *iov_base;
+    size_t iov_len;
+};
+#endif
+
+namespace coinbase_dtc_core
+{
+    namespace core
+    {
+        namespace server
+        {
+
+            /**
+             * What to do with market data for a client whose outbound queue is full.
+             */
+            enum class SlowConsumerPolicy
+            {
+                CONFLATE,  // keep only the latest bid/ask per symbol until the queue drains; drop trades
+                DROP,      // drop the update and report it in Heartbeat::NumDrops
+                DISCONNECT // close the connection
+            };
+
+            /**
+             * A market data message encoded once and shared by every subscriber.
+             *
+             * Clients choose their own symbol IDs, so the 4-byte SymbolID field is the
+             * only per-client part: the queue sends the bytes around it from here and
+             * the client's ID from its own queue entry.
+             */
+            struct SharedMessage
+            {
+                static constexpr size_t MAX_SIZE = 64;
+
+                uint16_t size = 0;
+                uint16_t symbol_id_offset = 0;
+                uint8_t data[MAX_SIZE];
+            };
+
+            /**
+             * Bounded per-client outbound queue.
+             *
+             * Holds an ordered sequence of segments: bytes copied into an internal
+             * ring (session messages, heartbeats) and references to SharedMessages
+             * with the client's symbol ID. peek() describes the queued data as iovecs
+             * so one writev/sendmsg flushes many messages. Conflation slots hold the
+             * latest message per key while the queue is full and are moved into the
+             * queue, in first-conflated order, as it drains. Not thread-safe;
+             * ClientConnection serializes access.
+             */
+            class OutboundQueue
+            {
+            public:
+                // Largest message that can be conflated (bigger than any market data update)
+                static constexpr size_t MAX_CONFLATED_MESSAGE_SIZE = SharedMessage::MAX_SIZE;
+
+                /**
+                 * @param capacity Maximum queued bytes, counting shared messages at their wire size
+                 */
+                explicit OutboundQueue(size_t capacity);
+
+                /**
+                 * Append a copy of a complete message.
+                 * @return false if it does not fit in the free space
+                 */
+                bool push(const uint8_t *data, size_t size);
+
+                /**
+                 * Append a reference to a shared message, to be sent with symbol_id.
+                 * @return false if it does not fit in the free space
+                 */
+                bool push_shared(std::shared_ptr<const SharedMessage> message, uint32_t symbol_id);
+
+                /**
+                 * Store data as the latest message for key, replacing any pending one.
+                 * @return false if size exceeds MAX_CONFLATED_MESSAGE_SIZE
+                 */
+                bool conflate(uint32_t key, const uint8_t *data, size_t size);
+
+                /** True if a conflated message for key is waiting to enter the queue */
+                bool has_conflated(uint32_t key) const { return conflated_index_.count(key) != 0; }
+
+                /**
+                 * Describe the queued bytes for writev.
+                 * @param iov Output array
+                 * @param max_iov Size of iov (at least 3)
+                 * @return Number of iovecs filled (0 if empty)
+                 */
+                size_t peek(iovec *iov, size_t max_iov) const;
+
+                /** Drop bytes that were written to the socket and refill from conflation slots */
+                void consume(size_t bytes);
+
+                bool empty() const { return size_ == 0 && conflated_.empty(); }
+                size_t size() const { return size_; }
+                size_t capacity() const { return capacity_; }
+                size_t conflated_count() const { return conflated_.size(); }
+
+            private:
+                struct Segment
+                {
+                    std::shared_ptr<const SharedMessage> message; // null: size bytes in the ring
+                    uint32_t size;
+                    uint32_t symbol_id;
+                };
+
+                struct ConflatedMessage
+                {
+                    uint32_t key;
+                    uint16_t size;
+                    uint8_t data[MAX_CONFLATED_MESSAGE_SIZE];
+                };
+
+                void refill_from_conflated();
+
+                size_t capacity_;
+                size_t size_ = 0; // bytes queued across all segments
+
+                // Inline bytes
+                std::unique_ptr<uint8_t[]> ring_;
+                size_t ring_head_ = 0;
+                size_t ring_size_ = 0;
+
+                std::deque<Segment> segments_;
+                size_t front_offset_ = 0; // bytes of the front segment already sent
+
+                std::vector<ConflatedMessage> conflated_;
+                std::unordered_map<uint32_t, size_t> conflated_index_;
+            };
+
+        } // namespace server
+    } // namespace core
+} // namespace coinbase_dtc_core
@@ -1,16 +1,26 @@
 #pragma once
 
+#include "coinbase_dtc_core/core/dtc/binary_encoder.hpp"
+#include "coinbase_dtc_core/core/dtc/frame_reassembler.hpp"
 #include "coinbase_dtc_core/core/dtc/protocol.hpp"
+#include "coinbase_dtc_core/core/dtc/wire_format.hpp"
+#include "coinbase_dtc_core/core/server/event_loop.hpp"
+#include "coinbase_dtc_core/core/server/level2_conflator.hpp"
+#include "coinbase_dtc_core/core/server/outbound_queue.hpp"
+#include "coinbase_dtc_core/core/server/subscription_index.hpp"
 #include "coinbase_dtc_core/exchanges/base/exchange_feed.hpp"
 #include "coinbase_dtc_core/exchanges/factory/exchange_factory.hpp"
 #include <memory>
 #include <string>
+#include <string_view>
 #include <thread>
 #include <atomic>
 #include <unordered_map>
+#include <unordered_set>
 #include <mutex>
 #include <vector>
 #include <functional>
+#include <condition_variable>
 
 namespace coinbase_dtc_core
 {
@@ -22,6 +32,27 @@ namespace coinbase_dtc_core
             // Forward declarations
             class ClientConnection;
 
+            /**
+             * Outcome of queueing a message on a ClientConnection
+             */
+            enum class SendStatus
+            {
+                QUEUED,      // appended behind data already waiting to be flushed
+                NEEDS_FLUSH, // queue was idle: schedule flush_send_queue() on the owning loop
+                DROPPED,     // slow consumer: update dropped (counted in num_drops)
+                DISCONNECTED // connection is closed or was closed by this call
+            };
+
+            /**
+             * Which time clients receive as a trade's DateTime
+             */
+            enum class TradeTimeSource
+            {
+                EXCHANGE, // the exchange's trade time (receive time if the feed has none)
+                RECEIVE,  // when the feed read the message
+                SEND      // when the server encoded the update for its subscribers
+            };
+
             /**
              * DTC Server Configuration
              */
@@ -33,11 +64,63 @@ namespace coinbase_dtc_core
                 std::string password = "";
                 bool require_authentication = false;
                 uint16_t protocol_version = 8;
-                int max_clients = 100;
+                int max_clients = 10000;
+
+                // Number of epoll I/O threads client connections are sharded across
+                // (0 = one per hardware thread)
+                unsigned int io_threads = 0;
+
+                // CPU each I/O thread is pinned to, by loop index (missing or -1 =
+                // not pinned), and the CPU for the level 2 conflation thread
+                std::vector<int> io_thread_cpus;
+                int conflation_thread_cpu = -1;
+
+                // Spin the I/O threads on epoll_wait(0) instead of sleeping in the
+                // kernel until a client is readable. Saves the wakeup latency on
+                // every egress flush, at the cost of one fully busy core per I/O
+                // thread; pair it with io_thread_cpus on isolated cores.
+                bool busy_poll = false;
+
+                // Per-client outbound queue, and what happens to market data for a
+                // client whose queue is full
+                size_t client_send_queue_bytes = 1024 * 1024;
+                SlowConsumerPolicy slow_consumer_policy = SlowConsumerPolicy::CONFLATE;
+
+                // Collect best bid/ask updates for this long and send only the latest
+                // per symbol (0 = send every update as it arrives). A client queue
+                // draining after a backlog flushes early.
+                int level2_conflation_interval_ms = 0;
+
+                // Time sent as MarketDataUpdateTrade::DateTime
+                TradeTimeSource trade_time_source = TradeTimeSource::EXCHANGE;
+
+                // Interval between server heartbeats (0 = disabled)
+                int heartbeat_interval_seconds = 10;
+
+                // Send *_COMPACT market data to clients that request it at logon
+                bool allow_compact_market_data = true;
+
+                // Send *_INT market data to clients that request it at logon. Symbols
+                // without an explicit scale use these multipliers: prices from 0.01 to
+                // 21474836.47 and sizes from 0.000001 to 2147.483647. Updates outside
+                // that range are not sent to *_INT clients, and a warning names the
+                // symbol to give its own scale with set_integer_price_scale().
+                bool allow_integer_price_messages = true;
+                uint32_t default_integer_price_multiplier = 100;
+                uint32_t default_integer_volume_multiplier = 1000000;
+
+                // Most market depth levels per side sent to a client; also used when a
+                // MarketDepthRequest asks for 0 levels
+                uint16_t max_market_depth_levels = 100;
 
                 // Exchange configuration
                 std::vector<open_dtc_server::exchanges::base::ExchangeConfig> exchanges;
 
+                // Products clients may request; the first subscriber to one subscribes
+                // the feeds to it on demand. Requests for any other symbol are
+                // rejected, so clients cannot grow the process-wide symbol table.
+                std::vector<std::string> symbols;
+
                 // Logging
                 bool enable_logging = true;
                 std::string log_level = "INFO";
@@ -57,6 +140,9 @@ namespace coinbase_dtc_core
                 uint32_t next_symbol_id = 1;
                 std::unordered_map<std::string, uint32_t> symbol_to_id;
                 std::unordered_map<uint32_t, std::string> id_to_symbol;
+                std::unordered_map<uint32_t, std::string> depth_id_to_symbol;
+                open_dtc_server::core::dtc::MarketDataEncoding market_data_encoding =
+                    open_dtc_server::core::dtc::MarketDataEncoding::STANDARD;
             };
 
             /**
@@ -92,6 +178,12 @@ namespace coinbase_dtc_core
                  */
                 bool is_running() const { return server_running_; }
 
+                /**
+                 * Get the port the server is listening on.
+                 * @return Bound port (resolves config port 0 to the ephemeral port), 0 if not running
+                 */
+                uint16_t get_port() const { return bound_port_; }
+
                 // ========================================================================
                 // EXCHANGE MANAGEMENT
                 // ========================================================================
@@ -142,6 +234,40 @@ namespace coinbase_dtc_core
                  */
                 std::vector<std::string> get_subscribed_symbols() const;
 
+                /**
+                 * Set the integer price/volume multipliers for a symbol's *_INT messages.
+                 * Must match the multiplier published in the symbol's security definition.
+                 * A subscription keeps the scale in effect when it was made, so set it
+                 * before clients subscribe.
+                 * @param symbol Normalized symbol
+                 * @param scale Multipliers applied before rounding to int32
+                 */
+                void set_integer_price_scale(const std::string &symbol,
+                                             const open_dtc_server::core::dtc::IntegerPriceScale &scale);
+
+                /**
+                 * Get the integer price/volume multipliers for a symbol.
+                 * @param symbol_id util::SymbolTable::symbols() ID
+                 * @return Configured scale, or the server default
+                 */
+                open_dtc_server::core::dtc::IntegerPriceScale get_integer_price_scale(uint32_t symbol_id);
+
+                // ========================================================================
+                // MARKET DATA INPUT
+                // ========================================================================
+
+                // Exchange feed callbacks; may be called from any feed thread
+
+                void on_trade_data(const open_dtc_server::exchanges::base::MarketTrade &trade);
+                void on_level2_data(const open_dtc_server::exchanges::base::MarketLevel2 &level2);
+
+                /**
+                 * Apply full-depth book data to the server's book for the symbol and send
+                 * the resulting level changes to market depth subscribers, each limited to
+                 * the number of levels it requested.
+                 */
+                void on_depth_data(const open_dtc_server::exchanges::base::MarketDepthUpdate &depth);
+
                 // ========================================================================
                 // SERVER STATUS AND MONITORING
                 // ========================================================================
@@ -159,7 +285,8 @@ namespace coinbase_dtc_core
                 int get_client_count() const;
 
                 /**
-                 * Get server statistics.
+                 * Get server statistics: message counters and the CPU time used by
+                 * every registered thread (I/O loops, conflation, feed ingress).
                  * @return Statistics string
                  */
                 std::string get_statistics() const;
@@ -169,25 +296,54 @@ namespace coinbase_dtc_core
                 // SERVER INTERNALS
                 // ========================================================================
 
-                void server_thread_function();
-                void client_handler_thread(std::shared_ptr<ClientConnection> client);
                 void heartbeat_monitor_thread();
+                void conflation_thread();
+                void request_conflation_flush();
+
+                // Reactor callbacks (run on the owning I/O thread)
+                void accept_connections();
+                void on_client_event(const std::shared_ptr<ClientConnection> &client, uint32_t events);
+                void close_client(const std::shared_ptr<ClientConnection> &client);
 
                 // Client management
                 void add_client(std::shared_ptr<ClientConnection> client);
                 void remove_client(std::shared_ptr<ClientConnection> client);
                 void broadcast_to_all_clients(const std::vector<uint8_t> &message);
                 void send_to_client(std::shared_ptr<ClientConnection> client, const std::vector<uint8_t> &message);
-
-                // Message processing
-                void process_client_message(std::shared_ptr<ClientConnection> client, const std::vector<uint8_t> &data);
-                void handle_logon_request(std::shared_ptr<ClientConnection> client, const std::vector<uint8_t> &data);
-                void handle_market_data_request(std::shared_ptr<ClientConnection> client, const std::vector<uint8_t> &data);
-                void handle_heartbeat(std::shared_ptr<ClientConnection> client, const std::vector<uint8_t> &data);
+                void send_to_client(const std::shared_ptr<ClientConnection> &client, const uint8_t *data, size_t size);
+                void send_market_data(const std::shared_ptr<ClientConnection> &client,
+                                      const std::shared_ptr<const SharedMessage> &message, uint32_t symbol_id,
+                                      uint32_t conflation_key = 0);
+                void handle_send_status(const std::shared_ptr<ClientConnection> &client, SendStatus status);
+                void schedule_flush(const std::shared_ptr<ClientConnection> &client);
+
+                // Message processing (data points at one complete message in the receive buffer)
+                void process_client_message(const std::shared_ptr<ClientConnection> &client, const uint8_t *data, uint16_t size);
+                void handle_logon_request(const std::shared_ptr<ClientConnection> &client, const uint8_t *data, uint16_t size);
+                void handle_market_data_request(const std::shared_ptr<ClientConnection> &client, const uint8_t *data, uint16_t size);
+                void handle_heartbeat(const std::shared_ptr<ClientConnection> &client, const uint8_t *data, uint16_t size);
+                void send_market_data_reject(const std::shared_ptr<ClientConnection> &client, uint32_t symbol_id, const char *reason);
+                void publish_level2(const open_dtc_server::exchanges::base::MarketLevel2 &level2);
+
+                // Symbol table ID of a symbol listed in config_.symbols, or
+                // util::SymbolTable::INVALID_ID for any other
+                uint32_t find_allowed_symbol(std::string_view symbol) const;
+
+                // Warn once per symbol that an update did not fit its *_INT scale
+                void report_integer_scale_overflow(uint32_t symbol_id,
+                                                   const open_dtc_server::core::dtc::IntegerPriceScale &scale);
+
+                // Market depth
+                struct DepthBook;
+                void handle_market_depth_request(const std::shared_ptr<ClientConnection> &client, const uint8_t *data, uint16_t size);
+                void send_market_depth_reject(const std::shared_ptr<ClientConnection> &client, uint32_t symbol_id, const char *reason);
+                void send_depth_snapshot(const std::shared_ptr<ClientConnection> &client, uint32_t symbol_id,
+                                         const DepthBook &depth_book, uint16_t levels);
+                bool send_depth_update(const Subscriber &subscriber, uint32_t symbol,
+                                       const std::shared_ptr<const SharedMessage> &message);
+                DepthBook &get_depth_book(uint32_t symbol);
 
                 // Exchange callbacks
-                void on_trade_data(const open_dtc_server::exchanges::base::MarketTrade &trade);
-                void on_level2_data(const open_dtc_server::exchanges::base::MarketLevel2 &level2);
                 void on_exchange_connection(bool connected, const std::string &exchange);
                 void on_exchange_error(const std::string &error, const std::string &exchange);
 
@@ -202,13 +358,23 @@ namespace coinbase_dtc_core
                 ServerConfig config_;
                 std::atomic<bool> server_running_{false};
                 std::atomic<bool> should_shutdown_{false};
+                std::mutex shutdown_mutex_;
+                std::condition_variable shutdown_cv_;
 
                 // Threading
-                std::thread server_thread_;
                 std::thread heartbeat_thread_;
+                std::thread conflation_thread_;
+                bool conflation_flush_requested_ = false; // guarded by shutdown_mutex_
+
+                // Networking: loop 0 also owns the listening socket
+                int listen_fd_ = -1;
+                uint16_t bound_port_ = 0;
+                std::vector<std::unique_ptr<EventLoop>> io_loops_;
+                size_t next_loop_ = 0;
 
                 // Protocol handling
                 std::unique_ptr<open_dtc_server::core::dtc::Protocol> protocol_;
+                open_dtc_server::core::dtc::wire::LogonResponse logon_response_template_;
 
                 // Exchange management
                 std::unique_ptr<open_dtc_server::exchanges::base::MultiExchangeFeed> multi_feed_;
@@ -218,52 +384,146 @@ namespace coinbase_dtc_core
                 std::vector<std::shared_ptr<ClientConnection>> clients_;
                 std::mutex clients_mutex_;
                 std::atomic<int> next_client_id_{1};
+                std::atomic<int> client_count_{0};
 
-                // Symbol management
-                std::unordered_map<std::string, uint32_t> global_symbol_to_id_;
-                std::unordered_map<uint32_t, std::string> global_id_to_symbol_;
-                std::atomic<uint32_t> next_global_symbol_id_{1};
+                // Symbol management: the feed callbacks route updates through the
+                // subscription index without taking clients_mutex_ or session locks
+                SubscriptionIndex subscriptions_;
+                std::unordered_map<uint32_t, open_dtc_server::core::dtc::IntegerPriceScale> integer_price_scales_;
+                std::unordered_set<uint32_t> integer_scale_overflows_; // symbols already warned about
                 std::mutex symbols_mutex_;
 
+                // config_.symbols interned; fixed after construction, so read without a lock
+                std::unordered_set<uint32_t> allowed_symbols_;
+                Level2Conflator level2_conflator_;
+
+                // Market depth: one book per symbol, fed by on_depth_data. A book's mutex
+                // is held while its changes are fanned out and while a new subscriber is
+                // sent its snapshot, so every client sees its snapshot and then each
+                // later change exactly once, in order.
+                struct DepthBook
+                {
+                    std::mutex mutex;
+                    open_dtc_server::exchanges::base::OrderBook book;
+                    uint64_t timestamp = 0; // microseconds since epoch
+                };
+                std::unordered_map<uint32_t, std::unique_ptr<DepthBook>> depth_books_;
+                std::mutex depth_books_mutex_;
+                SubscriptionIndex depth_subscriptions_;
+
                 // Statistics
                 std::atomic<uint64_t> total_messages_sent_{0};
                 std::atomic<uint64_t> total_messages_received_{0};
                 std::atomic<uint64_t> total_trade_updates_sent_{0};
                 std::atomic<uint64_t> total_level2_updates_sent_{0};
+                std::atomic<uint64_t> total_depth_updates_sent_{0};
+                std::atomic<uint64_t> total_updates_dropped_{0};
                 std::chrono::steady_clock::time_point server_start_time_;
             };
 
             /**
              * Represents a client connection to the DTC server.
+             *
+             * The socket is non-blocking and owned by one EventLoop. Reads happen on
+             * that loop's thread. Sends may come from any thread: they only append to
+             * the bounded outbound queue, and the owning loop flushes it with one
+             * sendmsg per batch.
              */
             class ClientConnection
             {
             public:
-                ClientConnection(int socket_fd, int client_id);
+                static constexpr size_t DEFAULT_SEND_QUEUE_BYTES = 1024 * 1024;
+
+                ClientConnection(int socket_fd, int client_id,
+                                 size_t send_queue_bytes = DEFAULT_SEND_QUEUE_BYTES,
+                                 SlowConsumerPolicy policy = SlowConsumerPolicy::CONFLATE);
                 ~ClientConnection();
 
                 // Connection management
                 bool is_connected() const { return connected_; }
                 void disconnect();
+                int get_socket_fd() const { return socket_fd_; }
+                EventLoop *get_event_loop() const { return event_loop_; }
+                void set_event_loop(EventLoop *loop) { event_loop_ = loop; }
 
                 // Message I/O
-                bool send_message(const std::vector<uint8_t> &message);
-                std::vector<uint8_t> receive_message();
+                SendStatus send_message(const std::vector<uint8_t> &message);
+
+                // iovecs gathered per sendmsg when flushing the outbound queue
+                static constexpr size_t MAX_FLUSH_IOVECS = 64;
+
+                /**
+                 * Queue a session message (responses, rejects). These are never dropped;
+                 * a client that cannot take one is disconnected.
+                 */
+                SendStatus send_message(const uint8_t *data, size_t size);
+
+                /**
+                 * Queue a market data update, applying the slow-consumer policy if the
+                 * queue is full.
+                 * @param conflation_key Non-zero if only the latest update per key matters
+                 *                       (e.g. best bid/ask per symbol ID)
+                 */
+                SendStatus send_market_data(const uint8_t *data, size_t size, uint32_t conflation_key = 0);
+
+                /**
+                 * Queue a reference to a message encoded once for all subscribers, sent
+                 * with this client's symbol ID. Same slow-consumer handling as above.
+                 */
+                SendStatus send_market_data(const std::shared_ptr<const SharedMessage> &message, uint32_t symbol_id,
+                                            uint32_t conflation_key = 0);
+
+                /**
+                 * Write as much of the outbound queue as the socket takes (owning loop thread only).
+                 * @return false if the socket failed
+                 */
+                bool flush_send_queue();
+
+                /** True once after the queue empties following a slow-consumer backlog */
+                bool take_drained() { return drained_.exchange(false); }
+
+                /** Updates dropped since the last call (reported in Heartbeat::NumDrops) */
+                uint32_t take_num_drops() { return num_drops_.exchange(0); }
+
+                /**
+                 * Read everything currently available on the socket and pass each complete
+                 * message to handler in place (owning loop thread only). Each recv fills as
+                 * much of the receive buffer as the socket has, so one syscall can serve
+                 * many small messages.
+                 * @return false once the peer has closed the connection, the socket failed,
+                 *         or the stream contains an invalid message header
+                 */
+                bool receive_messages(const std::function<void(const uint8_t *data, uint16_t size)> &handler);
 
                 // Client information
                 int get_client_id() const { return client_id_; }
                 const ClientSession &get_session() const { return session_; }
                 ClientSession &get_session() { return session_; }
 
+                // Guards the session's subscription maps, which the I/O thread writes and
+                // the market data path reads
+                std::mutex &get_session_mutex() { return session_mutex_; }
+
                 std::string get_client_info() const;
 
             private:
                 int socket_fd_;
                 int client_id_;
                 std::atomic<bool> connected_{true};
+                EventLoop *event_loop_ = nullptr;
                 ClientSession session_;
+                std::mutex session_mutex_;
+                SlowConsumerPolicy slow_consumer_policy_;
+                std::atomic<uint32_t> num_drops_{0};
                 std::mutex send_mutex_;
-                std::mutex receive_mutex_;
+                OutboundQueue send_queue_;
+                bool flush_scheduled_ = false;
+                bool backlogged_ = false; // the slow-consumer policy applied since the queue was last empty
+                std::atomic<bool> drained_{false};
+
+                SendStatus queued_locked();
+                SendStatus apply_slow_consumer_policy_locked(const uint8_t *data, size_t size, uint32_t conflation_key);
+                open_dtc_server::core::dtc::FrameReassembler receive_buffer_;
             };
 
         } // namespace server
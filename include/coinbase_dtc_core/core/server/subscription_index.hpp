@@ -0,0 +1,122 @@
+#pragma once
+
+#include "coinbase_dtc_core/core/dtc/binary_encoder.hpp"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace coinbase_dtc_core
+{
+    namespace core
+    {
+        namespace server
+        {
+
+            class ClientConnection;
+
+            /**
+             * One client's subscription to a symbol, with everything needed to send
+             * it an update without touching its session.
+             */
+            struct Subscriber
+            {
+                std::shared_ptr<ClientConnection> client;
+                uint32_t symbol_id; // the ID the client chose in its MarketDataRequest
+                open_dtc_server::core::dtc::MarketDataEncoding encoding;
+                uint16_t depth_levels = 0; // levels per side, for market depth subscriptions
+                open_dtc_server::core::dtc::IntegerPriceScale integer_scale; // resolved at subscribe time
+            };
+
+            using SubscriberList = std::vector<Subscriber>;
+
+            /**
+             * Server-wide map from symbol to its subscribers, indexed by the
+             * util::SymbolTable ID that feeds stamp on every update.
+             *
+             * Readers take an immutable snapshot with one std::atomic_load and never
+             * wait for a writer to build a list. Writers (subscribe, unsubscribe,
+             * disconnect) are serialized, copy the affected subscriber list and
+             * publish a new snapshot; readers still holding the old one keep it
+             * alive until they are done.
+             *
+             * The load and publish are not lock-free: libstdc++ guards shared_ptr
+             * atomics with a small pool of mutexes picked by address hash, held only
+             * for the pointer copy and reference count update. A reader can wait
+             * that long behind a concurrent publish, or behind an unrelated
+             * shared_ptr atomic that hashes to the same mutex.
+             */
+            class SubscriptionIndex
+            {
+            public:
+                SubscriptionIndex();
+
+                /**
+                 * Subscribe a client, replacing its existing subscription to the symbol.
+                 * Symbols are never interned here: a symbol that is not in
+                 * SymbolTable::symbols() is not added.
+                 * @param symbol Exchange symbol, e.g. "BTC-USD"
+                 * @param client Connection to send updates to
+                 * @param symbol_id Client-chosen symbol ID
+                 * @param encoding Client's market data encoding
+                 * @param depth_levels Market depth levels per side the client asked for
+                 * @param integer_scale Multipliers for the client's *_INT messages
+                 * @return true if the symbol had no subscribers before (false if unknown)
+                 */
+                bool add(const std::string &symbol, const std::shared_ptr<ClientConnection> &client, uint32_t symbol_id,
+                         open_dtc_server::core::dtc::MarketDataEncoding encoding, uint16_t depth_levels = 0,
+                         const open_dtc_server::core::dtc::IntegerPriceScale &integer_scale =
+                             open_dtc_server::core::dtc::IntegerPriceScale());
+
+                /**
+                 * Remove a client's subscription to a symbol, if any.
+                 */
+                void remove(const std::string &symbol, const ClientConnection *client);
+
+                /**
+                 * Remove every subscription held by a client.
+                 */
+                void remove_client(const ClientConnection *client);
+
+                /**
+                 * Drop all subscriptions.
+                 */
+                void clear();
+
+                /**
+                 * Subscribers of a symbol. Takes no lock of its own, only the brief
+                 * shared_ptr atomic load described above. The list is immutable and
+                 * stays valid while the returned pointer is held.
+                 * @param symbol SymbolTable::symbols() ID
+                 * @return Subscriber list, or null if the symbol has none
+                 */
+                std::shared_ptr<const SubscriberList> subscribers(uint32_t symbol) const;
+
+                /**
+                 * @return Symbols with at least one subscriber
+                 */
+                std::vector<std::string> symbols() const;
+
+            private:
+                // Subscriber lists indexed by symbol ID; null where a symbol has none
+                using Snapshot = std::vector<std::shared_ptr<const SubscriberList>>;
+
+                std::shared_ptr<const Snapshot> load() const;
+                void publish(std::shared_ptr<const Snapshot> snapshot);
+
+                // Copy of the current snapshot with the list for symbol replaced. Only
+                // the pointers are copied; other lists are shared with the old snapshot.
+                std::shared_ptr<Snapshot> with_list(const Snapshot &current, uint32_t symbol,
+                                                    std::shared_ptr<const SubscriberList> list) const;
+
+                // Remove client from a list; null if nothing changed
+                static std::shared_ptr<SubscriberList> without(const SubscriberList &list, const ClientConnection *client);
+
+                std::shared_ptr<const Snapshot> snapshot_; // accessed only through std::atomic_load/store
+                std::mutex write_mutex_;
+            };
+
+        } // namespace server
+    } // namespace core
+} // namespace coinbase_dtc_core
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace open_dtc_server
+{
+    namespace util
+    {
+
+        /**
+         * Decimal text to number conversion for exchange prices and sizes.
+         *
+         * Both parsers read plain decimals such as "67012.46", "-0.00310000" or
+         * "5" straight from the text: no locale, no exceptions and no temporary
+         * strings. Up to 19 significant digits are accumulated eight at a time
+         * (SWAR) into an integer mantissa. The whole text must be consumed.
+         */
+
+        /**
+         * Parse a decimal into the nearest double. Mantissas up to 2^53 with at
+         * most 22 fraction digits (every Coinbase price and size) are converted
+         * with one exact division; anything else, including exponents, falls back
+         * to std::from_chars.
+         * @return false if the text is not a number (value is left unchanged)
+         */
+        bool parse_decimal(std::string_view text, double &value);
+
+        /**
+         * Parse a decimal into a fixed-point integer scaled by 10^scale, e.g.
+         * "67012.46" with scale 8 gives 6701246000000. Trailing fraction zeros
+         * beyond the scale are accepted.
+         * @param scale Number of fraction digits to keep (0-18)
+         * @return false if the text is not a plain decimal, has non-zero digits
+         *         beyond the scale, or the result does not fit in int64
+         */
+        bool parse_fixed_point(std::string_view text, int scale, int64_t &value);
+
+    } // namespace util
+} // namespace open_dtc_server
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+namespace open_dtc_server
+{
+    namespace util
+    {
+
+        /**
+         * Lock-free single-producer/single-consumer ring of variable-size byte
+         * records.
+         *
+         * Each record is stored contiguously behind an 8-byte length header, so
+         * the consumer reads it in place. A record that would run past the end of
+         * the buffer is written at the start instead, behind a wrap marker. The
+         * producer and consumer each own one position counter on its own cache
+         * line and keep a cached copy of the other's, so neither touches the
+         * other's line until it appears full or empty.
+         *
+         * Exactly one thread may call the producer methods and one other thread
+         * the consumer methods.
+         */
+        class SpscByteRing
+        {
+        public:
+            /**
+             * @param capacity Buffer size in bytes, rounded up to a power of two
+             *        (at least 4 KB). Pages are only touched as records reach them.
+             */
+            explicit SpscByteRing(size_t capacity)
+            {
+                capacity_ = 4096;
+                while (capacity_ < capacity)
+                {
+                    capacity_ <<= 1;
+                }
+                mask_ = capacity_ - 1;
+                buffer_.reset(new uint8_t[capacity_]);
+            }
+
+            SpscByteRing(const SpscByteRing &) = delete;
+            SpscByteRing &operator=(const SpscByteRing &) = delete;
+
+            size_t capacity() const { return capacity_; }
+
+            /** Largest record that always fits in an empty ring */
+            size_t max_record_size() const { return capacity_ / 2 - HEADER_SIZE; }
+
+            // ====================================================================
+            // PRODUCER
+            // ====================================================================
+
+            /**
+             * Reserve space for a record of up to size bytes.
+             * @return Where to write the record, or nullptr if the ring is too full
+             *         (or size exceeds max_record_size()). Invisible to the consumer
+             *         until commit().
+             */
+            uint8_t *try_reserve(size_t size)
+            {
+                if (size > max_record_size())
+                {
+                    return nullptr;
+                }
+
+                size_t total = record_bytes(size);
+                uint64_t head = head_.load(std::memory_order_relaxed);
+                size_t offset = static_cast<size_t>(head & mask_);
+                size_t padding = offset + total > capacity_ ? capacity_ - offset : 0;
+
+                if (head + padding + total - cached_tail_ > capacity_)
+                {
+                    cached_tail_ = tail_.load(std::memory_order_acquire);
+                    if (head + padding + total - cached_tail_ > capacity_)
+                    {
+                        return nullptr;
+                    }
+                }
+
+                if (padding > 0)
+                {
+                    // Published together with the record by commit()
+                    std::memcpy(buffer_.get() + offset, &WRAP_MARKER, sizeof(WRAP_MARKER));
+                    head += padding;
+                }
+                reserved_head_ = head;
+                return buffer_.get() + (head & mask_) + HEADER_SIZE;
+            }
+
+            /**
+             * Publish the reserved record.
+             * @param size Bytes actually written, at most the size reserved
+             */
+            void commit(size_t size)
+            {
+                uint64_t length = size;
+                std::memcpy(buffer_.get() + (reserved_head_ & mask_), &length, sizeof(length));
+                head_.store(reserved_head_ + record_bytes(size), std::memory_order_release);
+            }
+
+            // ====================================================================
+            // CONSUMER
+            // ====================================================================
+
+            /**
+             * Look at the oldest record without removing it.
+             * @return false if the ring is empty
+             */
+            bool try_peek(const uint8_t *&data, size_t &size)
+            {
+                uint64_t tail = tail_.load(std::memory_order_relaxed);
+                if (tail == cached_head_)
+                {
+                    cached_head_ = head_.load(std::memory_order_acquire);
+                    if (tail == cached_head_)
+                    {
+                        return false;
+                    }
+                }
+
+                uint64_t length;
+                std::memcpy(&length, buffer_.get() + (tail & mask_), sizeof(length));
+                if (length == WRAP_MARKER)
+                {
+                    // The record behind a wrap marker was committed with it
+                    tail += capacity_ - (tail & mask_);
+                    std::memcpy(&length, buffer_.get(), sizeof(length));
+                }
+
+                peek_tail_ = tail;
+                data = buffer_.get() + (tail & mask_) + HEADER_SIZE;
+                size = static_cast<size_t>(length);
+                return true;
+            }
+
+            /** Remove the record returned by the last try_peek() */
+            void release()
+            {
+                uint64_t length;
+                std::memcpy(&length, buffer_.get() + (peek_tail_ & mask_), sizeof(length));
+                tail_.store(peek_tail_ + record_bytes(static_cast<size_t>(length)), std::memory_order_release);
+            }
+
+            /** True if nothing is committed; reads the producer's position directly */
+            bool empty() const
+            {
+                return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_relaxed);
+            }
+
+            /** Drop every record. Only while neither side is running. */
+            void clear()
+            {
+                head_.store(0, std::memory_order_relaxed);
+                tail_.store(0, std::memory_order_relaxed);
+                cached_head_ = 0;
+                cached_tail_ = 0;
+                reserved_head_ = 0;
+                peek_tail_ = 0;
+            }
+
+        private:
+            static constexpr size_t HEADER_SIZE = 8;
+            static constexpr uint64_t WRAP_MARKER = ~uint64_t(0);
+
+            // Header plus payload, rounded up so every header stays 8-byte aligned
+            static size_t record_bytes(size_t size) { return (HEADER_SIZE + size + 7) & ~size_t(7); }
+
+            std::unique_ptr<uint8_t[]> buffer_;
+            size_t capacity_;
+            size_t mask_;
+
+            // Producer side
+            alignas(64) std::atomic<uint64_t> head_{0};
+            uint64_t cached_tail_ = 0;
+            uint64_t reserved_head_ = 0;
+
+            // Consumer side
+            alignas(64) std::atomic<uint64_t> tail_{0};
+            uint64_t cached_head_ = 0;
+            uint64_t peek_tail_ = 0;
+        };
+
+    } // namespace util
+} // namespace open_dtc_server
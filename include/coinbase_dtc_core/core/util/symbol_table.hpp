@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace open_dtc_server
+{
+    namespace util
+    {
+
+        /**
+         * Process-wide string interning table.
+         *
+         * Hands out dense 32-bit IDs (starting at 1) for symbol and exchange names
+         * so feeds, the server and the protocol layer can pass IDs instead of
+         * strings on the market data path. Names are interned once, at subscribe
+         * time, and never removed, so an ID stays valid for the life of the process
+         * and name() references never dangle. Lookups share a reader lock and do
+         * not allocate.
+         */
+        class SymbolTable
+        {
+        public:
+            static constexpr uint32_t INVALID_ID = 0;
+
+            /** Table of instrument symbols (e.g. "BTC-USD") */
+            static SymbolTable &symbols();
+
+            /** Table of exchange names (e.g. "coinbase") */
+            static SymbolTable &exchanges();
+
+            SymbolTable() = default;
+            SymbolTable(const SymbolTable &) = delete;
+            SymbolTable &operator=(const SymbolTable &) = delete;
+
+            /**
+             * Intern a name.
+             * @return The name's ID, allocating one on first use (INVALID_ID for an empty name)
+             */
+            uint32_t intern(std::string_view name);
+
+            /**
+             * @return The name's ID, or INVALID_ID if it was never interned
+             */
+            uint32_t find(std::string_view name) const;
+
+            /**
+             * @return The interned name, or an empty string for an unknown ID
+             */
+            const std::string &name(uint32_t id) const;
+
+            /** Number of interned names */
+            size_t size() const;
+
+        private:
+            mutable std::shared_mutex mutex_;
+            std::deque<std::string> names_; // names_[id - 1]; deque keeps references stable
+            std::unordered_map<std::string_view, uint32_t> ids_; // keys point into names_
+        };
+
+    } // namespace util
+} // namespace open_dtc_server
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace open_dtc_server
+{
+    namespace util
+    {
+
+        /**
+         * Pin the calling thread to one CPU (Linux and Windows).
+         * @return false if cpu is out of range, the platform has no affinity
+         *         support, or the call failed
+         */
+        bool pin_current_thread(int cpu);
+
+        /** CPU time a registered thread has used since it registered */
+        struct ThreadCpuUsage
+        {
+            std::string name;
+            int cpu = -1;             // pinned CPU, -1 if not pinned
+            uint64_t cpu_time_us = 0; // user + system time
+            uint64_t wall_time_us = 0;
+
+            /** CPU time as a share of wall time, 100 for a thread that never sleeps */
+            double cpu_percent() const
+            {
+                return wall_time_us == 0 ? 0.0 : 100.0 * static_cast<double>(cpu_time_us) / static_cast<double>(wall_time_us);
+            }
+        };
+
+        /**
+         * Process-wide list of the named threads on the market data path (feed
+         * ingress, I/O loops, ...), read for the server statistics. Threads add
+         * themselves through ScopedThreadRegistration.
+         */
+        class ThreadRegistry
+        {
+        public:
+            static ThreadRegistry &instance();
+
+            /** CPU usage of every thread registered right now, in registration order */
+            std::vector<ThreadCpuUsage> snapshot() const;
+
+            // Per-thread bookkeeping, defined in the .cpp
+            struct Entry;
+
+        private:
+            friend class ScopedThreadRegistration;
+
+            void add(Entry *entry);
+            void remove(Entry *entry);
+
+            mutable std::mutex mutex_;
+            std::vector<Entry *> entries_;
+        };
+
+        /**
+         * Registers the calling thread for as long as it lives: names it (as seen
+         * by top -H and debuggers), pins it if cpu >= 0 and adds it to the
+         * ThreadRegistry. Construct at the top of a thread function.
+         */
+        class ScopedThreadRegistration
+        {
+        public:
+            explicit ScopedThreadRegistration(const std::string &name, int cpu = -1);
+            ~ScopedThreadRegistration();
+
+            ScopedThreadRegistration(const ScopedThreadRegistration &) = delete;
+            ScopedThreadRegistration &operator=(const ScopedThreadRegistration &) = delete;
+
+            /** False if a pin was requested and failed */
+            bool pinned() const { return pinned_; }
+
+        private:
+            std::unique_ptr<ThreadRegistry::Entry> entry_;
+            bool pinned_ = true;
+        };
+
+    } // namespace util
+} // namespace open_dtc_server
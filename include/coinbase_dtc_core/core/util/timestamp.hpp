@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace open_dtc_server
+{
+    namespace util
+    {
+
+        /**
+         * Market data timestamps are carried as microseconds since the Unix epoch
+         * from the feed to the DTC encoder, so exchange, receive and send times
+         * keep their sub-second part.
+         */
+
+        /** Current wall-clock time in microseconds since the Unix epoch */
+        uint64_t now_micros();
+
+        /**
+         * Parse an ISO-8601 UTC time as sent by exchanges, e.g.
+         * "2024-05-14T13:42:07.104523Z", without strptime or locales. Accepts
+         * 0-9 fraction digits (digits past microseconds are truncated) and a "Z"
+         * or "+hh:mm"/"-hh:mm" offset.
+         * @param micros Receives microseconds since the Unix epoch
+         * @return false if the text is not a valid timestamp at or after 1970
+         */
+        bool parse_iso8601_micros(std::string_view text, uint64_t &micros);
+
+        /** Microseconds since epoch as a DTC t_DateTimeWithMilliseconds (fractional seconds) */
+        inline double to_dtc_date_time(uint64_t micros)
+        {
+            return static_cast<double>(micros) / 1000000.0;
+        }
+
+    } // namespace util
+} // namespace open_dtc_server
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "coinbase_dtc_core/exchanges/base/order_book.hpp"
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <memory>
@@ -14,31 +16,61 @@ namespace open_dtc_server
         namespace base
         {
 
-            // Exchange-agnostic market data structures
+            // Exchange-agnostic market data structures. Symbols and exchanges are
+            // carried as util::SymbolTable IDs, interned when the feed subscribes.
+            // Timestamps are microseconds since the Unix epoch (util::now_micros()).
             struct MarketTrade
             {
-                std::string symbol;   // Normalized symbol (e.g., "BTC/USD")
-                std::string exchange; // Exchange name (e.g., "coinbase")
+                uint32_t symbol_id;   // SymbolTable::symbols() ID of the exchange symbol (e.g., "BTC-USD")
+                uint32_t exchange_id; // SymbolTable::exchanges() ID (e.g., "coinbase")
                 double price;
                 double volume;
-                std::string side; // "buy" or "sell"
-                uint64_t timestamp;
+                std::string side;     // "buy" or "sell"
+                uint64_t timestamp;   // exchange trade time (receive_time if the exchange sent none)
+                uint64_t receive_time; // when the feed read the message
                 std::string trade_id;
 
-                MarketTrade() : price(0.0), volume(0.0), timestamp(0) {}
+                MarketTrade() : symbol_id(0), exchange_id(0), price(0.0), volume(0.0), timestamp(0), receive_time(0) {}
             };
 
             struct MarketLevel2
             {
-                std::string symbol;   // Normalized symbol
-                std::string exchange; // Exchange name
+                uint32_t symbol_id;   // SymbolTable::symbols() ID
+                uint32_t exchange_id; // SymbolTable::exchanges() ID
                 double bid_price;
                 double bid_size;
                 double ask_price;
                 double ask_size;
-                uint64_t timestamp;
+                uint64_t timestamp; // exchange time of the change, or receive time
 
-                MarketLevel2() : bid_price(0.0), bid_size(0.0), ask_price(0.0), ask_size(0.0), timestamp(0) {}
+                // Which sides differ from the previous update for the symbol. Feeds
+                // that do not track the book leave both set.
+                bool is_bid_change;
+                bool is_ask_change;
+
+                MarketLevel2() : symbol_id(0), exchange_id(0), bid_price(0.0), bid_size(0.0), ask_price(0.0), ask_size(0.0), timestamp(0),
+                                 is_bid_change(true), is_ask_change(true) {}
+            };
+
+            // One price level change; size 0 removes the level
+            struct DepthChange
+            {
+                BookSide side;
+                double price;
+                double size;
+            };
+
+            // Full-depth book data: a snapshot replaces the book, otherwise the
+            // changes are applied in order
+            struct MarketDepthUpdate
+            {
+                uint32_t symbol_id;   // SymbolTable::symbols() ID
+                uint32_t exchange_id; // SymbolTable::exchanges() ID
+                bool is_snapshot;
+                std::vector<DepthChange> changes;
+                uint64_t timestamp; // exchange time of the changes, or receive time
+
+                MarketDepthUpdate() : symbol_id(0), exchange_id(0), is_snapshot(false), timestamp(0) {}
             };
 
             // Exchange configuration
@@ -53,12 +85,23 @@ namespace open_dtc_server
                 std::string secret_key;
                 std::string passphrase; // For Coinbase Pro
 
-                ExchangeConfig() : port(443), requires_auth(false) {}
+                // Feed threads: CPUs for the socket receive thread and the thread that
+                // parses messages and builds books (-1 = not pinned), spinning instead
+                // of sleeping when idle, and the SO_BUSY_POLL budget in microseconds
+                // (Linux, 0 = off)
+                int ingress_cpu;
+                int book_cpu;
+                bool busy_poll;
+                int socket_busy_poll_us;
+
+                ExchangeConfig()
+                    : port(443), requires_auth(false), ingress_cpu(-1), book_cpu(-1), busy_poll(false), socket_busy_poll_us(0) {}
             };
 
             // Callback types for market data
             using TradeCallback = std::function<void(const MarketTrade &)>;
             using Level2Callback = std::function<void(const MarketLevel2 &)>;
+            using MarketDepthCallback = std::function<void(const MarketDepthUpdate &)>;
             using ConnectionCallback = std::function<void(bool connected, const std::string &exchange)>;
             using ErrorCallback = std::function<void(const std::string &error, const std::string &exchange)>;
 
@@ -129,6 +172,7 @@ namespace open_dtc_server
                 // Callback management
                 void set_trade_callback(TradeCallback callback) { trade_callback_ = callback; }
                 void set_level2_callback(Level2Callback callback) { level2_callback_ = callback; }
+                void set_depth_callback(MarketDepthCallback callback) { depth_callback_ = callback; }
                 void set_connection_callback(ConnectionCallback callback) { connection_callback_ = callback; }
                 void set_error_callback(ErrorCallback callback) { error_callback_ = callback; }
 
@@ -155,6 +199,13 @@ namespace open_dtc_server
                         level2_callback_(level2);
                 }
 
+                /** Notify all listeners of full-depth book data */
+                void notify_depth(const MarketDepthUpdate &depth)
+                {
+                    if (depth_callback_)
+                        depth_callback_(depth);
+                }
+
                 /** Notify connection status change */
                 void notify_connection(bool connected)
                 {
@@ -176,6 +227,7 @@ namespace open_dtc_server
                 // Callbacks
                 TradeCallback trade_callback_;
                 Level2Callback level2_callback_;
+                MarketDepthCallback depth_callback_;
                 ConnectionCallback connection_callback_;
                 ErrorCallback error_callback_;
             };
@@ -199,6 +251,7 @@ namespace open_dtc_server
                 // Callbacks - aggregates from all exchanges
                 void set_trade_callback(TradeCallback callback) { trade_callback_ = callback; }
                 void set_level2_callback(Level2Callback callback) { level2_callback_ = callback; }
+                void set_depth_callback(MarketDepthCallback callback) { depth_callback_ = callback; }
 
                 // Status
                 std::string get_status() const;
@@ -210,9 +263,11 @@ namespace open_dtc_server
 
                 TradeCallback trade_callback_;
                 Level2Callback level2_callback_;
+                MarketDepthCallback depth_callback_;
 
                 void on_trade_data(const MarketTrade &trade);
                 void on_level2_data(const MarketLevel2 &level2);
+                void on_depth_data(const MarketDepthUpdate &depth);
             };
 
         } // namespace base
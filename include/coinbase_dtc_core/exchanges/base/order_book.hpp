@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace open_dtc_server
+{
+    namespace exchanges
+    {
+        namespace base
+        {
+
+            enum class BookSide : uint8_t
+            {
+                BID = 0,
+                ASK = 1
+            };
+
+            struct PriceLevel
+            {
+                double price;
+                double size;
+            };
+
+            /**
+             * Price-level (L2) order book for one product.
+             *
+             * Each side is a flat array sorted from the worst price to the best, so
+             * the best level is the last element: top-of-book reads are O(1), depth
+             * queries walk contiguous memory backwards, and the inserts and deletes
+             * near the top that make up most L2 traffic only move the few levels
+             * above them. Prices are compared exactly; feeds parse them from the same
+             * decimal strings every time.
+             *
+             * Not thread-safe; a book is owned by the thread that feeds it.
+             */
+            class OrderBook
+            {
+            public:
+                /** Remove every level from both sides */
+                void clear();
+
+                /**
+                 * Replace the book with a snapshot. Levels may arrive in any order
+                 * between begin_snapshot() and end_snapshot().
+                 */
+                void begin_snapshot();
+                void add_snapshot_level(BookSide side, double price, double size);
+                void end_snapshot();
+
+                /**
+                 * Set the size at a price level; size 0 removes the level.
+                 * @return true if the book changed
+                 */
+                bool apply(BookSide side, double price, double size);
+
+                /** Best level on a side, or nullptr if the side is empty */
+                const PriceLevel *best(BookSide side) const
+                {
+                    const auto &levels = side_levels(side);
+                    return levels.empty() ? nullptr : &levels.back();
+                }
+                const PriceLevel *best_bid() const { return best(BookSide::BID); }
+                const PriceLevel *best_ask() const { return best(BookSide::ASK); }
+
+                /**
+                 * Copy the top levels of a side, best first.
+                 * @param out Destination for up to max_levels levels
+                 * @return Number of levels copied
+                 */
+                size_t depth(BookSide side, PriceLevel *out, size_t max_levels) const;
+
+                /**
+                 * Level at a depth index (0 = best), or nullptr past the end of the side.
+                 */
+                const PriceLevel *level(BookSide side, size_t index) const
+                {
+                    const auto &levels = side_levels(side);
+                    return index < levels.size() ? &levels[levels.size() - 1 - index] : nullptr;
+                }
+
+                /**
+                 * Depth index a price has, or would have if it were inserted: the
+                 * number of levels strictly better than it.
+                 */
+                size_t rank(BookSide side, double price) const;
+
+                size_t level_count(BookSide side) const { return side_levels(side).size(); }
+                bool empty() const { return bids_.empty() && asks_.empty(); }
+
+                /**
+                 * Compare the best bid and ask with their values at the previous call.
+                 * Most L2 changes are below the top, so publishers call this after a
+                 * batch of changes and skip the top-of-book update when nothing moved.
+                 * An empty side compares as price and size 0.
+                 * @param bid_changed Set if the best bid price or size changed
+                 * @param ask_changed Set if the best ask price or size changed
+                 * @return true if either side changed
+                 */
+                bool update_top_of_book(bool &bid_changed, bool &ask_changed);
+
+            private:
+                std::vector<PriceLevel> &side_levels(BookSide side) { return side == BookSide::BID ? bids_ : asks_; }
+                const std::vector<PriceLevel> &side_levels(BookSide side) const { return side == BookSide::BID ? bids_ : asks_; }
+
+                std::vector<PriceLevel> bids_; // ascending price, best bid last
+                std::vector<PriceLevel> asks_; // descending price, best ask last
+
+                // Top of book as of the last update_top_of_book() call
+                PriceLevel published_bid_{0.0, 0.0};
+                PriceLevel published_ask_{0.0, 0.0};
+            };
+
+        } // namespace base
+    } // namespace exchanges
+} // namespace open_dtc_server
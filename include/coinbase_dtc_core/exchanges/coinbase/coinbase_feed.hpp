@@ -126,6 +126,7 @@ namespace open_dtc_server
                 // WebSocket callbacks
                 void on_trade_received(const exchanges::base::MarketTrade &trade);
                 void on_level2_received(const exchanges::base::MarketLevel2 &level2);
+                void on_depth_received(const exchanges::base::MarketDepthUpdate &depth);
 
                 // Symbol mapping initialization
                 void initialize_symbol_mappings();
@@ -219,10 +220,6 @@ namespace open_dtc_server
                 std::queue<std::string> send_queue_;
                 std::condition_variable send_cv_;
 
-                std::mutex receive_queue_mutex_;
-                std::queue<std::string> receive_queue_;
-                std::condition_variable receive_cv_;
-
                 // Reconnection logic
                 std::atomic<bool> should_reconnect_;
                 std::atomic<uint64_t> last_successful_connection_;
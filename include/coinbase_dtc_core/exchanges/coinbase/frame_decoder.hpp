@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace open_dtc_server
+{
+    namespace feed
+    {
+        namespace coinbase
+        {
+
+            /**
+             * Splits a WebSocket byte stream (RFC 6455) into messages without
+             * allocating per frame.
+             *
+             * Bytes are read straight into the decoder's buffer (write_position() /
+             * commit()), so one recv() can bring in many frames, and next_message()
+             * hands them out in place, unmasked. Partial frames stay buffered until
+             * the rest arrives; unconsumed bytes are moved to the front when the tail
+             * runs short. The buffer grows only for a frame larger than it has seen
+             * before (e.g. a full order book snapshot) and keeps that size.
+             *
+             * Fragmented messages are joined in a second reusable buffer. Control
+             * frames (ping, pong, close) are returned as they arrive, including
+             * between fragments.
+             *
+             * With permessage-deflate negotiated (set_compression()), RSV1 on the
+             * first frame of a data message marks it compressed; compressed() tells
+             * the caller to inflate it. Any other reserved bit is a protocol error.
+             *
+             * A returned payload is valid until the next call to next_message() or
+             * write_position().
+             */
+            class WebSocketFrameDecoder
+            {
+            public:
+                static constexpr uint8_t OPCODE_CONTINUATION = 0x0;
+                static constexpr uint8_t OPCODE_TEXT = 0x1;
+                static constexpr uint8_t OPCODE_BINARY = 0x2;
+                static constexpr uint8_t OPCODE_CLOSE = 0x8;
+                static constexpr uint8_t OPCODE_PING = 0x9;
+                static constexpr uint8_t OPCODE_PONG = 0xA;
+
+                static constexpr size_t DEFAULT_CAPACITY = 256 * 1024;
+
+                // Compact before reading if less than this much contiguous space is left
+                static constexpr size_t MIN_READ_SIZE = 16 * 1024;
+
+                // Frames or joined messages larger than this are rejected
+                static constexpr size_t MAX_MESSAGE_SIZE = 64 * 1024 * 1024;
+
+                enum class Status
+                {
+                    MESSAGE,    // opcode/payload hold a complete message or control frame
+                    INCOMPLETE, // need more bytes
+                    INVALID     // protocol violation; the connection should be closed
+                };
+
+                explicit WebSocketFrameDecoder(size_t capacity = DEFAULT_CAPACITY);
+
+                /** Start of the contiguous free space to read into */
+                uint8_t *write_position();
+
+                /** Bytes available at write_position() */
+                size_t writable() const { return capacity_ - write_; }
+
+                /** Mark bytes written at write_position() as received */
+                void commit(size_t bytes) { write_ += bytes; }
+
+                /**
+                 * Take the next complete message or control frame.
+                 * @param opcode Set to OPCODE_TEXT/BINARY for data, or the control opcode
+                 * @param payload Set to the unmasked payload
+                 */
+                Status next_message(uint8_t &opcode, std::string_view &payload);
+
+                /** Accept RSV1 (permessage-deflate) on data frames of this connection */
+                void set_compression(bool negotiated) { compression_ = negotiated; }
+
+                /** True if the message last returned by next_message() is compressed */
+                bool compressed() const { return compressed_; }
+
+                /** Bytes received but not yet returned */
+                size_t buffered() const { return write_ - read_; }
+                size_t capacity() const { return capacity_; }
+
+                /** Drop buffered bytes and any partial message */
+                void reset();
+
+            private:
+                // Make room for a frame of total_size bytes starting at read_
+                bool reserve_frame(size_t total_size);
+
+                std::unique_ptr<uint8_t[]> buffer_;
+                size_t capacity_;
+                size_t read_ = 0;
+                size_t write_ = 0;
+
+                std::vector<char> fragments_; // data frames of a fragmented message
+                uint8_t fragments_opcode_ = 0;
+                bool fragments_compressed_ = false;
+                bool in_fragmented_message_ = false;
+
+                bool compression_ = false;
+                bool compressed_ = false;
+            };
+
+        } // namespace coinbase
+    } // namespace feed
+} // namespace open_dtc_server
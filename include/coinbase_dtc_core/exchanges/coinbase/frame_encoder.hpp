@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string_view>
+#include <vector>
+
+namespace open_dtc_server
+{
+    namespace feed
+    {
+        namespace coinbase
+        {
+
+            /**
+             * Builds masked client frames (RFC 6455 5.2) in one reusable buffer.
+             *
+             * The header is written in place and the payload is masked straight
+             * from the caller's bytes into the buffer with mask_websocket_payload(),
+             * so a frame costs one pass over the payload and no allocation once the
+             * buffer has grown to the largest frame sent.
+             *
+             * Not thread-safe: the client encodes under its send mutex.
+             */
+            class WebSocketFrameEncoder
+            {
+            public:
+                // FIN + opcode byte, length byte, 8-byte extended length, 4-byte mask
+                static constexpr size_t MAX_HEADER_SIZE = 14;
+
+                WebSocketFrameEncoder();
+
+                /**
+                 * Encode a final (unfragmented) frame with a fresh masking key.
+                 * @param opcode OPCODE_* value from WebSocketFrameDecoder
+                 * @return The frame; valid until the next call to encode()
+                 */
+                std::string_view encode(std::string_view payload, uint8_t opcode);
+
+                /** Same, with the caller's masking key (for tests and benchmarks) */
+                std::string_view encode(std::string_view payload, uint8_t opcode, const uint8_t mask_key[4]);
+
+            private:
+                std::vector<uint8_t> buffer_;
+                std::mt19937 rng_;
+            };
+
+        } // namespace coinbase
+    } // namespace feed
+} // namespace open_dtc_server
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace open_dtc_server
+{
+    namespace feed
+    {
+        namespace coinbase
+        {
+
+            /**
+             * XOR a WebSocket payload with its 4-byte masking key (RFC 6455 5.3),
+             * starting at key byte 0. Masking and unmasking are the same operation.
+             *
+             * Works 32 bytes at a time with AVX2 when the build targets it, 16 with
+             * SSE2 (the x86-64 baseline) otherwise, and 8 bytes per step in plain
+             * integer code on other targets.
+             *
+             * @param out Destination; may be the same buffer as in (in-place)
+             * @param in Payload to mask
+             */
+            void mask_websocket_payload(uint8_t *out, const uint8_t *in, size_t size, const uint8_t mask_key[4]);
+
+        } // namespace coinbase
+    } // namespace feed
+} // namespace open_dtc_server
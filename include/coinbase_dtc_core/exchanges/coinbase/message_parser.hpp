@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace open_dtc_server
+{
+    namespace feed
+    {
+        namespace coinbase
+        {
+
+            /** Coinbase WebSocket feed message types the client acts on */
+            enum class FeedMessageType : uint8_t
+            {
+                UNKNOWN = 0,
+                MATCH,
+                L2UPDATE,
+                SNAPSHOT,
+                TICKER,
+                HEARTBEAT,
+                SUBSCRIPTIONS,
+                ERROR_MESSAGE
+            };
+
+            /**
+             * Fields of one feed message as views into the message text. Fields the
+             * message does not have are empty. String values are the raw text between
+             * the quotes (escapes are not decoded; Coinbase market data has none),
+             * numbers are their literal text, and arrays span their brackets.
+             */
+            struct FeedMessage
+            {
+                FeedMessageType type = FeedMessageType::UNKNOWN;
+                std::string_view type_name;
+                std::string_view product_id;
+                std::string_view time;
+                std::string_view sequence;
+                std::string_view trade_id;
+                std::string_view last_trade_id;
+                std::string_view side;
+                std::string_view price;
+                std::string_view size;
+                std::string_view best_bid;
+                std::string_view best_bid_size;
+                std::string_view best_ask;
+                std::string_view best_ask_size;
+                std::string_view changes; // l2update: [["buy","50000.00","1.0"],...]
+                std::string_view bids;    // snapshot: [["50000.00","1.5"],...]
+                std::string_view asks;
+                std::string_view message; // error text
+            };
+
+            /**
+             * Parse the top-level object of a feed message in one pass, without
+             * allocating. Strings and nested arrays are skipped with 16-byte SIMD
+             * scans where SSE2 is available; only the fields the client reads are
+             * recorded.
+             * @param json Complete message text; must outlive the views in out
+             * @param out Receives the fields (reset first)
+             * @return false if the text is not a well-formed JSON object
+             */
+            bool parse_feed_message(std::string_view json, FeedMessage &out);
+
+            /**
+             * Reads the rows of an array of arrays, e.g. the "changes" of an l2update
+             * or the "bids" of a snapshot, as views into the message.
+             */
+            class FeedArrayReader
+            {
+            public:
+                /** @param array Array text including its brackets, as recorded by parse_feed_message */
+                explicit FeedArrayReader(std::string_view array);
+
+                /**
+                 * Read the next row. Rows with more than max_fields values are truncated.
+                 * @param fields Destination for the row's values (strings without quotes)
+                 * @return Number of fields read, 0 at the end of the array
+                 */
+                size_t next(std::string_view *fields, size_t max_fields);
+
+            private:
+                const char *pos_;
+                const char *end_;
+            };
+
+        } // namespace coinbase
+    } // namespace feed
+} // namespace open_dtc_server
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+// zlib stream state, declared here so users of the client don't pull in zlib.h
+struct z_stream_s;
+
+namespace open_dtc_server
+{
+    namespace feed
+    {
+        namespace coinbase
+        {
+
+            /** permessage-deflate (RFC 7692) parameters accepted by the server */
+            struct DeflateParameters
+            {
+                bool server_no_context_takeover = false; // server resets its compressor after each message
+                bool client_no_context_takeover = false;
+                int server_max_window_bits = 15;
+                int client_max_window_bits = 15;
+            };
+
+            /**
+             * Parse a Sec-WebSocket-Extensions response value such as
+             * "permessage-deflate; server_no_context_takeover; client_max_window_bits=12".
+             * @return false if permessage-deflate is missing, another extension was
+             *         accepted, or a parameter is unknown, repeated or out of range
+             */
+            bool parse_permessage_deflate(std::string_view header, DeflateParameters &params);
+
+            /**
+             * Inflates permessage-deflate messages of one connection.
+             *
+             * One zlib stream is kept for the whole connection so each message can
+             * refer back to earlier ones (context takeover), which is where most of
+             * the gain on a repetitive feed comes from. The output buffer is reused
+             * and only grows. Without zlib (HAS_ZLIB undefined) start() fails and
+             * the client does not offer the extension.
+             */
+            class MessageInflater
+            {
+            public:
+                // Inflated messages larger than this are rejected
+                static constexpr size_t MAX_MESSAGE_SIZE = 64 * 1024 * 1024;
+
+                MessageInflater();
+                ~MessageInflater();
+
+                MessageInflater(const MessageInflater &) = delete;
+                MessageInflater &operator=(const MessageInflater &) = delete;
+
+                /** True if this build can inflate (zlib was found) */
+                static bool available();
+
+                /** Start a fresh stream for a new connection */
+                bool start(const DeflateParameters &params);
+
+                /**
+                 * Inflate one message (the payload of its frames, RSV1 set on the first).
+                 * @param message Set to the inflated text; valid until the next call
+                 * @return false on corrupt data or an oversized message
+                 */
+                bool inflate(std::string_view compressed, std::string_view &message);
+
+                /** Release the stream; start() must be called before the next inflate() */
+                void end();
+
+                bool active() const { return active_; }
+
+            private:
+                std::unique_ptr<z_stream_s> stream_;
+                std::vector<char> output_;
+                bool reset_after_message_ = false;
+                bool active_ = false;
+            };
+
+        } // namespace coinbase
+    } // namespace feed
+} // namespace open_dtc_server
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+
+namespace open_dtc_server
+{
+    namespace feed
+    {
+        namespace coinbase
+        {
+
+            /**
+             * Last sequence number seen per product, to spot messages that were
+             * missed (a gap) or delivered twice (a duplicate or a replay older
+             * than the current snapshot).
+             *
+             * Not thread-safe: the client keeps one for matches on its parser thread.
+             */
+            class SequenceTracker
+            {
+            public:
+                enum class Result
+                {
+                    FIRST,     // no baseline for the product yet; this one becomes it
+                    NEXT,      // exactly one past the last
+                    DUPLICATE, // at or before the last; drop the message
+                    GAP        // skipped at least one; this one becomes the new last
+                };
+
+                /**
+                 * Classify a product's next sequence number and remember it unless it
+                 * is a duplicate.
+                 * @param symbol_id SymbolTable ID of the product
+                 */
+                Result check(uint32_t symbol_id, uint64_t sequence);
+
+                /** Start over from a snapshot taken at sequence */
+                void reset(uint32_t symbol_id, uint64_t sequence) { last_[symbol_id] = sequence; }
+
+                /** Forget the product: its next message is FIRST */
+                void forget(uint32_t symbol_id) { last_.erase(symbol_id); }
+
+                /** Drop every baseline (new connection) */
+                void clear() { last_.clear(); }
+
+                /**
+                 * Parse the "sequence" field of a feed message.
+                 * @return false if the field is missing or not a plain integer
+                 */
+                static bool parse(std::string_view field, uint64_t &sequence);
+
+            private:
+                std::unordered_map<uint32_t, uint64_t> last_;
+            };
+
+        } // namespace coinbase
+    } // namespace feed
+} // namespace open_dtc_server
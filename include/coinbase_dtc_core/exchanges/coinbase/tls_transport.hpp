@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// OpenSSL handle types, declared here so users of the client don't pull in OpenSSL headers
+struct ssl_ctx_st;
+struct ssl_st;
+struct ssl_session_st;
+
+namespace open_dtc_server
+{
+    namespace feed
+    {
+        namespace coinbase
+        {
+
+            /**
+             * OpenSSL TLS layer over a connected TCP socket.
+             *
+             * One SSL_CTX is created on first use and kept for the life of the
+             * transport, so certificate stores and settings are loaded once. The
+             * last session (or TLS 1.3 ticket) the server issued is cached per
+             * host:port and offered on the next connect(), letting reconnects skip
+             * the full handshake.
+             *
+             * Reads go through a 64 KB read-ahead buffer: one recv() can bring in
+             * several TLS records, and has_pending() reports decrypted or buffered
+             * bytes that a poll() on the socket would not see.
+             *
+             * Without OpenSSL (HAS_OPENSSL undefined) connect() always fails.
+             */
+            class TlsTransport
+            {
+            public:
+                TlsTransport() = default;
+                ~TlsTransport();
+
+                TlsTransport(const TlsTransport &) = delete;
+                TlsTransport &operator=(const TlsTransport &) = delete;
+
+                /**
+                 * Trust certificates from a PEM file instead of the system store,
+                 * e.g. a self-signed test server. Takes effect on the next connect().
+                 */
+                void set_ca_file(const std::string &path);
+
+                /**
+                 * Run the TLS handshake on a connected, still blocking socket.
+                 * Verifies the certificate chain and that it was issued for host.
+                 * @return false if the handshake or verification failed
+                 */
+                bool connect(int socket, const std::string &host, uint16_t port);
+
+                /**
+                 * Read decrypted bytes. Works on blocking and non-blocking sockets.
+                 * @return bytes read; 0 if nothing is available yet (would_block set)
+                 *         or the peer closed the connection; -1 on error
+                 */
+                ptrdiff_t read(void *data, size_t size, bool &would_block);
+
+                /**
+                 * Write bytes. With a non-blocking socket a full socket buffer
+                 * returns 0 with would_block set; retry with the same arguments.
+                 * @return bytes written, 0 if the write would block, -1 on error
+                 */
+                ptrdiff_t write(const void *data, size_t size, bool &would_block);
+
+                /** True if bytes are buffered inside the TLS layer */
+                bool has_pending() const;
+
+                /** True if the current connection resumed a cached session */
+                bool session_reused() const;
+
+                /** True while a TLS connection is open */
+                bool active() const { return ssl_ != nullptr; }
+
+                /** Send close_notify and free the connection; the context and session cache stay */
+                void close();
+
+            private:
+                bool create_context();
+                static int on_new_session(ssl_st *ssl, ssl_session_st *session);
+
+                ssl_ctx_st *ctx_ = nullptr;
+                ssl_st *ssl_ = nullptr;
+                std::string ca_file_;
+
+                ssl_session_st *session_ = nullptr; // last session issued for session_peer_
+                std::string session_peer_;          // host:port the session belongs to
+                std::string peer_;                  // host:port of the open connection
+            };
+
+        } // namespace coinbase
+    } // namespace feed
+} // namespace open_dtc_server
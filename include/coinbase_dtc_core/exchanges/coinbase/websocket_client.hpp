@@ -1,12 +1,21 @@
 #pragma once
 
 #include "../../core/util/log.hpp"
+#include "../../core/util/spsc_ring.hpp"
 #include "../base/exchange_feed.hpp"
+#include "../base/order_book.hpp"
+#include "frame_decoder.hpp"
+#include "frame_encoder.hpp"
+#include "message_parser.hpp"
+#include "permessage_deflate.hpp"
+#include "sequence_tracker.hpp"
+#include "tls_transport.hpp"
 #include <string>
 #include <vector>
 #include <atomic>
 #include <thread>
 #include <mutex>
+#include <condition_variable>
 #include <queue>
 #include <functional>
 #include <unordered_map>
@@ -40,17 +49,28 @@ namespace open_dtc_server
              * wss://ws-feed.exchange.coinbase.com
              *
              * Features:
+             * - TLS via OpenSSL, resuming the previous session on reconnect
+             * - permessage-deflate compression (RFC 7692) when zlib is available
              * - Real-time market data streaming
              * - Trade and level2 order book subscriptions
              * - Automatic reconnection on failures
              * - Thread-safe message handling
              * - Coinbase Pro WebSocket protocol implementation
+             *
+             * Two threads handle the feed. The receive thread only reads the
+             * socket, decodes frames and answers control frames; it copies each
+             * data message into a lock-free SPSC ring. The parser thread takes
+             * messages from the ring, builds the order books and runs the
+             * callbacks, so a slow parse or a slow callback never stops the socket
+             * from being drained. Callbacks run on the parser thread, one at a
+             * time; set them before connect().
              */
             class WebSocketClient
             {
             public:
                 using TradeCallback = std::function<void(const exchanges::base::MarketTrade &)>;
                 using Level2Callback = std::function<void(const exchanges::base::MarketLevel2 &)>;
+                using DepthCallback = std::function<void(const exchanges::base::MarketDepthUpdate &)>;
 
                 WebSocketClient();
                 ~WebSocketClient();
@@ -60,15 +80,64 @@ namespace open_dtc_server
                 void disconnect();
                 bool is_connected() const { return connected_.load(); }
 
-                // Subscription management
+                // TLS (wss://) is on by default; plain ws:// is for local testing.
+                // Both take effect on the next connect().
+                void set_tls_enabled(bool enabled) { use_tls_ = enabled; }
+                void set_tls_ca_file(const std::string &path) { tls_.set_ca_file(path); }
+                bool tls_session_reused() const;
+
+                // Offer permessage-deflate in the next handshake (on by default with zlib)
+                void set_compression_enabled(bool enabled) { use_compression_ = enabled && MessageInflater::available(); }
+
+                /**
+                 * Latency tuning for the receive thread, applied on the next connect().
+                 * @param cpu CPU to pin the thread to (-1 = not pinned)
+                 * @param busy_poll Spin on the socket instead of sleeping in poll();
+                 *        the thread then uses its whole core
+                 * @param socket_busy_poll_us SO_BUSY_POLL budget (Linux, 0 = off): the
+                 *        kernel polls the NIC queue instead of waiting for an interrupt.
+                 *        poll() only does so when net.core.busy_poll is also set.
+                 */
+                void set_ingress_tuning(int cpu, bool busy_poll, int socket_busy_poll_us = 0)
+                {
+                    ingress_cpu_ = cpu;
+                    busy_poll_ = busy_poll;
+                    socket_busy_poll_us_ = socket_busy_poll_us;
+                }
+
+                /**
+                 * CPU for the parser thread that builds the books (-1 = not pinned),
+                 * applied on the next connect(). With busy polling on, the parser
+                 * spins on the ring instead of sleeping when it is empty.
+                 */
+                void set_book_cpu(int cpu) { book_cpu_ = cpu; }
+
+                // Subscription management. Requests are only sent while connected.
                 bool subscribe_trades(const std::string &product_id);
                 bool subscribe_level2(const std::string &product_id);
-                bool unsubscribe(const std::string &product_id);
-                bool subscribe_multiple_symbols(const std::vector<std::string> &product_ids);
+                bool unsubscribe(const std::string &product_id); // trades and level2
+                bool subscribe_multiple_symbols(const std::vector<std::string> &product_ids); // trades
+
+                // Largest batch of products in one subscribe/unsubscribe frame; larger
+                // requests are split so no single message approaches Coinbase's limits
+                static constexpr size_t MAX_PRODUCTS_PER_MESSAGE = 100;
+                static constexpr size_t MAX_SUBSCRIPTION_MESSAGE_BYTES = 8192;
+
+                /**
+                 * Subscribe every product to every channel with as few frames as the
+                 * limits above allow (300 products on two channels: 3 frames).
+                 * @param channels Coinbase channel names ("matches", "level2", ...)
+                 * @return false if a frame could not be sent
+                 */
+                bool subscribe_channels(const std::vector<std::string> &channels, const std::vector<std::string> &product_ids);
+
+                /** Same, unsubscribing */
+                bool unsubscribe_channels(const std::vector<std::string> &channels, const std::vector<std::string> &product_ids);
 
                 // Callbacks
                 void set_trade_callback(TradeCallback callback) { trade_callback_ = callback; }
                 void set_level2_callback(Level2Callback callback) { level2_callback_ = callback; }
+                void set_depth_callback(DepthCallback callback) { depth_callback_ = callback; }
 
                 // Status
                 std::vector<std::string> get_subscribed_symbols() const;
@@ -77,32 +146,57 @@ namespace open_dtc_server
             private:
                 // WebSocket protocol implementation
                 void worker_loop();
+                void parser_loop();
                 void ping_loop();
+
+                // Set should_stop_ and join every running thread, whether or not the
+                // connection is still up
+                void stop_threads();
                 void cleanup_socket();
 
                 // Real WebSocket implementation
                 bool establish_websocket_connection();
                 bool perform_websocket_handshake();
-                bool send_websocket_frame(const std::string &payload);
-                bool receive_websocket_frame(std::string &payload);
+                bool send_websocket_frame(std::string_view payload,
+                                          uint8_t opcode = WebSocketFrameDecoder::OPCODE_TEXT);
+                bool send_all(const char *data, size_t size);
+
+                // Non-blocking receive path: wait for readiness, drain the socket into
+                // frame_decoder_, then handle every complete message
+                bool wait_readable(int timeout_ms);
+                bool read_available();
+                bool process_frames(uint64_t receive_time);
 
-                // SSL/TLS support
-                bool initialize_ssl();
-                bool perform_ssl_handshake();
-                ssize_t ssl_send(const void *data, size_t len);
-                ssize_t ssl_receive(void *data, size_t len);
-                void cleanup_ssl();
+                // Hand one data message to the parser thread (receive thread only).
+                // Returns false if the client stopped while the ring was full.
+                bool enqueue_message(std::string_view message, uint64_t receive_time);
+                void wait_for_messages();
+
+                // Socket I/O through TLS when enabled, plain TCP otherwise. Return bytes
+                // moved; 0 with would_block set when the socket is not ready, 0 when the
+                // peer closed, -1 on error.
+                ptrdiff_t transport_send(const char *data, size_t size, bool &would_block);
+                ptrdiff_t transport_receive(char *data, size_t size, bool &would_block);
+                bool transport_pending();
 
                 // Message handling
-                std::string create_subscribe_message(const std::string &channel, const std::string &product_id) const;
-                std::string create_unsubscribe_message(const std::string &product_id) const;
-                void process_received_message(const std::string &message);
-                void parse_trade_message(const std::string &message);
-                void parse_level2_message(const std::string &message);
+                // {"type":<type>,"product_ids":[product_ids[begin..end)],"channels":[...]}
+                std::string create_subscription_message(const char *type, const std::vector<std::string> &channels,
+                                                        const std::vector<std::string> &product_ids,
+                                                        size_t begin, size_t end) const;
+                bool send_subscription(const char *type, const std::vector<std::string> &channels,
+                                       const std::vector<std::string> &product_ids);
+                // receive_time: when the frame was read, microseconds since epoch
+                void process_received_message(std::string_view message, uint64_t receive_time);
+                void parse_trade_message(const FeedMessage &msg, uint64_t receive_time);
+                void parse_level2_message(const FeedMessage &msg, uint64_t receive_time);
+                void parse_snapshot_message(const FeedMessage &msg, uint64_t receive_time);
+                void publish_top_of_book(uint32_t symbol_id, exchanges::base::OrderBook &book, uint64_t timestamp);
+                void publish_depth(uint64_t timestamp);
+                void request_book_resync(uint32_t symbol_id, uint64_t now);
 
                 // WebSocket protocol helpers
                 std::string create_websocket_handshake() const;
-                std::string encode_websocket_frame(const std::string &payload) const;
                 std::string decode_websocket_frame(const std::string &frame) const;
 
                 // Utility functions
@@ -116,18 +210,22 @@ namespace open_dtc_server
                 int socket_;
                 std::string host_;
                 uint16_t port_;
+                uint32_t exchange_id_; // SymbolTable::exchanges() ID stamped on every update
 
-                // SSL/TLS state
-                bool ssl_initialized_;
-#ifdef _WIN32
-                void *ssl_creds_;   // CredHandle*
-                void *ssl_context_; // CtxtHandle*
-                bool ssl_context_valid_;
-#endif
+                // TLS state; an SSL connection is not thread-safe, so the worker's reads
+                // and the senders' writes take tls_mutex_
+                bool use_tls_;
+                TlsTransport tls_;
+                mutable std::mutex tls_mutex_;
 
                 // Threading
                 std::thread worker_thread_;
+                std::thread parser_thread_;
                 std::thread ping_thread_;
+                int ingress_cpu_;
+                int book_cpu_;
+                bool busy_poll_;
+                int socket_busy_poll_us_;
 
                 // Subscriptions
                 std::vector<std::string> subscribed_symbols_;
@@ -136,11 +234,51 @@ namespace open_dtc_server
                 // Message queues
                 std::queue<std::string> send_queue_;
                 std::mutex send_queue_mutex_;
-                std::mutex callback_mutex_;
+                std::mutex send_mutex_; // frames from subscribe calls and pongs must not interleave
+                WebSocketFrameEncoder frame_encoder_; // guarded by send_mutex_
+
+                // Receive buffer, reused for the life of the client (worker thread only)
+                WebSocketFrameDecoder frame_decoder_;
+
+                // permessage-deflate: one zlib stream per connection (worker thread only)
+                bool use_compression_;
+                MessageInflater inflater_;
+
+                // Data messages from the receive thread to the parser thread. Each record
+                // is the receive time (8 bytes) followed by the message. The parser parks
+                // on parser_cv_ only after finding the ring empty, so the mutex is only
+                // taken when it is idle.
+                static constexpr size_t RECEIVE_RING_BYTES = 32 * 1024 * 1024;
+                util::SpscByteRing receive_ring_;
+                std::atomic<bool> parser_parked_;
+                std::mutex parser_mutex_;
+                std::condition_variable parser_cv_;
+                std::atomic<uint64_t> ring_full_waits_; // times the receive thread found the ring full
+
+                // Level 2 books by SymbolTable ID, built from snapshot/l2update on the parser thread
+                std::unordered_map<uint32_t, exchanges::base::OrderBook> books_;
+
+                // Consistency checks on the parser thread. The level2 channel carries no
+                // sequence numbers, so a lost update only shows when it leaves a book
+                // crossed (a missed level removal); that drops just that book and
+                // resubscribes its level2 channel for a fresh snapshot while every other
+                // product keeps streaming. Missed additions or size changes that keep
+                // the book uncrossed are not detected. Matches carry their product's
+                // sequence, which also advances for channels that are not subscribed,
+                // so trades are only checked for duplicates.
+                SequenceTracker trade_sequences_;
+                std::unordered_map<uint32_t, uint64_t> pending_resyncs_; // symbol -> request time (us)
+                static constexpr uint64_t RESYNC_RETRY_US = 5000000;
+                std::atomic<uint64_t> book_resyncs_;
+                std::atomic<uint64_t> duplicates_dropped_;
+
+                // Depth changes of the message being parsed, reused to avoid allocating per update
+                exchanges::base::MarketDepthUpdate depth_update_;
 
                 // Callbacks
                 TradeCallback trade_callback_;
                 Level2Callback level2_callback_;
+                DepthCallback depth_callback_;
 
                 // Statistics
                 std::atomic<int> messages_received_;
@@ -1,4 +1,6 @@
 #include "coinbase_dtc_core/core/dtc/protocol.hpp"
+#include "coinbase_dtc_core/core/dtc/binary_encoder.hpp"
+#include "coinbase_dtc_core/core/dtc/message_views.hpp"
 #include <cstring>
 #include <cstdio>
 #include <chrono>
@@ -10,114 +12,184 @@ namespace open_dtc_server
         namespace dtc
         {
 
-            // Stub implementations that compile - we'll just make simple versions
+            // Session and request messages use the fixed-layout binary encoding;
+            // deserialization goes through the zero-copy views in message_views.hpp
 
             uint16_t LogonRequest::get_size() const
             {
-                return sizeof(MessageHeader) + 100; // Simple approximation
+                return sizeof(wire::LogonRequest);
             }
 
             std::vector<uint8_t> LogonRequest::serialize() const
             {
                 std::vector<uint8_t> buffer(get_size());
-                MessageHeader header(get_size(), get_type());
-                std::memcpy(buffer.data(), &header, sizeof(MessageHeader));
+                encode_logon_request(buffer.data(), buffer.size(), *this);
                 return buffer;
             }
 
             bool LogonRequest::deserialize(const uint8_t *data, uint16_t size)
             {
-                return size >= sizeof(MessageHeader);
+                LogonRequestView view(data, size);
+                if (!view.is_valid())
+                {
+                    return false;
+                }
+
+                protocol_version = static_cast<uint16_t>(view.protocol_version());
+                username = std::string(view.username());
+                password = std::string(view.password());
+                general_text_data = std::string(view.general_text_data());
+                integer_1 = view.integer_1();
+                integer_2 = view.integer_2();
+                heartbeat_interval_in_seconds = static_cast<uint8_t>(view.heartbeat_interval_in_seconds());
+                trade_account = std::string(view.trade_account());
+                hardware_identifier = std::string(view.hardware_identifier());
+                client_name = std::string(view.client_name());
+                return true;
             }
 
             uint16_t LogonResponse::get_size() const
             {
-                return sizeof(MessageHeader) + 100;
+                return sizeof(wire::LogonResponse);
             }
 
             std::vector<uint8_t> LogonResponse::serialize() const
             {
                 std::vector<uint8_t> buffer(get_size());
-                MessageHeader header(get_size(), get_type());
-                std::memcpy(buffer.data(), &header, sizeof(MessageHeader));
+                encode_logon_response(buffer.data(), buffer.size(), *this);
                 return buffer;
             }
 
             bool LogonResponse::deserialize(const uint8_t *data, uint16_t size)
             {
-                return size >= sizeof(MessageHeader);
+                if (!data || size < sizeof(wire::LogonResponse))
+                {
+                    return false;
+                }
+
+                wire::LogonResponse msg;
+                std::memcpy(&msg, data, sizeof(msg));
+                protocol_version = static_cast<uint16_t>(msg.protocol_version);
+                result = msg.result == static_cast<int32_t>(wire::LogonStatus::LOGON_SUCCESS) ? 1 : 0;
+                result_text.assign(msg.result_text, strnlen(msg.result_text, sizeof(msg.result_text)));
+                server_name.assign(msg.server_name, strnlen(msg.server_name, sizeof(msg.server_name)));
+                integer_1 = static_cast<uint16_t>(msg.integer_1);
+                market_depth_is_supported = msg.market_depth_is_supported;
+                use_integer_price_order_messages = msg.use_integer_price_order_messages;
+                return true;
             }
 
             uint16_t MarketDataRequest::get_size() const
             {
-                return sizeof(MessageHeader) + 50;
+                return sizeof(wire::MarketDataRequest);
             }
 
             std::vector<uint8_t> MarketDataRequest::serialize() const
             {
                 std::vector<uint8_t> buffer(get_size());
-                MessageHeader header(get_size(), get_type());
-                std::memcpy(buffer.data(), &header, sizeof(MessageHeader));
+                encode_market_data_request(buffer.data(), buffer.size(), request_action, symbol_id, symbol, exchange);
                 return buffer;
             }
 
             bool MarketDataRequest::deserialize(const uint8_t *data, uint16_t size)
             {
-                return size >= sizeof(MessageHeader);
+                MarketDataRequestView view(data, size);
+                if (!view.is_valid())
+                {
+                    return false;
+                }
+
+                request_action = view.request_action();
+                symbol_id = static_cast<uint16_t>(view.symbol_id());
+                symbol = std::string(view.symbol());
+                exchange = std::string(view.exchange());
+                return true;
             }
 
+            // Market data updates use the fixed-layout binary encoding (see binary_encoder.hpp)
+
             uint16_t MarketDataUpdateTrade::get_size() const
             {
-                return sizeof(MessageHeader) + 40;
+                return sizeof(wire::MarketDataUpdateTrade);
             }
 
             std::vector<uint8_t> MarketDataUpdateTrade::serialize() const
             {
                 std::vector<uint8_t> buffer(get_size());
-                MessageHeader header(get_size(), get_type());
-                std::memcpy(buffer.data(), &header, sizeof(MessageHeader));
+                encode_trade_update(buffer.data(), buffer.size(), *this);
                 return buffer;
             }
 
             bool MarketDataUpdateTrade::deserialize(const uint8_t *data, uint16_t size)
             {
-                return size >= sizeof(MessageHeader);
+                if (!data || size < sizeof(wire::MarketDataUpdateTrade))
+                {
+                    return false;
+                }
+
+                wire::MarketDataUpdateTrade msg;
+                std::memcpy(&msg, data, sizeof(msg));
+                symbol_id = static_cast<uint16_t>(msg.symbol_id);
+                at_bid_or_ask = msg.at_bid_or_ask;
+                price = msg.price;
+                volume = msg.volume;
+                date_time = msg.date_time;
+                return true;
             }
 
             uint16_t MarketDataUpdateBidAsk::get_size() const
             {
-                return sizeof(MessageHeader) + 50;
+                return sizeof(wire::MarketDataUpdateBidAsk);
             }
 
             std::vector<uint8_t> MarketDataUpdateBidAsk::serialize() const
             {
                 std::vector<uint8_t> buffer(get_size());
-                MessageHeader header(get_size(), get_type());
-                std::memcpy(buffer.data(), &header, sizeof(MessageHeader));
+                encode_bid_ask_update(buffer.data(), buffer.size(), *this);
                 return buffer;
             }
 
             bool MarketDataUpdateBidAsk::deserialize(const uint8_t *data, uint16_t size)
             {
-                return size >= sizeof(MessageHeader);
+                if (!data || size < sizeof(wire::MarketDataUpdateBidAsk))
+                {
+                    return false;
+                }
+
+                wire::MarketDataUpdateBidAsk msg;
+                std::memcpy(&msg, data, sizeof(msg));
+                symbol_id = static_cast<uint16_t>(msg.symbol_id);
+                bid_price = msg.bid_price;
+                bid_quantity = msg.bid_quantity;
+                ask_price = msg.ask_price;
+                ask_quantity = msg.ask_quantity;
+                date_time = msg.date_time;
+                return true;
             }
 
             uint16_t Heartbeat::get_size() const
             {
-                return sizeof(MessageHeader) + 20;
+                return sizeof(wire::Heartbeat);
             }
 
             std::vector<uint8_t> Heartbeat::serialize() const
             {
                 std::vector<uint8_t> buffer(get_size());
-                MessageHeader header(get_size(), get_type());
-                std::memcpy(buffer.data(), &header, sizeof(MessageHeader));
+                encode_heartbeat(buffer.data(), buffer.size(), num_drops, static_cast<int64_t>(current_date_time));
                 return buffer;
             }
 
             bool Heartbeat::deserialize(const uint8_t *data, uint16_t size)
             {
-                return size >= sizeof(MessageHeader);
+                HeartbeatView view(data, size);
+                if (!view.is_valid())
+                {
+                    return false;
+                }
+
+                num_drops = view.num_drops();
+                current_date_time = static_cast<uint64_t>(view.current_date_time());
+                return true;
             }
 
             // Protocol class implementation
@@ -158,6 +230,15 @@ namespace open_dtc_server
                     }
                     break;
                 }
+                case MessageType::HEARTBEAT:
+                {
+                    auto msg = std::make_unique<Heartbeat>();
+                    if (msg->deserialize(data, header->size))
+                    {
+                        return std::move(msg);
+                    }
+                    break;
+                }
                 case MessageType::MARKET_DATA_REQUEST:
                 {
                     auto msg = std::make_unique<MarketDataRequest>();
@@ -202,13 +283,13 @@ namespace open_dtc_server
             }
 
             std::unique_ptr<MarketDataUpdateTrade> Protocol::create_trade_update(
-                uint16_t symbol_id, double price, double volume, uint64_t timestamp)
+                uint16_t symbol_id, double price, double volume, double date_time)
             {
                 auto update = std::make_unique<MarketDataUpdateTrade>();
                 update->symbol_id = symbol_id;
                 update->price = price;
                 update->volume = volume;
-                update->date_time = timestamp;
+                update->date_time = date_time;
                 return update;
             }
 
@@ -234,6 +315,13 @@ namespace open_dtc_server
                 return static_cast<uint64_t>(time_t);
             }
 
+            double Protocol::get_current_date_time()
+            {
+                auto micros = std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::system_clock::now().time_since_epoch());
+                return static_cast<double>(micros.count()) / 1000000.0;
+            }
+
             MessageType Protocol::get_message_type(const uint8_t *data, uint16_t size)
             {
                 if (!data || size < sizeof(MessageHeader))
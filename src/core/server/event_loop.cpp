@@ -0,0 +1,209 @@
+#include "coinbase_dtc_core/core/server/event_loop.hpp"
+#include "coinbase_dtc_core/core/util/log.hpp"
+#include "coinbase_dtc_core/core/util/thread_tuning.hpp"
+#include <cerrno>
+#include <cstring>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
+namespace coinbase_dtc_core
+{
+    namespace core
+    {
+        namespace server
+        {
+
+            EventLoop::EventLoop(size_t index, int cpu, bool busy_poll)
+                : index_(index), cpu_(cpu), busy_poll_(busy_poll)
+            {
+#ifdef __linux__
+                epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+                wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+#endif
+            }
+
+            EventLoop::~EventLoop()
+            {
+                stop();
+#ifdef __linux__
+                if (wake_fd_ >= 0)
+                {
+                    ::close(wake_fd_);
+                }
+                if (epoll_fd_ >= 0)
+                {
+                    ::close(epoll_fd_);
+                }
+#endif
+            }
+
+            bool EventLoop::start()
+            {
+#ifdef __linux__
+                if (running_ || epoll_fd_ < 0 || wake_fd_ < 0)
+                {
+                    return false;
+                }
+
+                epoll_event event{};
+                event.events = EPOLLIN;
+                event.data.fd = wake_fd_;
+                if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &event) != 0 && errno != EEXIST)
+                {
+                    open_dtc_server::util::log("[EVENT_LOOP] Failed to register wake descriptor: " +
+                                               std::string(std::strerror(errno)));
+                    return false;
+                }
+
+                running_ = true;
+                thread_ = std::thread(&EventLoop::run, this);
+                return true;
+#else
+                open_dtc_server::util::log("[EVENT_LOOP] epoll is not available on this platform");
+                return false;
+#endif
+            }
+
+            void EventLoop::stop()
+            {
+                if (!running_.exchange(false))
+                {
+                    return;
+                }
+
+                wake();
+                if (thread_.joinable())
+                {
+                    thread_.join();
+                }
+            }
+
+            bool EventLoop::add(int fd, uint32_t events, EventHandler handler)
+            {
+#ifdef __linux__
+                epoll_event event{};
+                event.events = events;
+                event.data.fd = fd;
+                if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) != 0)
+                {
+                    return false;
+                }
+
+                handlers_[fd] = std::move(handler);
+                fd_count_++;
+                return true;
+#else
+                (void)fd;
+                (void)events;
+                (void)handler;
+                return false;
+#endif
+            }
+
+            void EventLoop::remove(int fd)
+            {
+                auto it = handlers_.find(fd);
+                if (it == handlers_.end())
+                {
+                    return;
+                }
+
+#ifdef __linux__
+                epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+#endif
+                // The handler may be the one currently running, so keep it alive
+                // until the current batch of events has been dispatched
+                retired_handlers_.push_back(std::move(it->second));
+                handlers_.erase(it);
+                fd_count_--;
+            }
+
+            void EventLoop::post(Task task)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(tasks_mutex_);
+                    pending_tasks_.push_back(std::move(task));
+                }
+                wake();
+            }
+
+            void EventLoop::wake()
+            {
+#ifdef __linux__
+                uint64_t one = 1;
+                ssize_t result = ::write(wake_fd_, &one, sizeof(one));
+                (void)result;
+#endif
+            }
+
+            void EventLoop::run_pending_tasks()
+            {
+                std::vector<Task> tasks;
+                {
+                    std::lock_guard<std::mutex> lock(tasks_mutex_);
+                    tasks.swap(pending_tasks_);
+                }
+
+                for (auto &task : tasks)
+                {
+                    task();
+                }
+            }
+
+            void EventLoop::run()
+            {
+#ifdef __linux__
+                open_dtc_server::util::ScopedThreadRegistration registration("dtc-io-" + std::to_string(index_), cpu_);
+
+                constexpr int MAX_EVENTS = 256;
+                epoll_event events[MAX_EVENTS];
+                int timeout = busy_poll_ ? 0 : -1;
+
+                while (running_)
+                {
+                    int count = epoll_wait(epoll_fd_, events, MAX_EVENTS, timeout);
+                    if (count < 0)
+                    {
+                        if (errno == EINTR)
+                        {
+                            continue;
+                        }
+                        open_dtc_server::util::log("[EVENT_LOOP] epoll_wait failed: " + std::string(std::strerror(errno)));
+                        break;
+                    }
+
+                    for (int i = 0; i < count; i++)
+                    {
+                        int fd = events[i].data.fd;
+                        if (fd == wake_fd_)
+                        {
+                            uint64_t value;
+                            while (::read(wake_fd_, &value, sizeof(value)) > 0)
+                            {
+                            }
+                            continue;
+                        }
+
+                        auto it = handlers_.find(fd);
+                        if (it != handlers_.end())
+                        {
+                            it->second(events[i].events);
+                        }
+                    }
+
+                    run_pending_tasks();
+                    retired_handlers_.clear();
+                }
+
+                run_pending_tasks();
+                retired_handlers_.clear();
+#endif
+            }
+
+        } // namespace server
+    } // namespace core
+} // namespace coinbase_dtc_core
@@ -0,0 +1,70 @@
+#include "coinbase_dtc_core/core/server/level2_conflator.hpp"
+
+using open_dtc_server::exchanges::base::MarketLevel2;
+
+namespace coinbase_dtc_core
+{
+    namespace core
+    {
+        namespace server
+        {
+
+            bool Level2Conflator::offer(const MarketLevel2 &level2)
+            {
+                uint32_t symbol = level2.symbol_id;
+
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (symbol >= latest_.size())
+                {
+                    latest_.resize(symbol + 1);
+                    is_pending_.resize(symbol + 1, 0);
+                }
+
+                MarketLevel2 &latest = latest_[symbol];
+                if (is_pending_[symbol])
+                {
+                    bool bid_changed = latest.is_bid_change || level2.is_bid_change;
+                    bool ask_changed = latest.is_ask_change || level2.is_ask_change;
+                    latest = level2;
+                    latest.is_bid_change = bid_changed;
+                    latest.is_ask_change = ask_changed;
+                    conflated_count_++;
+                    return false;
+                }
+
+                latest = level2;
+                is_pending_[symbol] = 1;
+                pending_symbols_.push_back(symbol);
+                return true;
+            }
+
+            size_t Level2Conflator::take(std::vector<MarketLevel2> &out)
+            {
+                out.clear();
+
+                std::lock_guard<std::mutex> lock(mutex_);
+                out.reserve(pending_symbols_.size());
+                for (uint32_t symbol : pending_symbols_)
+                {
+                    out.push_back(latest_[symbol]);
+                    is_pending_[symbol] = 0;
+                }
+                pending_symbols_.clear();
+                return out.size();
+            }
+
+            bool Level2Conflator::has_pending() const
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                return !pending_symbols_.empty();
+            }
+
+            uint64_t Level2Conflator::get_conflated_count() const
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                return conflated_count_;
+            }
+
+        } // namespace server
+    } // namespace core
+} // namespace coinbase_dtc_core
@@ -1,5 +1,6 @@
 #include "coinbase_dtc_core/core/server/server.hpp"
 #include "coinbase_dtc_core/core/util/log.hpp"
+#include "coinbase_dtc_core/exchanges/coinbase/settings/coinbase_settings.h"
 #include <iostream>
 #include <chrono>
 #include <thread>
@@ -37,6 +38,9 @@ int main()
         config.password = "";
         config.require_authentication = false;
 
+        // Products clients may request; the feeds subscribe to each on its first subscriber
+        config.symbols = open_dtc_server::exchanges::coinbase::settings::products::ALL_SUPPORTED;
+
         // Create server instance
         DTCServer srv(config);
         g_server = &srv;
@@ -0,0 +1,201 @@
+#include "coinbase_dtc_core/core/server/outbound_queue.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace coinbase_dtc_core
+{
+    namespace core
+    {
+        namespace server
+        {
+
+            OutboundQueue::OutboundQueue(size_t capacity)
+                : capacity_(capacity), ring_(new uint8_t[capacity])
+            {
+            }
+
+            bool OutboundQueue::push(const uint8_t *data, size_t size)
+            {
+                if (size == 0 || size > capacity_ - size_)
+                {
+                    return size == 0;
+                }
+
+                // Inline bytes never exceed size_, so they always fit in the ring
+                size_t tail = (ring_head_ + ring_size_) % capacity_;
+                size_t first = std::min(size, capacity_ - tail);
+                std::memcpy(ring_.get() + tail, data, first);
+                std::memcpy(ring_.get(), data + first, size - first);
+                ring_size_ += size;
+                size_ += size;
+
+                // Consecutive inline messages share one segment
+                if (!segments_.empty() && !segments_.back().message)
+                {
+                    segments_.back().size += static_cast<uint32_t>(size);
+                }
+                else
+                {
+                    segments_.push_back(Segment{nullptr, static_cast<uint32_t>(size), 0});
+                }
+                return true;
+            }
+
+            bool OutboundQueue::push_shared(std::shared_ptr<const SharedMessage> message, uint32_t symbol_id)
+            {
+                if (!message || message->size > capacity_ - size_)
+                {
+                    return false;
+                }
+
+                size_ += message->size;
+                uint32_t size = message->size;
+                segments_.push_back(Segment{std::move(message), size, symbol_id});
+                return true;
+            }
+
+            bool OutboundQueue::conflate(uint32_t key, const uint8_t *data, size_t size)
+            {
+                if (size > MAX_CONFLATED_MESSAGE_SIZE)
+                {
+                    return false;
+                }
+
+                auto it = conflated_index_.find(key);
+                ConflatedMessage *slot;
+                if (it != conflated_index_.end())
+                {
+                    slot = &conflated_[it->second];
+                }
+                else
+                {
+                    conflated_index_[key] = conflated_.size();
+                    conflated_.push_back(ConflatedMessage());
+                    slot = &conflated_.back();
+                    slot->key = key;
+                }
+
+                slot->size = static_cast<uint16_t>(size);
+                std::memcpy(slot->data, data, size);
+                return true;
+            }
+
+            size_t OutboundQueue::peek(iovec *iov, size_t max_iov) const
+            {
+                size_t count = 0;
+                size_t ring_position = ring_head_;
+
+                auto add = [&](const uint8_t *base, size_t length)
+                {
+                    if (length == 0)
+                    {
+                        return;
+                    }
+                    iov[count].iov_base = const_cast<uint8_t *>(base);
+                    iov[count].iov_len = length;
+                    count++;
+                };
+
+                for (size_t i = 0; i < segments_.size(); i++)
+                {
+                    const Segment &segment = segments_[i];
+                    size_t skip = i == 0 ? front_offset_ : 0;
+
+                    if (!segment.message)
+                    {
+                        if (count + 2 > max_iov)
+                        {
+                            break;
+                        }
+                        size_t length = segment.size - skip;
+                        size_t first = std::min(length, capacity_ - ring_position);
+                        add(ring_.get() + ring_position, first);
+                        add(ring_.get(), length - first);
+                        ring_position = (ring_position + length) % capacity_;
+                        continue;
+                    }
+
+                    if (count + 3 > max_iov)
+                    {
+                        break;
+                    }
+
+                    // Shared bytes before the symbol ID, the client's symbol ID, shared bytes after it
+                    const SharedMessage &message = *segment.message;
+                    size_t patch = message.symbol_id_offset;
+                    size_t id_end = patch + sizeof(segment.symbol_id);
+                    if (skip < patch)
+                    {
+                        add(message.data + skip, patch - skip);
+                    }
+                    if (skip < id_end)
+                    {
+                        size_t id_skip = skip > patch ? skip - patch : 0;
+                        add(reinterpret_cast<const uint8_t *>(&segment.symbol_id) + id_skip, sizeof(segment.symbol_id) - id_skip);
+                    }
+                    size_t tail_start = std::max(skip, id_end);
+                    add(message.data + tail_start, message.size - tail_start);
+                }
+                return count;
+            }
+
+            void OutboundQueue::consume(size_t bytes)
+            {
+                bytes = std::min(bytes, size_);
+                while (bytes > 0 && !segments_.empty())
+                {
+                    Segment &segment = segments_.front();
+                    size_t remaining = segment.size - front_offset_;
+                    size_t taken = std::min(bytes, remaining);
+
+                    if (!segment.message)
+                    {
+                        ring_head_ = (ring_head_ + taken) % capacity_;
+                        ring_size_ -= taken;
+                    }
+                    size_ -= taken;
+                    bytes -= taken;
+
+                    if (taken == remaining)
+                    {
+                        segments_.pop_front();
+                        front_offset_ = 0;
+                    }
+                    else
+                    {
+                        front_offset_ += taken;
+                    }
+                }
+
+                if (ring_size_ == 0)
+                {
+                    ring_head_ = 0;
+                }
+
+                refill_from_conflated();
+            }
+
+            void OutboundQueue::refill_from_conflated()
+            {
+                size_t moved = 0;
+                while (moved < conflated_.size() && conflated_[moved].size <= capacity_ - size_)
+                {
+                    push(conflated_[moved].data, conflated_[moved].size);
+                    moved++;
+                }
+                if (moved == 0)
+                {
+                    return;
+                }
+
+                conflated_.erase(conflated_.begin(), conflated_.begin() + moved);
+                conflated_index_.clear();
+                for (size_t i = 0; i < conflated_.size(); i++)
+                {
+                    conflated_index_[conflated_[i].key] = i;
+                }
+            }
+
+        } // namespace server
+    } // namespace core
+} // namespace coinbase_dtc_core
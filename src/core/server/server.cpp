@@ -1,10 +1,19 @@
 #include "coinbase_dtc_core/core/server/server.hpp"
+#include "coinbase_dtc_core/core/dtc/binary_encoder.hpp"
+#include "coinbase_dtc_core/core/dtc/message_views.hpp"
 #include "coinbase_dtc_core/core/util/log.hpp"
+#include "coinbase_dtc_core/core/util/symbol_table.hpp"
+#include "coinbase_dtc_core/core/util/thread_tuning.hpp"
+#include "coinbase_dtc_core/core/util/timestamp.hpp"
 #include <iostream>
 #include <sstream>
 #include <chrono>
 #include <algorithm>
+#include <cerrno>
 #include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <iomanip>
 
 #ifdef _WIN32
 #include <winsock2.h>
@@ -13,10 +22,22 @@
 #else
 #include <sys/socket.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <arpa/inet.h>
 #include <unistd.h>
 #endif
 
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/uio.h>
+#endif
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+using namespace open_dtc_server::core::dtc;
+
 namespace coinbase_dtc_core
 {
     namespace core
@@ -26,8 +47,25 @@ namespace coinbase_dtc_core
 
             // DTCServer Implementation
             DTCServer::DTCServer(const ServerConfig &config)
-                : config_(config), server_running_(false)
+                : config_(config), server_running_(false),
+                  protocol_(std::make_unique<Protocol>())
             {
+                // The logon response only varies in a few fields per client, so encode
+                // the constant part once and patch it per logon
+                LogonResponse response;
+                response.protocol_version = config_.protocol_version;
+                response.server_name = config_.server_name;
+                response.trading_is_supported = 0;
+                response.order_cancel_replace_supported = 0;
+                std::memset(&logon_response_template_, 0, sizeof(logon_response_template_));
+                encode_logon_response(reinterpret_cast<uint8_t *>(&logon_response_template_),
+                                      sizeof(logon_response_template_), response);
+
+                for (const auto &symbol : config_.symbols)
+                {
+                    allowed_symbols_.insert(open_dtc_server::util::SymbolTable::symbols().intern(symbol));
+                }
+
                 open_dtc_server::util::log("DTCServer initialized with config: " + config_.server_name);
             }
 
@@ -45,10 +83,78 @@ namespace coinbase_dtc_core
                     return false;
                 }
 
-                // Initialize server
+#ifdef __linux__
+                listen_fd_ = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+                if (listen_fd_ < 0)
+                {
+                    open_dtc_server::util::log("Failed to create listening socket: " + std::string(std::strerror(errno)));
+                    return false;
+                }
+
+                int reuse = 1;
+                setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+                sockaddr_in address{};
+                address.sin_family = AF_INET;
+                address.sin_port = htons(config_.port);
+                if (inet_pton(AF_INET, config_.bind_address.c_str(), &address.sin_addr) != 1 ||
+                    ::bind(listen_fd_, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 ||
+                    ::listen(listen_fd_, SOMAXCONN) != 0)
+                {
+                    open_dtc_server::util::log("Failed to listen on " + config_.bind_address + ":" +
+                                               std::to_string(config_.port) + ": " + std::strerror(errno));
+                    ::close(listen_fd_);
+                    listen_fd_ = -1;
+                    return false;
+                }
+
+                socklen_t address_length = sizeof(address);
+                getsockname(listen_fd_, reinterpret_cast<sockaddr *>(&address), &address_length);
+                bound_port_ = ntohs(address.sin_port);
+
+                unsigned int io_threads = config_.io_threads;
+                if (io_threads == 0)
+                {
+                    io_threads = std::max(1u, std::thread::hardware_concurrency());
+                }
+                for (unsigned int i = 0; i < io_threads; i++)
+                {
+                    int cpu = i < config_.io_thread_cpus.size() ? config_.io_thread_cpus[i] : -1;
+                    io_loops_.push_back(std::make_unique<EventLoop>(i, cpu, config_.busy_poll));
+                }
+
+                io_loops_[0]->add(listen_fd_, EPOLLIN | EPOLLET, [this](uint32_t)
+                                  { accept_connections(); });
+
+                for (auto &loop : io_loops_)
+                {
+                    if (!loop->start())
+                    {
+                        open_dtc_server::util::log("Failed to start I/O thread " + std::to_string(loop->get_index()));
+                        server_running_ = true;
+                        stop();
+                        return false;
+                    }
+                }
+
+                server_start_time_ = std::chrono::steady_clock::now();
                 server_running_ = true;
-                open_dtc_server::util::log("DTC Server started successfully on port " + std::to_string(config_.port));
+                should_shutdown_ = false;
+                if (config_.heartbeat_interval_seconds > 0)
+                {
+                    heartbeat_thread_ = std::thread(&DTCServer::heartbeat_monitor_thread, this);
+                }
+                if (config_.level2_conflation_interval_ms > 0)
+                {
+                    conflation_thread_ = std::thread(&DTCServer::conflation_thread, this);
+                }
+                open_dtc_server::util::log("DTC Server started successfully on port " + std::to_string(bound_port_) +
+                                           " with " + std::to_string(io_threads) + " I/O threads");
                 return true;
+#else
+                open_dtc_server::util::log("DTC Server requires epoll (Linux) to accept connections");
+                return false;
+#endif
             }
 
             void DTCServer::stop()
@@ -60,6 +166,48 @@ namespace coinbase_dtc_core
 
                 open_dtc_server::util::log("Stopping DTC Server...");
                 server_running_ = false;
+
+                {
+                    std::lock_guard<std::mutex> lock(shutdown_mutex_);
+                    should_shutdown_ = true;
+                }
+                shutdown_cv_.notify_all();
+                if (heartbeat_thread_.joinable())
+                {
+                    heartbeat_thread_.join();
+                }
+                if (conflation_thread_.joinable())
+                {
+                    conflation_thread_.join();
+                }
+
+                // Stop the I/O threads first so no handler runs while connections are torn down
+                for (auto &loop : io_loops_)
+                {
+                    loop->stop();
+                }
+
+                {
+                    std::lock_guard<std::mutex> lock(clients_mutex_);
+                    for (auto &client : clients_)
+                    {
+                        client->disconnect();
+                    }
+                    clients_.clear();
+                    client_count_ = 0;
+                }
+                subscriptions_.clear();
+                depth_subscriptions_.clear();
+                io_loops_.clear();
+
+#ifndef _WIN32
+                if (listen_fd_ >= 0)
+                {
+                    ::close(listen_fd_);
+                    listen_fd_ = -1;
+                }
+#endif
+                bound_port_ = 0;
                 open_dtc_server::util::log("DTC Server stopped");
             }
 
@@ -99,8 +247,45 @@ namespace coinbase_dtc_core
 
             std::vector<std::string> DTCServer::get_subscribed_symbols() const
             {
-                // TODO: Return actual subscribed symbols
-                return {};
+                return subscriptions_.symbols();
+            }
+
+            void DTCServer::set_integer_price_scale(const std::string &symbol, const IntegerPriceScale &scale)
+            {
+                uint32_t symbol_id = open_dtc_server::util::SymbolTable::symbols().intern(symbol);
+                std::lock_guard<std::mutex> lock(symbols_mutex_);
+                integer_price_scales_[symbol_id] = scale;
+            }
+
+            IntegerPriceScale DTCServer::get_integer_price_scale(uint32_t symbol_id)
+            {
+                std::lock_guard<std::mutex> lock(symbols_mutex_);
+                auto it = integer_price_scales_.find(symbol_id);
+                if (it != integer_price_scales_.end())
+                {
+                    return it->second;
+                }
+
+                IntegerPriceScale scale;
+                scale.price_multiplier = config_.default_integer_price_multiplier;
+                scale.volume_multiplier = config_.default_integer_volume_multiplier;
+                return scale;
+            }
+
+            void DTCServer::report_integer_scale_overflow(uint32_t symbol_id, const IntegerPriceScale &scale)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(symbols_mutex_);
+                    if (!integer_scale_overflows_.insert(symbol_id).second)
+                    {
+                        return;
+                    }
+                }
+                open_dtc_server::util::log("[WARNING] " + open_dtc_server::util::SymbolTable::symbols().name(symbol_id) +
+                                           " does not fit its integer scale (price x" +
+                                           std::to_string(scale.price_multiplier) + ", volume x" +
+                                           std::to_string(scale.volume_multiplier) +
+                                           "); updates it cannot represent are not sent to *_INT clients");
             }
 
             std::string DTCServer::get_status() const
@@ -116,8 +301,1139 @@ namespace coinbase_dtc_core
 
             int DTCServer::get_client_count() const
             {
-                // TODO: Return actual client count
-                return 0;
+                return client_count_;
+            }
+
+            std::string DTCServer::get_statistics() const
+            {
+                std::ostringstream stats;
+                stats << "DTCServer Statistics:\n";
+                if (server_running_)
+                {
+                    auto uptime = std::chrono::steady_clock::now() - server_start_time_;
+                    stats << "  Uptime: " << std::chrono::duration_cast<std::chrono::seconds>(uptime).count() << " s\n";
+                }
+                stats << "  Clients: " << get_client_count() << "\n";
+                stats << "  Messages Received: " << total_messages_received_ << "\n";
+                stats << "  Messages Sent: " << total_messages_sent_ << "\n";
+                stats << "  Trade Updates Sent: " << total_trade_updates_sent_ << "\n";
+                stats << "  Level 2 Updates Sent: " << total_level2_updates_sent_ << "\n";
+                stats << "  Depth Updates Sent: " << total_depth_updates_sent_ << "\n";
+                stats << "  Updates Dropped: " << total_updates_dropped_ << "\n";
+
+                // Every registered thread in the process, including the exchange
+                // feeds' ingress threads; a busy-polling thread shows ~100%
+                stats << "  Threads:\n";
+                for (const auto &thread : open_dtc_server::util::ThreadRegistry::instance().snapshot())
+                {
+                    stats << "    " << std::left << std::setw(18) << thread.name << std::right
+                          << " cpu " << (thread.cpu >= 0 ? std::to_string(thread.cpu) : std::string("-"))
+                          << "  time " << thread.cpu_time_us / 1000 << " ms"
+                          << "  usage " << std::fixed << std::setprecision(1) << thread.cpu_percent() << "%\n";
+                }
+                return stats.str();
+            }
+
+            // ========================================================================
+            // MESSAGE PROCESSING
+            // ========================================================================
+
+            void DTCServer::send_to_client(std::shared_ptr<ClientConnection> client, const std::vector<uint8_t> &message)
+            {
+                send_to_client(client, message.data(), message.size());
+            }
+
+            void DTCServer::send_to_client(const std::shared_ptr<ClientConnection> &client, const uint8_t *data, size_t size)
+            {
+                if (client && size > 0)
+                {
+                    handle_send_status(client, client->send_message(data, size));
+                }
+            }
+
+            void DTCServer::send_market_data(const std::shared_ptr<ClientConnection> &client,
+                                             const std::shared_ptr<const SharedMessage> &message, uint32_t symbol_id,
+                                             uint32_t conflation_key)
+            {
+                handle_send_status(client, client->send_market_data(message, symbol_id, conflation_key));
+            }
+
+            void DTCServer::handle_send_status(const std::shared_ptr<ClientConnection> &client, SendStatus status)
+            {
+                switch (status)
+                {
+                case SendStatus::NEEDS_FLUSH:
+                    schedule_flush(client);
+                    [[fallthrough]];
+                case SendStatus::QUEUED:
+                    total_messages_sent_++;
+                    break;
+                case SendStatus::DROPPED:
+                    total_updates_dropped_++;
+                    break;
+                case SendStatus::DISCONNECTED:
+                    // The shutdown wakes the owning loop, which closes the connection
+                    break;
+                }
+            }
+
+            void DTCServer::schedule_flush(const std::shared_ptr<ClientConnection> &client)
+            {
+                EventLoop *loop = client->get_event_loop();
+                if (!loop)
+                {
+                    client->flush_send_queue();
+                    return;
+                }
+
+                loop->post([this, client]()
+                           {
+                               if (!client->flush_send_queue())
+                               {
+                                   close_client(client);
+                               }
+                               else if (client->take_drained())
+                               {
+                                   request_conflation_flush();
+                               } });
+            }
+
+            void DTCServer::heartbeat_monitor_thread()
+            {
+                open_dtc_server::util::ScopedThreadRegistration registration("dtc-heartbeat");
+
+                std::unique_lock<std::mutex> lock(shutdown_mutex_);
+                while (!shutdown_cv_.wait_for(lock, std::chrono::seconds(config_.heartbeat_interval_seconds),
+                                              [this]()
+                                              { return should_shutdown_.load(); }))
+                {
+                    lock.unlock();
+
+                    std::vector<std::shared_ptr<ClientConnection>> clients;
+                    {
+                        std::lock_guard<std::mutex> clients_lock(clients_mutex_);
+                        clients = clients_;
+                    }
+
+                    // Heartbeats are session messages: the slow-consumer policy must not
+                    // drop them from a client that is falling behind, or the client would
+                    // take the server for dead
+                    uint8_t buffer[sizeof(wire::Heartbeat)];
+                    int64_t now = static_cast<int64_t>(std::time(nullptr));
+                    for (const auto &client : clients)
+                    {
+                        uint16_t length = encode_heartbeat(buffer, sizeof(buffer), client->take_num_drops(), now);
+                        send_to_client(client, buffer, length);
+                    }
+
+                    lock.lock();
+                }
+            }
+
+            void DTCServer::conflation_thread()
+            {
+                open_dtc_server::util::ScopedThreadRegistration registration("dtc-conflation", config_.conflation_thread_cpu);
+
+                auto interval = std::chrono::milliseconds(config_.level2_conflation_interval_ms);
+                std::vector<open_dtc_server::exchanges::base::MarketLevel2> pending;
+
+                std::unique_lock<std::mutex> lock(shutdown_mutex_);
+                while (!should_shutdown_)
+                {
+                    shutdown_cv_.wait_for(lock, interval, [this]()
+                                          { return should_shutdown_.load() || conflation_flush_requested_; });
+                    conflation_flush_requested_ = false;
+                    lock.unlock();
+
+                    level2_conflator_.take(pending);
+                    for (const auto &level2 : pending)
+                    {
+                        publish_level2(level2);
+                    }
+
+                    lock.lock();
+                }
+            }
+
+            // A client caught up after a backlog: send it the latest prices now
+            // rather than at the end of the window
+            void DTCServer::request_conflation_flush()
+            {
+                if (config_.level2_conflation_interval_ms <= 0 || !level2_conflator_.has_pending())
+                {
+                    return;
+                }
+
+                {
+                    std::lock_guard<std::mutex> lock(shutdown_mutex_);
+                    conflation_flush_requested_ = true;
+                }
+                shutdown_cv_.notify_all();
+            }
+
+            void DTCServer::process_client_message(const std::shared_ptr<ClientConnection> &client, const uint8_t *data, uint16_t size)
+            {
+                if (!Protocol::validate_message_header(data, size))
+                {
+                    return;
+                }
+
+                total_messages_received_++;
+
+                switch (Protocol::get_message_type(data, size))
+                {
+                case MessageType::LOGON_REQUEST:
+                    handle_logon_request(client, data, size);
+                    break;
+                case MessageType::HEARTBEAT:
+                    handle_heartbeat(client, data, size);
+                    break;
+                case MessageType::MARKET_DATA_REQUEST:
+                    handle_market_data_request(client, data, size);
+                    break;
+                case MessageType::MARKET_DEPTH_REQUEST:
+                    handle_market_depth_request(client, data, size);
+                    break;
+                case MessageType::LOGOFF:
+                    client->disconnect();
+                    break;
+                default:
+                    open_dtc_server::util::log("[SERVER] Unsupported message type " +
+                                               std::to_string(static_cast<uint16_t>(Protocol::get_message_type(data, size))) +
+                                               " from " + client->get_client_info());
+                    break;
+                }
+            }
+
+            void DTCServer::handle_logon_request(const std::shared_ptr<ClientConnection> &client, const uint8_t *data, uint16_t size)
+            {
+                LogonRequestView request(data, size);
+                if (!request.is_valid())
+                {
+                    return;
+                }
+
+                bool accepted = !config_.require_authentication || request.password() == config_.password;
+
+                std::unique_lock<std::mutex> session_lock(client->get_session_mutex());
+                ClientSession &session = client->get_session();
+                session.username.assign(request.username().data(), request.username().size());
+                session.client_info.assign(request.client_name().data(), request.client_name().size());
+                session.authenticated = accepted;
+                session.last_heartbeat = std::chrono::steady_clock::now();
+
+                wire::LogonResponse response = logon_response_template_;
+                if (accepted && config_.allow_integer_price_messages &&
+                    (request.integer_1() & wire::LOGON_FLAG_INTEGER_PRICES))
+                {
+                    session.market_data_encoding = MarketDataEncoding::INTEGER;
+                    response.use_integer_price_order_messages = 1;
+                }
+                else if (accepted && config_.allow_compact_market_data &&
+                         (request.integer_1() & wire::LOGON_FLAG_COMPACT_MARKET_DATA))
+                {
+                    session.market_data_encoding = MarketDataEncoding::COMPACT;
+                    response.integer_1 |= wire::LOGON_FLAG_COMPACT_MARKET_DATA;
+                }
+                response.result = static_cast<int32_t>(accepted ? wire::LogonStatus::LOGON_SUCCESS
+                                                                : wire::LogonStatus::LOGON_ERROR_NO_RECONNECT);
+                write_fixed_string(response.result_text, sizeof(response.result_text),
+                                   accepted ? "Logon successful" : "Invalid username or password");
+                session_lock.unlock();
+                send_to_client(client, reinterpret_cast<const uint8_t *>(&response), sizeof(response));
+
+                if (!accepted)
+                {
+                    open_dtc_server::util::log("[SERVER] Logon rejected for " + client->get_client_info());
+                    client->disconnect();
+                }
+            }
+
+            void DTCServer::handle_market_data_request(const std::shared_ptr<ClientConnection> &client, const uint8_t *data, uint16_t size)
+            {
+                MarketDataRequestView request(data, size);
+                if (!request.is_valid())
+                {
+                    return;
+                }
+
+                ClientSession &session = client->get_session();
+                uint32_t symbol_id = request.symbol_id();
+
+                if (!session.authenticated)
+                {
+                    send_market_data_reject(client, symbol_id, "Logon required before market data requests");
+                    return;
+                }
+
+                switch (request.request_action())
+                {
+                case RequestAction::SUBSCRIBE:
+                {
+                    if (request.symbol().empty() || symbol_id == 0)
+                    {
+                        send_market_data_reject(client, symbol_id, "Symbol and symbol ID are required");
+                        return;
+                    }
+
+                    uint32_t interned = find_allowed_symbol(request.symbol());
+                    if (interned == open_dtc_server::util::SymbolTable::INVALID_ID)
+                    {
+                        send_market_data_reject(client, symbol_id, "Unknown symbol");
+                        return;
+                    }
+
+                    std::string symbol(request.symbol());
+                    {
+                        std::lock_guard<std::mutex> lock(client->get_session_mutex());
+
+                        // A reused symbol ID replaces the symbol it named, and a symbol
+                        // subscribed again under a new ID gives up the old one
+                        auto previous_symbol = session.id_to_symbol.find(symbol_id);
+                        if (previous_symbol != session.id_to_symbol.end() && previous_symbol->second != symbol)
+                        {
+                            subscriptions_.remove(previous_symbol->second, client.get());
+                            session.subscribed_symbols.erase(std::remove(session.subscribed_symbols.begin(),
+                                                                         session.subscribed_symbols.end(),
+                                                                         previous_symbol->second),
+                                                             session.subscribed_symbols.end());
+                            session.symbol_to_id.erase(previous_symbol->second);
+                        }
+                        auto previous_id = session.symbol_to_id.find(symbol);
+                        if (previous_id != session.symbol_to_id.end() && previous_id->second != symbol_id)
+                        {
+                            session.id_to_symbol.erase(previous_id->second);
+                        }
+
+                        session.id_to_symbol[symbol_id] = symbol;
+                        session.symbol_to_id[symbol] = symbol_id;
+                        if (std::find(session.subscribed_symbols.begin(), session.subscribed_symbols.end(), symbol) ==
+                            session.subscribed_symbols.end())
+                        {
+                            session.subscribed_symbols.push_back(symbol);
+                        }
+                    }
+
+                    // The scale is fixed for the subscription, so publishing never looks it up
+                    bool first_subscriber = subscriptions_.add(symbol, client, symbol_id, session.market_data_encoding, 0,
+                                                               get_integer_price_scale(interned));
+                    if (first_subscriber && multi_feed_)
+                    {
+                        multi_feed_->subscribe_symbol(symbol, std::string(request.exchange()));
+                    }
+                    break;
+                }
+                case RequestAction::UNSUBSCRIBE:
+                {
+                    std::lock_guard<std::mutex> lock(client->get_session_mutex());
+                    auto it = session.id_to_symbol.find(symbol_id);
+                    if (it != session.id_to_symbol.end())
+                    {
+                        subscriptions_.remove(it->second, client.get());
+                        session.subscribed_symbols.erase(
+                            std::remove(session.subscribed_symbols.begin(), session.subscribed_symbols.end(), it->second),
+                            session.subscribed_symbols.end());
+                        session.symbol_to_id.erase(it->second);
+                        session.id_to_symbol.erase(it);
+                    }
+                    break;
+                }
+                default:
+                    send_market_data_reject(client, symbol_id, "Unsupported request action");
+                    break;
+                }
+            }
+
+            uint32_t DTCServer::find_allowed_symbol(std::string_view symbol) const
+            {
+                // Another server or feed in the process may have interned it; only the
+                // configured products are served
+                uint32_t symbol_id = open_dtc_server::util::SymbolTable::symbols().find(symbol);
+                return allowed_symbols_.count(symbol_id) ? symbol_id : open_dtc_server::util::SymbolTable::INVALID_ID;
+            }
+
+            void DTCServer::handle_heartbeat(const std::shared_ptr<ClientConnection> &client, const uint8_t *data, uint16_t size)
+            {
+                HeartbeatView heartbeat(data, size);
+                if (heartbeat.is_valid())
+                {
+                    client->get_session().last_heartbeat = std::chrono::steady_clock::now();
+                }
+            }
+
+            void DTCServer::send_market_data_reject(const std::shared_ptr<ClientConnection> &client, uint32_t symbol_id, const char *reason)
+            {
+                uint8_t buffer[sizeof(wire::MarketDataReject)];
+                uint16_t length = encode_market_data_reject(buffer, sizeof(buffer), symbol_id, reason);
+                send_to_client(client, buffer, length);
+            }
+
+            void DTCServer::handle_market_depth_request(const std::shared_ptr<ClientConnection> &client, const uint8_t *data, uint16_t size)
+            {
+                MarketDepthRequestView request(data, size);
+                if (!request.is_valid())
+                {
+                    return;
+                }
+
+                ClientSession &session = client->get_session();
+                uint32_t symbol_id = request.symbol_id();
+
+                if (!session.authenticated)
+                {
+                    send_market_depth_reject(client, symbol_id, "Logon required before market depth requests");
+                    return;
+                }
+
+                RequestAction action = request.request_action();
+                if (action == RequestAction::UNSUBSCRIBE)
+                {
+                    std::lock_guard<std::mutex> lock(client->get_session_mutex());
+                    auto it = session.depth_id_to_symbol.find(symbol_id);
+                    if (it != session.depth_id_to_symbol.end())
+                    {
+                        depth_subscriptions_.remove(it->second, client.get());
+                        session.depth_id_to_symbol.erase(it);
+                    }
+                    return;
+                }
+                if (action != RequestAction::SUBSCRIBE && action != RequestAction::SNAPSHOT)
+                {
+                    send_market_depth_reject(client, symbol_id, "Unsupported request action");
+                    return;
+                }
+
+                if (request.symbol().empty() || symbol_id == 0)
+                {
+                    send_market_depth_reject(client, symbol_id, "Symbol and symbol ID are required");
+                    return;
+                }
+
+                uint32_t symbol = find_allowed_symbol(request.symbol());
+                if (symbol == open_dtc_server::util::SymbolTable::INVALID_ID)
+                {
+                    send_market_depth_reject(client, symbol_id, "Unknown symbol");
+                    return;
+                }
+
+                uint16_t levels = config_.max_market_depth_levels;
+                if (request.num_levels() > 0 && request.num_levels() < levels)
+                {
+                    levels = static_cast<uint16_t>(request.num_levels());
+                }
+
+                std::string symbol_name(request.symbol());
+                if (action == RequestAction::SUBSCRIBE)
+                {
+                    // A reused symbol ID replaces the symbol it named, and a symbol
+                    // subscribed again under a new ID gives up the old one; both go before
+                    // the snapshot so no update for the old mapping follows it
+                    std::lock_guard<std::mutex> lock(client->get_session_mutex());
+                    auto previous_symbol = session.depth_id_to_symbol.find(symbol_id);
+                    if (previous_symbol != session.depth_id_to_symbol.end() && previous_symbol->second != symbol_name)
+                    {
+                        depth_subscriptions_.remove(previous_symbol->second, client.get());
+                        session.depth_id_to_symbol.erase(previous_symbol);
+                    }
+                    for (auto it = session.depth_id_to_symbol.begin(); it != session.depth_id_to_symbol.end();)
+                    {
+                        it = it->first != symbol_id && it->second == symbol_name ? session.depth_id_to_symbol.erase(it)
+                                                                                  : std::next(it);
+                    }
+                }
+
+                bool first_subscriber = false;
+                {
+                    // Register while holding the book so no change slips in between the
+                    // snapshot and the first update
+                    DepthBook &depth_book = get_depth_book(symbol);
+                    std::lock_guard<std::mutex> lock(depth_book.mutex);
+                    send_depth_snapshot(client, symbol_id, depth_book, levels);
+                    if (action == RequestAction::SUBSCRIBE)
+                    {
+                        first_subscriber = depth_subscriptions_.add(symbol_name, client, symbol_id,
+                                                                    MarketDataEncoding::STANDARD, levels);
+                    }
+                }
+
+                if (action == RequestAction::SUBSCRIBE)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(client->get_session_mutex());
+                        session.depth_id_to_symbol[symbol_id] = symbol_name;
+                    }
+                    if (first_subscriber && multi_feed_)
+                    {
+                        multi_feed_->subscribe_symbol(symbol_name, std::string(request.exchange()));
+                    }
+                }
+            }
+
+            void DTCServer::send_market_depth_reject(const std::shared_ptr<ClientConnection> &client, uint32_t symbol_id, const char *reason)
+            {
+                uint8_t buffer[sizeof(wire::MarketDepthReject)];
+                uint16_t length = encode_market_depth_reject(buffer, sizeof(buffer), symbol_id, reason);
+                send_to_client(client, buffer, length);
+            }
+
+            void DTCServer::add_client(std::shared_ptr<ClientConnection> client)
+            {
+                std::lock_guard<std::mutex> lock(clients_mutex_);
+                clients_.push_back(std::move(client));
+                client_count_ = static_cast<int>(clients_.size());
+            }
+
+            void DTCServer::remove_client(std::shared_ptr<ClientConnection> client)
+            {
+                std::lock_guard<std::mutex> lock(clients_mutex_);
+                clients_.erase(std::remove(clients_.begin(), clients_.end(), client), clients_.end());
+                client_count_ = static_cast<int>(clients_.size());
+            }
+
+            // ========================================================================
+            // MARKET DATA DISTRIBUTION
+            // ========================================================================
+
+            // Wrap an encoded market data update for fan-out; its SymbolID is patched per client
+            static std::shared_ptr<const SharedMessage> make_shared_message(const uint8_t *data, uint16_t size)
+            {
+                if (size < sizeof(MessageHeader) || size > SharedMessage::MAX_SIZE)
+                {
+                    return nullptr;
+                }
+
+                uint16_t type;
+                std::memcpy(&type, data + 2, sizeof(type));
+                size_t offset = symbol_id_offset(static_cast<MessageType>(type));
+                if (offset == 0)
+                {
+                    return nullptr;
+                }
+
+                auto message = std::make_shared<SharedMessage>();
+                message->size = size;
+                message->symbol_id_offset = static_cast<uint16_t>(offset);
+                std::memcpy(message->data, data, size);
+                return message;
+            }
+
+            void DTCServer::on_trade_data(const open_dtc_server::exchanges::base::MarketTrade &trade)
+            {
+                auto subscribers = subscriptions_.subscribers(trade.symbol_id);
+                if (!subscribers)
+                {
+                    return;
+                }
+
+                // Coinbase reports the maker's side: a resting buy was hit at the bid,
+                // a resting sell was lifted at the ask
+                wire::AtBidOrAsk at_bid_or_ask = trade.side == "buy"    ? wire::AtBidOrAsk::AT_BID
+                                                 : trade.side == "sell" ? wire::AtBidOrAsk::AT_ASK
+                                                                        : wire::AtBidOrAsk::BID_ASK_UNSET;
+
+                uint64_t date_time = trade.timestamp;
+                if (config_.trade_time_source == TradeTimeSource::RECEIVE && trade.receive_time != 0)
+                {
+                    date_time = trade.receive_time;
+                }
+                else if (config_.trade_time_source == TradeTimeSource::SEND)
+                {
+                    date_time = open_dtc_server::util::now_micros();
+                }
+
+                // Encoded at most once per encoding (and integer scale), on first use
+                std::shared_ptr<const SharedMessage> encoded[MARKET_DATA_ENCODING_COUNT];
+                IntegerPriceScale encoded_scale;
+                uint8_t buffer[MAX_ENCODED_MARKET_DATA_SIZE];
+
+                for (const Subscriber &subscriber : *subscribers)
+                {
+                    auto &message = encoded[static_cast<size_t>(subscriber.encoding)];
+                    if (!message || (subscriber.encoding == MarketDataEncoding::INTEGER &&
+                                     !(subscriber.integer_scale == encoded_scale)))
+                    {
+                        uint16_t length = encode_trade_update(subscriber.encoding, buffer, sizeof(buffer), 0,
+                                                              trade.price, trade.volume, date_time,
+                                                              at_bid_or_ask, subscriber.integer_scale);
+                        if (length == 0 && subscriber.encoding == MarketDataEncoding::INTEGER)
+                        {
+                            report_integer_scale_overflow(trade.symbol_id, subscriber.integer_scale);
+                        }
+                        message = make_shared_message(buffer, length);
+                        encoded_scale = subscriber.integer_scale;
+                        if (!message)
+                        {
+                            continue;
+                        }
+                    }
+                    send_market_data(subscriber.client, message, subscriber.symbol_id);
+                    total_trade_updates_sent_++;
+                }
+            }
+
+            void DTCServer::on_level2_data(const open_dtc_server::exchanges::base::MarketLevel2 &level2)
+            {
+                if (!level2.is_bid_change && !level2.is_ask_change)
+                {
+                    return;
+                }
+
+                if (config_.level2_conflation_interval_ms > 0)
+                {
+                    level2_conflator_.offer(level2);
+                    return;
+                }
+                publish_level2(level2);
+            }
+
+            void DTCServer::publish_level2(const open_dtc_server::exchanges::base::MarketLevel2 &level2)
+            {
+                auto subscribers = subscriptions_.subscribers(level2.symbol_id);
+                if (!subscribers)
+                {
+                    return;
+                }
+
+                std::shared_ptr<const SharedMessage> encoded[MARKET_DATA_ENCODING_COUNT];
+                IntegerPriceScale encoded_scale;
+                uint8_t buffer[MAX_ENCODED_MARKET_DATA_SIZE];
+
+                for (const Subscriber &subscriber : *subscribers)
+                {
+                    auto &message = encoded[static_cast<size_t>(subscriber.encoding)];
+                    if (!message || (subscriber.encoding == MarketDataEncoding::INTEGER &&
+                                     !(subscriber.integer_scale == encoded_scale)))
+                    {
+                        uint16_t length = encode_bid_ask_update(subscriber.encoding, buffer, sizeof(buffer), 0,
+                                                                level2.bid_price, level2.bid_size,
+                                                                level2.ask_price, level2.ask_size,
+                                                                level2.timestamp, subscriber.integer_scale);
+                        if (length == 0 && subscriber.encoding == MarketDataEncoding::INTEGER)
+                        {
+                            report_integer_scale_overflow(level2.symbol_id, subscriber.integer_scale);
+                        }
+                        message = make_shared_message(buffer, length);
+                        encoded_scale = subscriber.integer_scale;
+                        if (!message)
+                        {
+                            continue;
+                        }
+                    }
+                    send_market_data(subscriber.client, message, subscriber.symbol_id, subscriber.symbol_id);
+                    total_level2_updates_sent_++;
+                }
+            }
+
+            DTCServer::DepthBook &DTCServer::get_depth_book(uint32_t symbol)
+            {
+                std::lock_guard<std::mutex> lock(depth_books_mutex_);
+                auto &depth_book = depth_books_[symbol];
+                if (!depth_book)
+                {
+                    depth_book = std::make_unique<DepthBook>();
+                }
+                return *depth_book;
+            }
+
+            // Snapshot levels are session messages: a client that cannot queue its
+            // snapshot is disconnected rather than left with a partial book
+            void DTCServer::send_depth_snapshot(const std::shared_ptr<ClientConnection> &client, uint32_t symbol_id,
+                                                const DepthBook &depth_book, uint16_t levels)
+            {
+                using open_dtc_server::exchanges::base::BookSide;
+                using open_dtc_server::exchanges::base::PriceLevel;
+
+                const auto &book = depth_book.book;
+                double date_time = open_dtc_server::util::to_dtc_date_time(depth_book.timestamp);
+                size_t bid_count = std::min<size_t>(levels, book.level_count(BookSide::BID));
+                size_t ask_count = std::min<size_t>(levels, book.level_count(BookSide::ASK));
+                uint8_t buffer[sizeof(wire::MarketDepthSnapshotLevel)];
+
+                if (bid_count + ask_count == 0)
+                {
+                    uint16_t length = encode_depth_snapshot_level(buffer, sizeof(buffer), symbol_id, wire::AtBidOrAsk::BID_ASK_UNSET,
+                                                                  0.0, 0.0, 0, true, true, date_time);
+                    send_to_client(client, buffer, length);
+                    return;
+                }
+
+                size_t sent = 0;
+                for (BookSide side : {BookSide::BID, BookSide::ASK})
+                {
+                    size_t count = side == BookSide::BID ? bid_count : ask_count;
+                    wire::AtBidOrAsk at = side == BookSide::BID ? wire::AtBidOrAsk::AT_BID : wire::AtBidOrAsk::AT_ASK;
+                    for (size_t index = 0; index < count; index++)
+                    {
+                        const PriceLevel *level = book.level(side, index);
+                        uint16_t length = encode_depth_snapshot_level(buffer, sizeof(buffer), symbol_id, at,
+                                                                      level->price, level->size, static_cast<uint16_t>(index),
+                                                                      sent == 0, sent + 1 == bid_count + ask_count, date_time);
+                        send_to_client(client, buffer, length);
+                        sent++;
+                    }
+                }
+            }
+
+            // Depth updates cannot be dropped without corrupting the client's book, so
+            // a client that falls behind loses the subscription and must resubscribe
+            bool DTCServer::send_depth_update(const Subscriber &subscriber, uint32_t symbol,
+                                              const std::shared_ptr<const SharedMessage> &message)
+            {
+                if (!message)
+                {
+                    return false;
+                }
+
+                SendStatus status = subscriber.client->send_market_data(message, subscriber.symbol_id);
+                handle_send_status(subscriber.client, status);
+                if (status != SendStatus::DROPPED)
+                {
+                    total_depth_updates_sent_++;
+                    return status != SendStatus::DISCONNECTED;
+                }
+
+                const std::string &symbol_name = open_dtc_server::util::SymbolTable::symbols().name(symbol);
+                {
+                    // Forget the client's ID too, so a later unsubscribe or a resubscribe
+                    // with the same ID starts from a clean session
+                    std::lock_guard<std::mutex> lock(subscriber.client->get_session_mutex());
+                    auto &depth_id_to_symbol = subscriber.client->get_session().depth_id_to_symbol;
+                    auto it = depth_id_to_symbol.find(subscriber.symbol_id);
+                    if (it != depth_id_to_symbol.end() && it->second == symbol_name)
+                    {
+                        depth_id_to_symbol.erase(it);
+                    }
+                    depth_subscriptions_.remove(symbol_name, subscriber.client.get());
+                }
+                send_market_depth_reject(subscriber.client, subscriber.symbol_id, "Market depth updates dropped, resubscribe");
+                return false;
+            }
+
+            void DTCServer::on_depth_data(const open_dtc_server::exchanges::base::MarketDepthUpdate &depth)
+            {
+                using open_dtc_server::exchanges::base::BookSide;
+                using open_dtc_server::exchanges::base::PriceLevel;
+
+                if (depth.symbol_id == open_dtc_server::util::SymbolTable::INVALID_ID)
+                {
+                    return;
+                }
+
+                // The book is kept for every symbol the feeds publish, so a new
+                // subscriber can be sent a snapshot immediately
+                DepthBook &depth_book = get_depth_book(depth.symbol_id);
+                std::lock_guard<std::mutex> lock(depth_book.mutex);
+                auto &book = depth_book.book;
+                depth_book.timestamp = depth.timestamp;
+
+                if (depth.is_snapshot)
+                {
+                    book.begin_snapshot();
+                    for (const auto &change : depth.changes)
+                    {
+                        book.add_snapshot_level(change.side, change.price, change.size);
+                    }
+                    book.end_snapshot();
+
+                    if (auto subscribers = depth_subscriptions_.subscribers(depth.symbol_id))
+                    {
+                        for (const Subscriber &subscriber : *subscribers)
+                        {
+                            send_depth_snapshot(subscriber.client, subscriber.symbol_id, depth_book, subscriber.depth_levels);
+                        }
+                    }
+                    return;
+                }
+
+                double date_time = open_dtc_server::util::to_dtc_date_time(depth.timestamp);
+                uint8_t buffer[MAX_ENCODED_MARKET_DATA_SIZE];
+                auto encode = [&](BookSide side, double price, double size, wire::MarketDepthUpdateType update_type)
+                {
+                    wire::AtBidOrAsk at = side == BookSide::BID ? wire::AtBidOrAsk::AT_BID : wire::AtBidOrAsk::AT_ASK;
+                    return make_shared_message(buffer, encode_depth_update(buffer, sizeof(buffer), 0, at, price, size,
+                                                                           update_type, date_time));
+                };
+
+                for (const auto &change : depth.changes)
+                {
+                    size_t count_before = book.level_count(change.side);
+                    if (!book.apply(change.side, change.price, change.size))
+                    {
+                        continue;
+                    }
+
+                    // Reloaded per change: a client that fell behind may just have been removed
+                    auto subscribers = depth_subscriptions_.subscribers(depth.symbol_id);
+                    if (!subscribers)
+                    {
+                        continue;
+                    }
+
+                    size_t count_after = book.level_count(change.side);
+                    size_t rank = book.rank(change.side, change.price);
+                    bool deleted = count_after < count_before;
+                    bool inserted = count_after > count_before;
+                    auto message = encode(change.side, change.price, change.size,
+                                          deleted ? wire::MarketDepthUpdateType::MARKET_DEPTH_DELETE_LEVEL
+                                                  : wire::MarketDepthUpdateType::MARKET_DEPTH_INSERT_UPDATE_LEVEL);
+                    if (!message)
+                    {
+                        continue;
+                    }
+
+                    for (const Subscriber &subscriber : *subscribers)
+                    {
+                        if (rank >= subscriber.depth_levels || !send_depth_update(subscriber, depth.symbol_id, message))
+                        {
+                            continue;
+                        }
+
+                        // Keep the client's view at its level count: an insert pushes its
+                        // last level out, a delete pulls the next one in
+                        if (inserted)
+                        {
+                            if (const PriceLevel *out = book.level(change.side, subscriber.depth_levels))
+                            {
+                                send_depth_update(subscriber, depth.symbol_id,
+                                                  encode(change.side, out->price, 0.0,
+                                                         wire::MarketDepthUpdateType::MARKET_DEPTH_DELETE_LEVEL));
+                            }
+                        }
+                        else if (deleted)
+                        {
+                            if (const PriceLevel *in = book.level(change.side, subscriber.depth_levels - 1))
+                            {
+                                send_depth_update(subscriber, depth.symbol_id,
+                                                  encode(change.side, in->price, in->size,
+                                                         wire::MarketDepthUpdateType::MARKET_DEPTH_INSERT_UPDATE_LEVEL));
+                            }
+                        }
+                    }
+                }
+            }
+
+            // ========================================================================
+            // CONNECTION HANDLING
+            // ========================================================================
+
+            void DTCServer::accept_connections()
+            {
+#ifdef __linux__
+                // Edge-triggered: accept until the backlog is empty
+                while (true)
+                {
+                    int fd = ::accept4(listen_fd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+                    if (fd < 0)
+                    {
+                        if (errno == EINTR)
+                        {
+                            continue;
+                        }
+                        if (errno != EAGAIN && errno != EWOULDBLOCK)
+                        {
+                            open_dtc_server::util::log("[SERVER] accept failed: " + std::string(std::strerror(errno)));
+                        }
+                        return;
+                    }
+
+                    if (client_count_ >= config_.max_clients)
+                    {
+                        open_dtc_server::util::log("[SERVER] Rejecting connection: max_clients (" +
+                                                   std::to_string(config_.max_clients) + ") reached");
+                        ::close(fd);
+                        continue;
+                    }
+
+                    int no_delay = 1;
+                    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &no_delay, sizeof(no_delay));
+
+                    auto client = std::make_shared<ClientConnection>(fd, next_client_id_++, config_.client_send_queue_bytes,
+                                                                     config_.slow_consumer_policy);
+                    EventLoop *loop = io_loops_[next_loop_++ % io_loops_.size()].get();
+                    client->set_event_loop(loop);
+                    add_client(client);
+
+                    loop->post([this, loop, client]()
+                               {
+                                   bool registered = loop->add(client->get_socket_fd(),
+                                                               EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET,
+                                                               [this, client](uint32_t events)
+                                                               { on_client_event(client, events); });
+                                   if (!registered)
+                                   {
+                                       client->disconnect();
+                                       remove_client(client);
+                                   } });
+                }
+#endif
+            }
+
+            void DTCServer::on_client_event(const std::shared_ptr<ClientConnection> &client, uint32_t events)
+            {
+#ifdef __linux__
+                bool open = client->is_connected() && !(events & EPOLLERR);
+
+                if (open && (events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP)))
+                {
+                    // Frames that arrived before the peer closed (e.g. a LOGOFF) are still processed
+                    open = client->receive_messages([this, &client](const uint8_t *data, uint16_t size)
+                                                    { process_client_message(client, data, size); });
+                }
+
+                if (open && (events & EPOLLOUT))
+                {
+                    open = client->flush_send_queue();
+                    if (open && client->take_drained())
+                    {
+                        request_conflation_flush();
+                    }
+                }
+
+                if (!open || !client->is_connected())
+                {
+                    close_client(client);
+                }
+#else
+                (void)client;
+                (void)events;
+#endif
+            }
+
+            void DTCServer::close_client(const std::shared_ptr<ClientConnection> &client)
+            {
+                if (EventLoop *loop = client->get_event_loop())
+                {
+                    loop->remove(client->get_socket_fd());
+                }
+                client->disconnect();
+                subscriptions_.remove_client(client.get());
+                depth_subscriptions_.remove_client(client.get());
+                remove_client(client);
+            }
+
+            // ========================================================================
+            // CLIENT CONNECTION
+            // ========================================================================
+
+            ClientConnection::ClientConnection(int socket_fd, int client_id, size_t send_queue_bytes, SlowConsumerPolicy policy)
+                : socket_fd_(socket_fd), client_id_(client_id), slow_consumer_policy_(policy), send_queue_(send_queue_bytes)
+            {
+                session_.connect_time = std::chrono::steady_clock::now();
+                session_.last_heartbeat = session_.connect_time;
+            }
+
+            ClientConnection::~ClientConnection()
+            {
+                disconnect();
+                // The descriptor is only released once nothing can reference it, so an
+                // event loop can never see a reused descriptor number for this client
+#ifdef _WIN32
+                closesocket(socket_fd_);
+#else
+                ::close(socket_fd_);
+#endif
+            }
+
+            void ClientConnection::disconnect()
+            {
+                if (!connected_.exchange(false))
+                {
+                    return;
+                }
+#ifdef _WIN32
+                ::shutdown(socket_fd_, SD_BOTH);
+#else
+                ::shutdown(socket_fd_, SHUT_RDWR);
+#endif
+            }
+
+            SendStatus ClientConnection::send_message(const std::vector<uint8_t> &message)
+            {
+                return send_message(message.data(), message.size());
+            }
+
+            SendStatus ClientConnection::send_message(const uint8_t *data, size_t size)
+            {
+                std::lock_guard<std::mutex> lock(send_mutex_);
+                if (!connected_)
+                {
+                    return SendStatus::DISCONNECTED;
+                }
+
+                if (!send_queue_.push(data, size))
+                {
+                    open_dtc_server::util::log("[SERVER] Send queue full, disconnecting " + get_client_info());
+                    disconnect();
+                    return SendStatus::DISCONNECTED;
+                }
+
+                return queued_locked();
+            }
+
+            SendStatus ClientConnection::send_market_data(const uint8_t *data, size_t size, uint32_t conflation_key)
+            {
+                std::lock_guard<std::mutex> lock(send_mutex_);
+                if (!connected_)
+                {
+                    return SendStatus::DISCONNECTED;
+                }
+
+                // A newer update replaces one still waiting for space
+                if (conflation_key != 0 && send_queue_.has_conflated(conflation_key))
+                {
+                    send_queue_.conflate(conflation_key, data, size);
+                    return SendStatus::QUEUED;
+                }
+
+                if (send_queue_.push(data, size))
+                {
+                    return queued_locked();
+                }
+                return apply_slow_consumer_policy_locked(data, size, conflation_key);
+            }
+
+            SendStatus ClientConnection::send_market_data(const std::shared_ptr<const SharedMessage> &message, uint32_t symbol_id,
+                                                          uint32_t conflation_key)
+            {
+                std::lock_guard<std::mutex> lock(send_mutex_);
+                if (!connected_)
+                {
+                    return SendStatus::DISCONNECTED;
+                }
+
+                bool conflating = conflation_key != 0 && send_queue_.has_conflated(conflation_key);
+                if (!conflating && send_queue_.push_shared(message, symbol_id))
+                {
+                    return queued_locked();
+                }
+
+                // Slow path: materialize this client's copy of the message
+                uint8_t data[SharedMessage::MAX_SIZE];
+                std::memcpy(data, message->data, message->size);
+                std::memcpy(data + message->symbol_id_offset, &symbol_id, sizeof(symbol_id));
+                if (conflating)
+                {
+                    send_queue_.conflate(conflation_key, data, message->size);
+                    return SendStatus::QUEUED;
+                }
+                return apply_slow_consumer_policy_locked(data, message->size, conflation_key);
+            }
+
+            SendStatus ClientConnection::queued_locked()
+            {
+                if (flush_scheduled_)
+                {
+                    return SendStatus::QUEUED;
+                }
+                flush_scheduled_ = true;
+                return SendStatus::NEEDS_FLUSH;
+            }
+
+            SendStatus ClientConnection::apply_slow_consumer_policy_locked(const uint8_t *data, size_t size, uint32_t conflation_key)
+            {
+                backlogged_ = true;
+                switch (slow_consumer_policy_)
+                {
+                case SlowConsumerPolicy::CONFLATE:
+                    if (conflation_key != 0 && send_queue_.conflate(conflation_key, data, size))
+                    {
+                        return SendStatus::QUEUED;
+                    }
+                    break;
+                case SlowConsumerPolicy::DROP:
+                    break;
+                case SlowConsumerPolicy::DISCONNECT:
+                    open_dtc_server::util::log("[SERVER] Slow consumer, disconnecting " + get_client_info());
+                    disconnect();
+                    return SendStatus::DISCONNECTED;
+                }
+
+                num_drops_++;
+                return SendStatus::DROPPED;
+            }
+
+            bool ClientConnection::flush_send_queue()
+            {
+                std::lock_guard<std::mutex> lock(send_mutex_);
+#ifndef _WIN32
+                iovec iov[MAX_FLUSH_IOVECS];
+                size_t count;
+                while ((count = send_queue_.peek(iov, MAX_FLUSH_IOVECS)) > 0)
+                {
+                    msghdr message{};
+                    message.msg_iov = iov;
+                    message.msg_iovlen = count;
+                    auto result = ::sendmsg(socket_fd_, &message, MSG_NOSIGNAL);
+                    if (result < 0)
+                    {
+                        if (errno == EINTR)
+                        {
+                            continue;
+                        }
+                        if (errno == EAGAIN || errno == EWOULDBLOCK)
+                        {
+                            // Still scheduled: EPOLLOUT will resume the flush
+                            return true;
+                        }
+                        return false;
+                    }
+                    send_queue_.consume(static_cast<size_t>(result));
+                }
+#endif
+                flush_scheduled_ = false;
+                if (backlogged_)
+                {
+                    backlogged_ = false;
+                    drained_ = true;
+                }
+                return true;
+            }
+
+            bool ClientConnection::receive_messages(const std::function<void(const uint8_t *data, uint16_t size)> &handler)
+            {
+                while (true)
+                {
+                    uint8_t *position = receive_buffer_.write_position();
+                    auto result = ::recv(socket_fd_, reinterpret_cast<char *>(position),
+                                         static_cast<int>(receive_buffer_.writable()), 0);
+                    if (result == 0)
+                    {
+                        return false;
+                    }
+                    if (result < 0)
+                    {
+                        if (errno == EINTR)
+                        {
+                            continue;
+                        }
+                        return errno == EAGAIN || errno == EWOULDBLOCK;
+                    }
+
+                    receive_buffer_.commit(static_cast<size_t>(result));
+
+                    const uint8_t *data;
+                    uint16_t size;
+                    FrameReassembler::Status status;
+                    while ((status = receive_buffer_.next_frame(data, size)) == FrameReassembler::Status::FRAME)
+                    {
+                        handler(data, size);
+                    }
+                    if (status == FrameReassembler::Status::INVALID)
+                    {
+                        open_dtc_server::util::log("[SERVER] Invalid message header from " + get_client_info());
+                        return false;
+                    }
+                }
+            }
+
+            std::string ClientConnection::get_client_info() const
+            {
+                std::string info = "client #" + std::to_string(client_id_);
+                if (!session_.client_info.empty())
+                {
+                    info += " (" + session_.client_info + ")";
+                }
+                return info;
             }
 
         } // namespace server
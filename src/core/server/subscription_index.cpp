@@ -0,0 +1,169 @@
+#include "coinbase_dtc_core/core/server/subscription_index.hpp"
+#include "coinbase_dtc_core/core/util/symbol_table.hpp"
+#include <algorithm>
+
+using open_dtc_server::util::SymbolTable;
+
+namespace coinbase_dtc_core
+{
+    namespace core
+    {
+        namespace server
+        {
+
+            SubscriptionIndex::SubscriptionIndex()
+                : snapshot_(std::make_shared<Snapshot>())
+            {
+            }
+
+            std::shared_ptr<const SubscriptionIndex::Snapshot> SubscriptionIndex::load() const
+            {
+                return std::atomic_load(&snapshot_);
+            }
+
+            void SubscriptionIndex::publish(std::shared_ptr<const Snapshot> snapshot)
+            {
+                std::atomic_store(&snapshot_, std::move(snapshot));
+            }
+
+            std::shared_ptr<SubscriptionIndex::Snapshot> SubscriptionIndex::with_list(
+                const Snapshot &current, uint32_t symbol, std::shared_ptr<const SubscriberList> list) const
+            {
+                auto next = std::make_shared<Snapshot>(current);
+                if (next->size() <= symbol)
+                {
+                    next->resize(symbol + 1);
+                }
+                (*next)[symbol] = std::move(list);
+                return next;
+            }
+
+            std::shared_ptr<SubscriberList> SubscriptionIndex::without(const SubscriberList &list, const ClientConnection *client)
+            {
+                if (std::none_of(list.begin(), list.end(), [&](const Subscriber &subscriber)
+                                 { return subscriber.client.get() == client; }))
+                {
+                    return nullptr;
+                }
+
+                auto result = std::make_shared<SubscriberList>();
+                result->reserve(list.size() - 1);
+                for (const auto &subscriber : list)
+                {
+                    if (subscriber.client.get() != client)
+                    {
+                        result->push_back(subscriber);
+                    }
+                }
+                return result;
+            }
+
+            bool SubscriptionIndex::add(const std::string &symbol, const std::shared_ptr<ClientConnection> &client,
+                                        uint32_t symbol_id, open_dtc_server::core::dtc::MarketDataEncoding encoding,
+                                        uint16_t depth_levels,
+                                        const open_dtc_server::core::dtc::IntegerPriceScale &integer_scale)
+            {
+                uint32_t key = SymbolTable::symbols().find(symbol);
+                if (key == SymbolTable::INVALID_ID)
+                {
+                    return false;
+                }
+
+                std::lock_guard<std::mutex> lock(write_mutex_);
+                auto current = load();
+                const auto *old_list = key < current->size() ? (*current)[key].get() : nullptr;
+
+                auto list = old_list ? std::make_shared<SubscriberList>(*old_list) : std::make_shared<SubscriberList>();
+                auto existing = std::find_if(list->begin(), list->end(), [&](const Subscriber &subscriber)
+                                             { return subscriber.client == client; });
+                if (existing != list->end())
+                {
+                    existing->symbol_id = symbol_id;
+                    existing->encoding = encoding;
+                    existing->depth_levels = depth_levels;
+                    existing->integer_scale = integer_scale;
+                }
+                else
+                {
+                    list->push_back(Subscriber{client, symbol_id, encoding, depth_levels, integer_scale});
+                }
+
+                publish(with_list(*current, key, std::move(list)));
+                return old_list == nullptr;
+            }
+
+            void SubscriptionIndex::remove(const std::string &symbol, const ClientConnection *client)
+            {
+                uint32_t key = SymbolTable::symbols().find(symbol);
+
+                std::lock_guard<std::mutex> lock(write_mutex_);
+                auto current = load();
+                if (key >= current->size() || !(*current)[key])
+                {
+                    return;
+                }
+
+                auto list = without(*(*current)[key], client);
+                if (list)
+                {
+                    publish(with_list(*current, key, list->empty() ? nullptr : std::move(list)));
+                }
+            }
+
+            void SubscriptionIndex::remove_client(const ClientConnection *client)
+            {
+                std::lock_guard<std::mutex> lock(write_mutex_);
+                auto current = load();
+
+                std::shared_ptr<Snapshot> next;
+                for (size_t key = 0; key < current->size(); key++)
+                {
+                    const auto &old_list = (*current)[key];
+                    auto list = old_list ? without(*old_list, client) : nullptr;
+                    if (!list)
+                    {
+                        continue;
+                    }
+
+                    if (!next)
+                    {
+                        next = std::make_shared<Snapshot>(*current);
+                    }
+                    (*next)[key] = list->empty() ? nullptr : std::move(list);
+                }
+
+                if (next)
+                {
+                    publish(std::move(next));
+                }
+            }
+
+            void SubscriptionIndex::clear()
+            {
+                std::lock_guard<std::mutex> lock(write_mutex_);
+                publish(std::make_shared<Snapshot>());
+            }
+
+            std::shared_ptr<const SubscriberList> SubscriptionIndex::subscribers(uint32_t symbol) const
+            {
+                auto snapshot = load();
+                return symbol < snapshot->size() ? (*snapshot)[symbol] : nullptr;
+            }
+
+            std::vector<std::string> SubscriptionIndex::symbols() const
+            {
+                auto snapshot = load();
+                std::vector<std::string> result;
+                for (size_t key = 0; key < snapshot->size(); key++)
+                {
+                    if ((*snapshot)[key])
+                    {
+                        result.push_back(SymbolTable::symbols().name(static_cast<uint32_t>(key)));
+                    }
+                }
+                return result;
+            }
+
+        } // namespace server
+    } // namespace core
+} // namespace coinbase_dtc_core
@@ -0,0 +1,213 @@
+#include "coinbase_dtc_core/core/util/decimal.hpp"
+#include <charconv>
+#include <cstring>
+#include <limits>
+
+// Eight-digit SWAR conversion reads digits as a little-endian word
+#if defined(_MSC_VER) || (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define DECIMAL_SWAR 1
+#endif
+
+namespace open_dtc_server
+{
+    namespace util
+    {
+
+        namespace
+        {
+            constexpr int MAX_SIGNIFICANT_DIGITS = 19; // always fits in uint64
+            constexpr uint64_t MAX_EXACT_MANTISSA = uint64_t(1) << 53;
+
+            constexpr double POW10_DOUBLE[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                               1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+            constexpr int MAX_EXACT_POW10 = 22;
+
+            constexpr uint64_t POW10_INT[] = {1ULL,
+                                              10ULL,
+                                              100ULL,
+                                              1000ULL,
+                                              10000ULL,
+                                              100000ULL,
+                                              1000000ULL,
+                                              10000000ULL,
+                                              100000000ULL,
+                                              1000000000ULL,
+                                              10000000000ULL,
+                                              100000000000ULL,
+                                              1000000000000ULL,
+                                              10000000000000ULL,
+                                              100000000000000ULL,
+                                              1000000000000000ULL,
+                                              10000000000000000ULL,
+                                              100000000000000000ULL,
+                                              1000000000000000000ULL};
+
+            struct Decimal
+            {
+                uint64_t mantissa = 0;
+                int significant_digits = 0;
+                int fraction_digits = 0;
+                int dropped_digits = 0;
+                bool negative = false;
+                bool overflow = false; // more than MAX_SIGNIFICANT_DIGITS digits
+            };
+
+            inline bool is_digit(char c)
+            {
+                return static_cast<unsigned char>(c - '0') < 10;
+            }
+
+#ifdef DECIMAL_SWAR
+            inline bool is_eight_digits(uint64_t chunk)
+            {
+                return ((chunk & 0xF0F0F0F0F0F0F0F0ULL) |
+                        (((chunk + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) == 0x3333333333333333ULL;
+            }
+
+            inline uint64_t eight_digits_value(uint64_t chunk)
+            {
+                chunk -= 0x3030303030303030ULL;
+                chunk = (chunk * 10) + (chunk >> 8);
+                return (((chunk & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) +
+                        (((chunk >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >>
+                       32;
+            }
+#endif
+
+            // Accumulate a run of digits into d. Leading zeros are skipped while the
+            // mantissa is still zero. Returns the first non-digit; count receives
+            // the number of digits consumed.
+            const char *accumulate_digits(const char *p, const char *end, Decimal &d, int &count)
+            {
+                const char *start = p;
+                if (d.mantissa == 0)
+                {
+                    while (p < end && *p == '0')
+                    {
+                        p++;
+                    }
+                }
+
+#ifdef DECIMAL_SWAR
+                while (end - p >= 8 && d.significant_digits + 8 <= MAX_SIGNIFICANT_DIGITS)
+                {
+                    uint64_t chunk;
+                    std::memcpy(&chunk, p, sizeof(chunk));
+                    if (!is_eight_digits(chunk))
+                    {
+                        break;
+                    }
+                    d.mantissa = d.mantissa * 100000000ULL + eight_digits_value(chunk);
+                    d.significant_digits += 8;
+                    p += 8;
+                }
+#endif
+
+                while (p < end && is_digit(*p))
+                {
+                    if (d.significant_digits < MAX_SIGNIFICANT_DIGITS)
+                    {
+                        d.mantissa = d.mantissa * 10 + static_cast<uint64_t>(*p - '0');
+                        d.significant_digits++;
+                    }
+                    else
+                    {
+                        d.dropped_digits++;
+                        d.overflow = true;
+                    }
+                    p++;
+                }
+
+                count = static_cast<int>(p - start);
+                return p;
+            }
+
+            // [-]digits[.digits], at least one digit, nothing after
+            bool scan_decimal(std::string_view text, Decimal &d)
+            {
+                const char *p = text.data();
+                const char *end = p + text.size();
+                if (p < end && *p == '-')
+                {
+                    d.negative = true;
+                    p++;
+                }
+
+                int integer_digits = 0;
+                p = accumulate_digits(p, end, d, integer_digits);
+                if (d.overflow)
+                {
+                    return false; // integer digits cannot be dropped without rescaling
+                }
+
+                int fraction_digits = 0;
+                if (p < end && *p == '.')
+                {
+                    p = accumulate_digits(p + 1, end, d, fraction_digits);
+                    // Digits beyond the mantissa's capacity are dropped, not scaled
+                    d.fraction_digits = fraction_digits - d.dropped_digits;
+                }
+
+                return p == end && integer_digits + fraction_digits > 0;
+            }
+        } // namespace
+
+        bool parse_decimal(std::string_view text, double &value)
+        {
+            Decimal d;
+            if (scan_decimal(text, d) && !d.overflow && d.mantissa <= MAX_EXACT_MANTISSA &&
+                d.fraction_digits <= MAX_EXACT_POW10)
+            {
+                // Both operands are exact doubles, so one IEEE division rounds correctly
+                double result = static_cast<double>(d.mantissa) / POW10_DOUBLE[d.fraction_digits];
+                value = d.negative ? -result : result;
+                return true;
+            }
+
+            // Long mantissas, exponents and anything unusual
+            const char *end = text.data() + text.size();
+            double parsed = 0.0;
+            auto result = std::from_chars(text.data(), end, parsed);
+            if (result.ec != std::errc() || result.ptr != end)
+            {
+                return false;
+            }
+            value = parsed;
+            return true;
+        }
+
+        bool parse_fixed_point(std::string_view text, int scale, int64_t &value)
+        {
+            if (scale < 0 || scale > 18)
+            {
+                return false;
+            }
+
+            // Trailing fraction zeros never change the value
+            if (text.find('.') != std::string_view::npos)
+            {
+                while (text.size() > 1 && text.back() == '0')
+                {
+                    text.remove_suffix(1);
+                }
+            }
+
+            Decimal d;
+            if (!scan_decimal(text, d) || d.overflow || d.fraction_digits > scale)
+            {
+                return false;
+            }
+
+            uint64_t multiplier = POW10_INT[scale - d.fraction_digits];
+            if (d.mantissa > static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) / multiplier)
+            {
+                return false;
+            }
+
+            int64_t result = static_cast<int64_t>(d.mantissa * multiplier);
+            value = d.negative ? -result : result;
+            return true;
+        }
+
+    } // namespace util
+} // namespace open_dtc_server
@@ -0,0 +1,68 @@
+#include "coinbase_dtc_core/core/util/symbol_table.hpp"
+#include <mutex>
+
+namespace open_dtc_server
+{
+    namespace util
+    {
+
+        SymbolTable &SymbolTable::symbols()
+        {
+            static SymbolTable table;
+            return table;
+        }
+
+        SymbolTable &SymbolTable::exchanges()
+        {
+            static SymbolTable table;
+            return table;
+        }
+
+        uint32_t SymbolTable::intern(std::string_view name)
+        {
+            if (name.empty())
+            {
+                return INVALID_ID;
+            }
+
+            uint32_t id = find(name);
+            if (id != INVALID_ID)
+            {
+                return id;
+            }
+
+            std::unique_lock<std::shared_mutex> lock(mutex_);
+            auto it = ids_.find(name);
+            if (it != ids_.end())
+            {
+                return it->second;
+            }
+
+            names_.emplace_back(name);
+            id = static_cast<uint32_t>(names_.size());
+            ids_.emplace(names_.back(), id);
+            return id;
+        }
+
+        uint32_t SymbolTable::find(std::string_view name) const
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            auto it = ids_.find(name);
+            return it != ids_.end() ? it->second : INVALID_ID;
+        }
+
+        const std::string &SymbolTable::name(uint32_t id) const
+        {
+            static const std::string empty;
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            return id != INVALID_ID && id <= names_.size() ? names_[id - 1] : empty;
+        }
+
+        size_t SymbolTable::size() const
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            return names_.size();
+        }
+
+    } // namespace util
+} // namespace open_dtc_server
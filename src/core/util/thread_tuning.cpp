@@ -0,0 +1,170 @@
+#include "coinbase_dtc_core/core/util/thread_tuning.hpp"
+#include "coinbase_dtc_core/core/util/log.hpp"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <time.h>
+#endif
+
+namespace open_dtc_server
+{
+    namespace util
+    {
+
+        struct ThreadRegistry::Entry
+        {
+            std::string name;
+            int cpu = -1;
+            std::chrono::steady_clock::time_point started;
+            uint64_t cpu_time_at_start_us = 0;
+#ifdef _WIN32
+            HANDLE thread = nullptr;
+#else
+            clockid_t clock{};
+            bool has_clock = false;
+#endif
+        };
+
+        namespace
+        {
+            // CPU time used so far by the entry's thread; callable from any thread
+            uint64_t thread_cpu_time_us(const ThreadRegistry::Entry &entry)
+            {
+#ifdef _WIN32
+                FILETIME creation, exit, kernel, user;
+                if (!entry.thread || !GetThreadTimes(entry.thread, &creation, &exit, &kernel, &user))
+                {
+                    return 0;
+                }
+                // FILETIME counts 100 ns intervals
+                uint64_t k = (static_cast<uint64_t>(kernel.dwHighDateTime) << 32) | kernel.dwLowDateTime;
+                uint64_t u = (static_cast<uint64_t>(user.dwHighDateTime) << 32) | user.dwLowDateTime;
+                return (k + u) / 10;
+#else
+                timespec ts{};
+                if (!entry.has_clock || clock_gettime(entry.clock, &ts) != 0)
+                {
+                    return 0;
+                }
+                return static_cast<uint64_t>(ts.tv_sec) * 1000000 + static_cast<uint64_t>(ts.tv_nsec) / 1000;
+#endif
+            }
+        }
+
+        bool pin_current_thread(int cpu)
+        {
+            unsigned int cpus = std::thread::hardware_concurrency();
+            if (cpu < 0 || (cpus != 0 && static_cast<unsigned int>(cpu) >= cpus))
+            {
+                return false;
+            }
+#if defined(__linux__)
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cpu, &set);
+            return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#elif defined(_WIN32)
+            if (cpu >= static_cast<int>(sizeof(DWORD_PTR) * 8))
+            {
+                return false;
+            }
+            return SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << cpu) != 0;
+#else
+            return false;
+#endif
+        }
+
+        ThreadRegistry &ThreadRegistry::instance()
+        {
+            static ThreadRegistry registry;
+            return registry;
+        }
+
+        void ThreadRegistry::add(Entry *entry)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            entries_.push_back(entry);
+        }
+
+        void ThreadRegistry::remove(Entry *entry)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            entries_.erase(std::remove(entries_.begin(), entries_.end(), entry), entries_.end());
+        }
+
+        std::vector<ThreadCpuUsage> ThreadRegistry::snapshot() const
+        {
+            auto now = std::chrono::steady_clock::now();
+            std::vector<ThreadCpuUsage> usage;
+
+            // Entries are removed under the same lock before their thread exits,
+            // so the clocks read here always belong to live threads
+            std::lock_guard<std::mutex> lock(mutex_);
+            usage.reserve(entries_.size());
+            for (const Entry *entry : entries_)
+            {
+                ThreadCpuUsage item;
+                item.name = entry->name;
+                item.cpu = entry->cpu;
+                uint64_t cpu_time = thread_cpu_time_us(*entry);
+                item.cpu_time_us = cpu_time > entry->cpu_time_at_start_us ? cpu_time - entry->cpu_time_at_start_us : 0;
+                item.wall_time_us = static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::microseconds>(now - entry->started).count());
+                usage.push_back(item);
+            }
+            return usage;
+        }
+
+        ScopedThreadRegistration::ScopedThreadRegistration(const std::string &name, int cpu)
+            : entry_(std::make_unique<ThreadRegistry::Entry>())
+        {
+            entry_->name = name;
+
+#if defined(__linux__)
+            // The kernel limits thread names to 15 characters
+            pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());
+#endif
+
+            if (cpu >= 0)
+            {
+                pinned_ = pin_current_thread(cpu);
+                if (pinned_)
+                {
+                    entry_->cpu = cpu;
+                }
+                else
+                {
+                    log("[WARNING] Could not pin thread " + name + " to CPU " + std::to_string(cpu));
+                }
+            }
+
+#ifdef _WIN32
+            DuplicateHandle(GetCurrentProcess(), GetCurrentThread(), GetCurrentProcess(), &entry_->thread,
+                            THREAD_QUERY_LIMITED_INFORMATION, FALSE, 0);
+#else
+            entry_->has_clock = pthread_getcpuclockid(pthread_self(), &entry_->clock) == 0;
+#endif
+            entry_->started = std::chrono::steady_clock::now();
+            entry_->cpu_time_at_start_us = thread_cpu_time_us(*entry_);
+
+            ThreadRegistry::instance().add(entry_.get());
+        }
+
+        ScopedThreadRegistration::~ScopedThreadRegistration()
+        {
+            ThreadRegistry::instance().remove(entry_.get());
+#ifdef _WIN32
+            if (entry_->thread)
+            {
+                CloseHandle(entry_->thread);
+            }
+#endif
+        }
+
+    } // namespace util
+} // namespace open_dtc_server
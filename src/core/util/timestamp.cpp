@@ -0,0 +1,144 @@
+#include "coinbase_dtc_core/core/util/timestamp.hpp"
+#include <chrono>
+
+namespace open_dtc_server
+{
+    namespace util
+    {
+
+        namespace
+        {
+            constexpr int64_t MICROS_PER_SECOND = 1000000;
+
+            // Read count digits at p; false if any is not a digit
+            inline bool read_digits(const char *p, int count, int &value)
+            {
+                value = 0;
+                for (int i = 0; i < count; i++)
+                {
+                    unsigned digit = static_cast<unsigned char>(p[i] - '0');
+                    if (digit > 9)
+                    {
+                        return false;
+                    }
+                    value = value * 10 + static_cast<int>(digit);
+                }
+                return true;
+            }
+
+            inline bool is_leap_year(int year)
+            {
+                return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+            }
+
+            inline int days_in_month(int year, int month)
+            {
+                static const int DAYS[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+                return month == 2 && is_leap_year(year) ? 29 : DAYS[month - 1];
+            }
+
+            // Days from 1970-01-01 to a proleptic Gregorian date (H. Hinnant's days_from_civil)
+            inline int64_t days_from_civil(int year, int month, int day)
+            {
+                year -= month <= 2;
+                const int64_t era = year / 400;
+                const int64_t year_of_era = year - era * 400;
+                const int64_t day_of_year = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+                const int64_t day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+                return era * 146097 + day_of_era - 719468;
+            }
+        } // namespace
+
+        uint64_t now_micros()
+        {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                                             std::chrono::system_clock::now().time_since_epoch())
+                                             .count());
+        }
+
+        bool parse_iso8601_micros(std::string_view text, uint64_t &micros)
+        {
+            // YYYY-MM-DDTHH:MM:SS
+            const char *p = text.data();
+            const char *end = p + text.size();
+            if (text.size() < 20 || p[4] != '-' || p[7] != '-' || p[10] != 'T' || p[13] != ':' || p[16] != ':')
+            {
+                return false;
+            }
+
+            int year, month, day, hour, minute, second;
+            if (!read_digits(p, 4, year) || !read_digits(p + 5, 2, month) || !read_digits(p + 8, 2, day) ||
+                !read_digits(p + 11, 2, hour) || !read_digits(p + 14, 2, minute) || !read_digits(p + 17, 2, second))
+            {
+                return false;
+            }
+            if (year < 1970 || month < 1 || month > 12 || day < 1 || day > days_in_month(year, month) ||
+                hour > 23 || minute > 59 || second > 60)
+            {
+                return false;
+            }
+            p += 19;
+
+            // Fraction, scaled to microseconds
+            int64_t fraction = 0;
+            if (*p == '.')
+            {
+                p++;
+                int digits = 0;
+                while (p < end && static_cast<unsigned char>(*p - '0') <= 9)
+                {
+                    if (digits < 6)
+                    {
+                        fraction = fraction * 10 + (*p - '0');
+                    }
+                    digits++;
+                    p++;
+                }
+                if (digits == 0 || digits > 9)
+                {
+                    return false;
+                }
+                for (; digits < 6; digits++)
+                {
+                    fraction *= 10;
+                }
+            }
+
+            // Zone
+            int64_t offset_seconds = 0;
+            if (p < end && *p == 'Z')
+            {
+                p++;
+            }
+            else if (end - p == 6 && (*p == '+' || *p == '-') && p[3] == ':')
+            {
+                int offset_hours, offset_minutes;
+                if (!read_digits(p + 1, 2, offset_hours) || !read_digits(p + 4, 2, offset_minutes) ||
+                    offset_hours > 23 || offset_minutes > 59)
+                {
+                    return false;
+                }
+                offset_seconds = (offset_hours * 3600 + offset_minutes * 60) * (*p == '+' ? 1 : -1);
+                p += 6;
+            }
+            else
+            {
+                return false;
+            }
+            if (p != end)
+            {
+                return false;
+            }
+
+            int64_t seconds = days_from_civil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second -
+                              offset_seconds;
+            if (seconds < 0)
+            {
+                return false;
+            }
+            micros = static_cast<uint64_t>(seconds * MICROS_PER_SECOND + fraction);
+            return true;
+        }
+
+    } // namespace util
+} // namespace open_dtc_server
@@ -54,6 +54,9 @@ namespace open_dtc_server
                     feed->set_level2_callback([this](const MarketLevel2 &level2)
                                               { this->on_level2_data(level2); });
 
+                    feed->set_depth_callback([this](const MarketDepthUpdate &depth)
+                                             { this->on_depth_data(depth); });
+
                     exchanges_[config.name] = std::move(feed);
 
                     util::log("[MULTI] Added exchange: " + config.name);
@@ -224,6 +227,14 @@ namespace open_dtc_server
                 }
             }
 
+            void MultiExchangeFeed::on_depth_data(const MarketDepthUpdate &depth)
+            {
+                if (depth_callback_)
+                {
+                    depth_callback_(depth);
+                }
+            }
+
         } // namespace base
     } // namespace exchanges
 } // namespace open_dtc_server
\ No newline at end of file
@@ -0,0 +1,119 @@
+#include "coinbase_dtc_core/exchanges/base/order_book.hpp"
+#include <algorithm>
+
+namespace open_dtc_server
+{
+    namespace exchanges
+    {
+        namespace base
+        {
+
+            // True if a is further from the top of the book than b
+            static inline bool worse(BookSide side, double a, double b)
+            {
+                return side == BookSide::BID ? a < b : a > b;
+            }
+
+            void OrderBook::clear()
+            {
+                bids_.clear();
+                asks_.clear();
+            }
+
+            void OrderBook::begin_snapshot()
+            {
+                clear();
+            }
+
+            void OrderBook::add_snapshot_level(BookSide side, double price, double size)
+            {
+                if (size > 0.0)
+                {
+                    side_levels(side).push_back(PriceLevel{price, size});
+                }
+            }
+
+            void OrderBook::end_snapshot()
+            {
+                for (BookSide side : {BookSide::BID, BookSide::ASK})
+                {
+                    auto &levels = side_levels(side);
+                    // Stable, so repeated prices stay in arrival order for the step below
+                    std::stable_sort(levels.begin(), levels.end(), [side](const PriceLevel &a, const PriceLevel &b)
+                                     { return worse(side, a.price, b.price); });
+
+                    // A snapshot should not repeat a price, but keep the last one if it does
+                    auto last = std::unique(levels.rbegin(), levels.rend(), [](const PriceLevel &a, const PriceLevel &b)
+                                            { return a.price == b.price; });
+                    levels.erase(levels.begin(), last.base());
+                }
+            }
+
+            bool OrderBook::apply(BookSide side, double price, double size)
+            {
+                auto &levels = side_levels(side);
+
+                // A price better than the current best is a new top level and needs no search
+                auto it = !levels.empty() && worse(side, levels.back().price, price)
+                              ? levels.end()
+                              : std::lower_bound(levels.begin(), levels.end(), price,
+                                                 [side](const PriceLevel &level, double value)
+                                                 { return worse(side, level.price, value); });
+
+                bool exists = it != levels.end() && it->price == price;
+                if (size <= 0.0)
+                {
+                    if (!exists)
+                    {
+                        return false;
+                    }
+                    levels.erase(it);
+                    return true;
+                }
+
+                if (exists)
+                {
+                    if (it->size == size)
+                    {
+                        return false;
+                    }
+                    it->size = size;
+                    return true;
+                }
+
+                levels.insert(it, PriceLevel{price, size});
+                return true;
+            }
+
+            bool OrderBook::update_top_of_book(bool &bid_changed, bool &ask_changed)
+            {
+                PriceLevel bid = bids_.empty() ? PriceLevel{0.0, 0.0} : bids_.back();
+                PriceLevel ask = asks_.empty() ? PriceLevel{0.0, 0.0} : asks_.back();
+                bid_changed = bid.price != published_bid_.price || bid.size != published_bid_.size;
+                ask_changed = ask.price != published_ask_.price || ask.size != published_ask_.size;
+                published_bid_ = bid;
+                published_ask_ = ask;
+                return bid_changed || ask_changed;
+            }
+
+            size_t OrderBook::rank(BookSide side, double price) const
+            {
+                const auto &levels = side_levels(side);
+                auto it = std::lower_bound(levels.begin(), levels.end(), price,
+                                           [side](const PriceLevel &level, double value)
+                                           { return worse(side, level.price, value); });
+                size_t not_worse = static_cast<size_t>(levels.end() - it);
+                return it != levels.end() && it->price == price ? not_worse - 1 : not_worse;
+            }
+
+            size_t OrderBook::depth(BookSide side, PriceLevel *out, size_t max_levels) const
+            {
+                const auto &levels = side_levels(side);
+                size_t count = std::min(max_levels, levels.size());
+                std::copy(levels.rbegin(), levels.rbegin() + count, out);
+                return count;
+            }
+
+        } // namespace base
+    } // namespace exchanges
+} // namespace open_dtc_server
@@ -1,6 +1,7 @@
 #include "coinbase_dtc_core/exchanges/coinbase/coinbase_feed.hpp"
 #include "coinbase_dtc_core/exchanges/coinbase/websocket_client.hpp" // Re-enabled
 #include "coinbase_dtc_core/core/util/log.hpp"
+#include "coinbase_dtc_core/core/util/symbol_table.hpp"
 #include <chrono>
 #include <sstream>
 #include <iomanip>
@@ -39,6 +40,8 @@ namespace open_dtc_server
 
                     // Use real WebSocket connection with our WebSocketClient
                     websocket_client_ = std::make_unique<feed::coinbase::WebSocketClient>();
+                    websocket_client_->set_ingress_tuning(config_.ingress_cpu, config_.busy_poll, config_.socket_busy_poll_us);
+                    websocket_client_->set_book_cpu(config_.book_cpu);
 
                     // Set up callbacks
                     websocket_client_->set_trade_callback([this](const exchanges::base::MarketTrade &trade)
@@ -47,6 +50,9 @@ namespace open_dtc_server
                     websocket_client_->set_level2_callback([this](const exchanges::base::MarketLevel2 &level2)
                                                            { this->on_level2_received(level2); });
 
+                    websocket_client_->set_depth_callback([this](const exchanges::base::MarketDepthUpdate &depth)
+                                                          { this->on_depth_received(depth); });
+
                     // Connect to WebSocket
                     bool ws_connected = websocket_client_->connect("ws-feed.exchange.coinbase.com", 443);
                     if (!ws_connected)
@@ -150,34 +156,63 @@ namespace open_dtc_server
 
             bool CoinbaseFeed::unsubscribe(const std::string &symbol)
             {
-                std::lock_guard<std::mutex> lock(subscriptions_mutex_);
-
-                auto it = subscriptions_.find(symbol);
-                if (it != subscriptions_.end())
+                std::string coinbase_symbol;
                 {
-                    std::string coinbase_symbol = it->second.product_id;
-                    subscriptions_.erase(it);
+                    std::lock_guard<std::mutex> lock(subscriptions_mutex_);
 
-                    util::log("[COINBASE] Unsubscribed from " + symbol + " (Coinbase: " + coinbase_symbol + ")");
+                    auto it = subscriptions_.find(symbol);
+                    auto level2 = subscriptions_.find(symbol + "_level2");
+                    if (it == subscriptions_.end() && level2 == subscriptions_.end())
+                    {
+                        return false;
+                    }
 
-                    // TODO: Send actual unsubscribe message to Coinbase WebSocket
-                    return true;
+                    coinbase_symbol = (it != subscriptions_.end() ? it : level2)->second.product_id;
+                    subscriptions_.erase(symbol);
+                    subscriptions_.erase(symbol + "_level2");
                 }
 
-                return false;
+                util::log("[COINBASE] Unsubscribed from " + symbol + " (Coinbase: " + coinbase_symbol + ")");
+
+                if (websocket_client_)
+                {
+                    return websocket_client_->unsubscribe(coinbase_symbol);
+                }
+                return true;
             }
 
             bool CoinbaseFeed::subscribe_multiple_symbols(const std::vector<std::string> &symbols)
             {
-                bool all_success = true;
-                for (const auto &symbol : symbols)
+                if (!is_connected())
                 {
-                    if (!subscribe_trades(symbol) || !subscribe_level2(symbol))
+                    util::log("[COINBASE] Cannot subscribe - not connected");
+                    return false;
+                }
+
+                // Record every product first, then send one batched request for
+                // both channels instead of two frames per product
+                std::vector<std::string> coinbase_symbols;
+                coinbase_symbols.reserve(symbols.size());
+                {
+                    std::lock_guard<std::mutex> lock(subscriptions_mutex_);
+                    for (const auto &symbol : symbols)
                     {
-                        all_success = false;
+                        std::string coinbase_symbol = exchange_symbol(symbol);
+                        subscriptions_[symbol] = SubscriptionInfo(SubscriptionType::TRADES, coinbase_symbol);
+                        subscriptions_[symbol].active = true;
+                        subscriptions_[symbol + "_level2"] = SubscriptionInfo(SubscriptionType::LEVEL2, coinbase_symbol);
+                        subscriptions_[symbol + "_level2"].active = true;
+                        coinbase_symbols.push_back(std::move(coinbase_symbol));
                     }
                 }
-                return all_success;
+
+                util::log("[COINBASE] Subscribed to trades and level2 for " + std::to_string(symbols.size()) + " symbols");
+
+                if (websocket_client_)
+                {
+                    return websocket_client_->subscribe_channels({"matches", "level2"}, coinbase_symbols);
+                }
+                return true;
             }
 
             std::string CoinbaseFeed::normalize_symbol(const std::string &exchange_symbol)
@@ -246,21 +281,21 @@ namespace open_dtc_server
 
             void CoinbaseFeed::on_trade_received(const exchanges::base::MarketTrade &trade)
             {
-                // Process received trade data
-                util::log("[COINBASE] Trade received: " + trade.symbol + " - " + std::to_string(trade.price) + " @ " + std::to_string(trade.volume));
-
-                // Forward to base class for distribution to clients
+                // Runs on the client's parser thread for every trade: no logging here
                 notify_trade(trade);
             }
             void CoinbaseFeed::on_level2_received(const exchanges::base::MarketLevel2 &level2)
             {
-                // Process received level2 data
-                util::log("[COINBASE] Level2 received: " + level2.symbol + " - Bid: " + std::to_string(level2.bid_price) + " Ask: " + std::to_string(level2.ask_price));
-
-                // Forward to base class for distribution to clients
+                // Runs on the client's parser thread for every top-of-book change
                 notify_level2(level2);
             }
 
+            void CoinbaseFeed::on_depth_received(const exchanges::base::MarketDepthUpdate &depth)
+            {
+                // Per-level changes are too frequent to log; forward them as they are
+                notify_depth(depth);
+            }
+
         } // namespace coinbase
     } // namespace exchanges
 } // namespace open_dtc_server
\ No newline at end of file
@@ -0,0 +1,195 @@
+#include "coinbase_dtc_core/exchanges/coinbase/frame_decoder.hpp"
+#include "coinbase_dtc_core/exchanges/coinbase/frame_mask.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace open_dtc_server
+{
+    namespace feed
+    {
+        namespace coinbase
+        {
+
+            namespace
+            {
+                // Largest frame header: 2 bytes, 8-byte length, 4-byte mask
+                constexpr size_t MAX_HEADER_SIZE = 14;
+            } // namespace
+
+            WebSocketFrameDecoder::WebSocketFrameDecoder(size_t capacity)
+                : buffer_(new uint8_t[std::max(capacity, MIN_READ_SIZE)]), capacity_(std::max(capacity, MIN_READ_SIZE))
+            {
+            }
+
+            uint8_t *WebSocketFrameDecoder::write_position()
+            {
+                if (read_ == write_)
+                {
+                    read_ = write_ = 0;
+                }
+                else if (capacity_ - write_ < MIN_READ_SIZE && read_ > 0)
+                {
+                    std::memmove(buffer_.get(), buffer_.get() + read_, write_ - read_);
+                    write_ -= read_;
+                    read_ = 0;
+                }
+                return buffer_.get() + write_;
+            }
+
+            void WebSocketFrameDecoder::reset()
+            {
+                read_ = write_ = 0;
+                fragments_.clear();
+                in_fragmented_message_ = false;
+            }
+
+            bool WebSocketFrameDecoder::reserve_frame(size_t total_size)
+            {
+                if (total_size > MAX_MESSAGE_SIZE + MAX_HEADER_SIZE)
+                {
+                    return false;
+                }
+
+                if (total_size > capacity_)
+                {
+                    size_t capacity = std::max(total_size, capacity_ * 2);
+                    std::unique_ptr<uint8_t[]> buffer(new uint8_t[capacity]);
+                    std::memcpy(buffer.get(), buffer_.get() + read_, write_ - read_);
+                    buffer_ = std::move(buffer);
+                    capacity_ = capacity;
+                    write_ -= read_;
+                    read_ = 0;
+                }
+                else if (capacity_ - read_ < total_size)
+                {
+                    std::memmove(buffer_.get(), buffer_.get() + read_, write_ - read_);
+                    write_ -= read_;
+                    read_ = 0;
+                }
+                return true;
+            }
+
+            WebSocketFrameDecoder::Status WebSocketFrameDecoder::next_message(uint8_t &opcode, std::string_view &payload)
+            {
+                for (;;)
+                {
+                    size_t available = write_ - read_;
+                    if (available < 2)
+                    {
+                        return Status::INCOMPLETE;
+                    }
+
+                    const uint8_t *header = buffer_.get() + read_;
+                    bool fin = (header[0] & 0x80) != 0;
+                    uint8_t frame_opcode = header[0] & 0x0F;
+                    bool masked = (header[1] & 0x80) != 0;
+                    uint64_t length = header[1] & 0x7F;
+                    bool rsv1 = (header[0] & 0x40) != 0;
+                    if ((header[0] & 0x30) != 0 || (rsv1 && !compression_))
+                    {
+                        return Status::INVALID; // bit of an extension that was not negotiated
+                    }
+
+                    size_t header_size = 2;
+                    if (length == 126)
+                    {
+                        if (available < 4)
+                        {
+                            return Status::INCOMPLETE;
+                        }
+                        length = (uint64_t(header[2]) << 8) | header[3];
+                        header_size = 4;
+                    }
+                    else if (length == 127)
+                    {
+                        if (available < 10)
+                        {
+                            return Status::INCOMPLETE;
+                        }
+                        length = 0;
+                        for (int i = 2; i < 10; i++)
+                        {
+                            length = (length << 8) | header[i];
+                        }
+                        header_size = 10;
+                    }
+                    if (length > MAX_MESSAGE_SIZE)
+                    {
+                        return Status::INVALID;
+                    }
+                    if (masked)
+                    {
+                        header_size += 4;
+                    }
+
+                    bool control = (frame_opcode & 0x8) != 0;
+                    if (control && (!fin || length > 125 || rsv1))
+                    {
+                        return Status::INVALID;
+                    }
+
+                    size_t frame_size = header_size + static_cast<size_t>(length);
+                    if (available < frame_size)
+                    {
+                        return reserve_frame(frame_size) ? Status::INCOMPLETE : Status::INVALID;
+                    }
+
+                    uint8_t *data = buffer_.get() + read_ + header_size;
+                    if (masked)
+                    {
+                        mask_websocket_payload(data, data, static_cast<size_t>(length), data - 4);
+                    }
+                    read_ += frame_size;
+                    std::string_view frame_payload(reinterpret_cast<const char *>(data), static_cast<size_t>(length));
+
+                    if (control)
+                    {
+                        opcode = frame_opcode;
+                        payload = frame_payload;
+                        compressed_ = false;
+                        return Status::MESSAGE;
+                    }
+
+                    // RSV1 is only set on the first frame of a compressed message
+                    if (frame_opcode == OPCODE_CONTINUATION)
+                    {
+                        if (!in_fragmented_message_ || rsv1 ||
+                            fragments_.size() + frame_payload.size() > MAX_MESSAGE_SIZE)
+                        {
+                            return Status::INVALID;
+                        }
+                        fragments_.insert(fragments_.end(), frame_payload.begin(), frame_payload.end());
+                        if (!fin)
+                        {
+                            continue;
+                        }
+                        in_fragmented_message_ = false;
+                        opcode = fragments_opcode_;
+                        compressed_ = fragments_compressed_;
+                        payload = std::string_view(fragments_.data(), fragments_.size());
+                        return Status::MESSAGE;
+                    }
+
+                    if ((frame_opcode != OPCODE_TEXT && frame_opcode != OPCODE_BINARY) || in_fragmented_message_)
+                    {
+                        return Status::INVALID;
+                    }
+                    if (!fin)
+                    {
+                        in_fragmented_message_ = true;
+                        fragments_opcode_ = frame_opcode;
+                        fragments_compressed_ = rsv1;
+                        fragments_.assign(frame_payload.begin(), frame_payload.end());
+                        continue;
+                    }
+
+                    opcode = frame_opcode;
+                    payload = frame_payload;
+                    compressed_ = rsv1;
+                    return Status::MESSAGE;
+                }
+            }
+
+        } // namespace coinbase
+    } // namespace feed
+} // namespace open_dtc_server
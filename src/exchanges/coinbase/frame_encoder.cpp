@@ -0,0 +1,68 @@
+#include "coinbase_dtc_core/exchanges/coinbase/frame_encoder.hpp"
+#include "coinbase_dtc_core/exchanges/coinbase/frame_mask.hpp"
+
+namespace open_dtc_server
+{
+    namespace feed
+    {
+        namespace coinbase
+        {
+
+            WebSocketFrameEncoder::WebSocketFrameEncoder() : rng_(std::random_device{}())
+            {
+            }
+
+            std::string_view WebSocketFrameEncoder::encode(std::string_view payload, uint8_t opcode)
+            {
+                // Masking keys must not be predictable by intermediaries (RFC 6455 10.3)
+                uint32_t key = rng_();
+                uint8_t mask_key[4] = {static_cast<uint8_t>(key), static_cast<uint8_t>(key >> 8),
+                                       static_cast<uint8_t>(key >> 16), static_cast<uint8_t>(key >> 24)};
+                return encode(payload, opcode, mask_key);
+            }
+
+            std::string_view WebSocketFrameEncoder::encode(std::string_view payload, uint8_t opcode, const uint8_t mask_key[4])
+            {
+                size_t needed = MAX_HEADER_SIZE + payload.size();
+                if (buffer_.size() < needed)
+                {
+                    buffer_.resize(needed);
+                }
+
+                uint8_t *frame = buffer_.data();
+                size_t length = payload.size();
+                size_t pos = 0;
+
+                // FIN=1, RSV=000, opcode; every client frame is masked
+                frame[pos++] = static_cast<uint8_t>(0x80 | opcode);
+                if (length < 126)
+                {
+                    frame[pos++] = static_cast<uint8_t>(0x80 | length);
+                }
+                else if (length < 65536)
+                {
+                    frame[pos++] = 0x80 | 126;
+                    frame[pos++] = static_cast<uint8_t>(length >> 8);
+                    frame[pos++] = static_cast<uint8_t>(length);
+                }
+                else
+                {
+                    frame[pos++] = 0x80 | 127;
+                    for (int shift = 56; shift >= 0; shift -= 8)
+                    {
+                        frame[pos++] = static_cast<uint8_t>(static_cast<uint64_t>(length) >> shift);
+                    }
+                }
+
+                for (int i = 0; i < 4; i++)
+                {
+                    frame[pos++] = mask_key[i];
+                }
+
+                mask_websocket_payload(frame + pos, reinterpret_cast<const uint8_t *>(payload.data()), length, mask_key);
+                return std::string_view(reinterpret_cast<const char *>(frame), pos + length);
+            }
+
+        } // namespace coinbase
+    } // namespace feed
+} // namespace open_dtc_server
@@ -0,0 +1,63 @@
+#include "coinbase_dtc_core/exchanges/coinbase/frame_mask.hpp"
+#include <cstring>
+
+#if defined(__AVX2__)
+#define FRAME_MASK_AVX2 1
+#include <immintrin.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FRAME_MASK_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace open_dtc_server
+{
+    namespace feed
+    {
+        namespace coinbase
+        {
+
+            void mask_websocket_payload(uint8_t *out, const uint8_t *in, size_t size, const uint8_t mask_key[4])
+            {
+                // The key repeats every 4 bytes, so every block size used below
+                // starts on key byte 0 and can use the same widened key
+                uint32_t key32;
+                std::memcpy(&key32, mask_key, 4);
+                size_t i = 0;
+
+#ifdef FRAME_MASK_AVX2
+                const __m256i key256 = _mm256_set1_epi32(static_cast<int>(key32));
+                for (; i + 32 <= size; i += 32)
+                {
+                    __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), _mm256_xor_si256(block, key256));
+                }
+#endif
+#ifdef FRAME_MASK_SSE2
+                const __m128i key128 = _mm_set1_epi32(static_cast<int>(key32));
+                for (; i + 16 <= size; i += 16)
+                {
+                    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_xor_si128(block, key128));
+                }
+#endif
+
+                const uint64_t key64 = (static_cast<uint64_t>(key32) << 32) | key32;
+                for (; i + 8 <= size; i += 8)
+                {
+                    uint64_t block;
+                    std::memcpy(&block, in + i, 8);
+                    block ^= key64;
+                    std::memcpy(out + i, &block, 8);
+                }
+
+                for (; i < size; i++)
+                {
+                    out[i] = in[i] ^ mask_key[i & 3];
+                }
+            }
+
+        } // namespace coinbase
+    } // namespace feed
+} // namespace open_dtc_server
@@ -0,0 +1,406 @@
+#include "coinbase_dtc_core/exchanges/coinbase/message_parser.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FEED_PARSER_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace open_dtc_server
+{
+    namespace feed
+    {
+        namespace coinbase
+        {
+
+            namespace
+            {
+#ifdef FEED_PARSER_SSE2
+                inline unsigned lowest_set_bit(unsigned mask)
+                {
+#if defined(_MSC_VER)
+                    unsigned long index;
+                    _BitScanForward(&index, mask);
+                    return static_cast<unsigned>(index);
+#else
+                    return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+                }
+#endif
+
+                // First quote or backslash at or after p, or end
+                inline const char *find_string_special(const char *p, const char *end)
+                {
+#ifdef FEED_PARSER_SSE2
+                    const __m128i quote = _mm_set1_epi8('"');
+                    const __m128i backslash = _mm_set1_epi8('\\');
+                    while (end - p >= 16)
+                    {
+                        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+                        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(
+                            _mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash))));
+                        if (mask != 0)
+                        {
+                            return p + lowest_set_bit(mask);
+                        }
+                        p += 16;
+                    }
+#endif
+                    while (p < end && *p != '"' && *p != '\\')
+                    {
+                        p++;
+                    }
+                    return p;
+                }
+
+                // First quote or bracket/brace at or after p, or end
+                inline const char *find_structural(const char *p, const char *end)
+                {
+#ifdef FEED_PARSER_SSE2
+                    const __m128i quote = _mm_set1_epi8('"');
+                    const __m128i open_square = _mm_set1_epi8('[');
+                    const __m128i close_square = _mm_set1_epi8(']');
+                    const __m128i open_curly = _mm_set1_epi8('{');
+                    const __m128i close_curly = _mm_set1_epi8('}');
+                    while (end - p >= 16)
+                    {
+                        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+                        __m128i hits = _mm_or_si128(
+                            _mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, open_square)),
+                            _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, close_square), _mm_cmpeq_epi8(chunk, open_curly)),
+                                         _mm_cmpeq_epi8(chunk, close_curly)));
+                        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(hits));
+                        if (mask != 0)
+                        {
+                            return p + lowest_set_bit(mask);
+                        }
+                        p += 16;
+                    }
+#endif
+                    while (p < end && *p != '"' && *p != '[' && *p != ']' && *p != '{' && *p != '}')
+                    {
+                        p++;
+                    }
+                    return p;
+                }
+
+                inline const char *skip_whitespace(const char *p, const char *end)
+                {
+                    while (p < end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t'))
+                    {
+                        p++;
+                    }
+                    return p;
+                }
+
+                // p is just past an opening quote. Returns the position after the
+                // closing quote, or nullptr if the string is unterminated.
+                inline const char *scan_string(const char *p, const char *end, std::string_view &value)
+                {
+                    const char *start = p;
+                    for (;;)
+                    {
+                        p = find_string_special(p, end);
+                        if (p >= end)
+                        {
+                            return nullptr;
+                        }
+                        if (*p == '"')
+                        {
+                            value = std::string_view(start, static_cast<size_t>(p - start));
+                            return p + 1;
+                        }
+                        p += 2; // skip the escaped character
+                    }
+                }
+
+                // p is at an opening bracket or brace. Returns the position after the
+                // matching close, or nullptr if the text ends first.
+                inline const char *scan_container(const char *p, const char *end)
+                {
+                    int depth = 0;
+                    std::string_view ignored;
+                    while (p < end)
+                    {
+                        p = find_structural(p, end);
+                        if (p >= end)
+                        {
+                            return nullptr;
+                        }
+                        switch (*p)
+                        {
+                        case '"':
+                            p = scan_string(p + 1, end, ignored);
+                            if (!p)
+                            {
+                                return nullptr;
+                            }
+                            continue;
+                        case '[':
+                        case '{':
+                            depth++;
+                            break;
+                        default:
+                            if (--depth == 0)
+                            {
+                                return p + 1;
+                            }
+                            break;
+                        }
+                        p++;
+                    }
+                    return nullptr;
+                }
+
+                // Numbers, true, false and null run to the next delimiter
+                inline const char *scan_literal(const char *p, const char *end)
+                {
+                    while (p < end && *p != ',' && *p != '}' && *p != ']' && *p != ' ' && *p != '\n' && *p != '\r' &&
+                           *p != '\t')
+                    {
+                        p++;
+                    }
+                    return p;
+                }
+
+                FeedMessageType message_type(std::string_view name)
+                {
+                    switch (name.size())
+                    {
+                    case 5:
+                        return name == "match" ? FeedMessageType::MATCH : name == "error" ? FeedMessageType::ERROR_MESSAGE
+                                                                                          : FeedMessageType::UNKNOWN;
+                    case 6:
+                        return name == "ticker" ? FeedMessageType::TICKER : FeedMessageType::UNKNOWN;
+                    case 8:
+                        return name == "l2update" ? FeedMessageType::L2UPDATE : name == "snapshot" ? FeedMessageType::SNAPSHOT
+                                                                                                   : FeedMessageType::UNKNOWN;
+                    case 9:
+                        return name == "heartbeat" ? FeedMessageType::HEARTBEAT : FeedMessageType::UNKNOWN;
+                    case 13:
+                        return name == "subscriptions" ? FeedMessageType::SUBSCRIPTIONS : FeedMessageType::UNKNOWN;
+                    default:
+                        return FeedMessageType::UNKNOWN;
+                    }
+                }
+
+                // Field a key is stored in, or nullptr for keys the client never reads.
+                // Dispatching on the length first keeps this to one or two compares.
+                std::string_view *field_for_key(FeedMessage &out, std::string_view key)
+                {
+                    switch (key.size())
+                    {
+                    case 4:
+                        if (key == "type")
+                            return &out.type_name;
+                        if (key == "time")
+                            return &out.time;
+                        if (key == "size")
+                            return &out.size;
+                        if (key == "side")
+                            return &out.side;
+                        if (key == "bids")
+                            return &out.bids;
+                        if (key == "asks")
+                            return &out.asks;
+                        return nullptr;
+                    case 5:
+                        return key == "price" ? &out.price : nullptr;
+                    case 7:
+                        if (key == "changes")
+                            return &out.changes;
+                        if (key == "message")
+                            return &out.message;
+                        return nullptr;
+                    case 8:
+                        if (key == "sequence")
+                            return &out.sequence;
+                        if (key == "trade_id")
+                            return &out.trade_id;
+                        if (key == "best_bid")
+                            return &out.best_bid;
+                        if (key == "best_ask")
+                            return &out.best_ask;
+                        return nullptr;
+                    case 10:
+                        return key == "product_id" ? &out.product_id : nullptr;
+                    case 13:
+                        if (key == "best_bid_size")
+                            return &out.best_bid_size;
+                        if (key == "best_ask_size")
+                            return &out.best_ask_size;
+                        if (key == "last_trade_id")
+                            return &out.last_trade_id;
+                        return nullptr;
+                    default:
+                        return nullptr;
+                    }
+                }
+            } // namespace
+
+            bool parse_feed_message(std::string_view json, FeedMessage &out)
+            {
+                out = FeedMessage();
+
+                const char *p = json.data();
+                const char *end = p + json.size();
+                p = skip_whitespace(p, end);
+                if (p >= end || *p != '{')
+                {
+                    return false;
+                }
+                p = skip_whitespace(p + 1, end);
+                if (p < end && *p == '}')
+                {
+                    return true;
+                }
+
+                while (p < end)
+                {
+                    std::string_view key;
+                    if (*p != '"' || !(p = scan_string(p + 1, end, key)))
+                    {
+                        return false;
+                    }
+                    p = skip_whitespace(p, end);
+                    if (p >= end || *p != ':')
+                    {
+                        return false;
+                    }
+                    p = skip_whitespace(p + 1, end);
+                    if (p >= end)
+                    {
+                        return false;
+                    }
+
+                    std::string_view value;
+                    if (*p == '"')
+                    {
+                        p = scan_string(p + 1, end, value);
+                    }
+                    else if (*p == '[' || *p == '{')
+                    {
+                        const char *start = p;
+                        p = scan_container(p, end);
+                        if (p)
+                        {
+                            value = std::string_view(start, static_cast<size_t>(p - start));
+                        }
+                    }
+                    else
+                    {
+                        const char *start = p;
+                        p = scan_literal(p, end);
+                        value = std::string_view(start, static_cast<size_t>(p - start));
+                    }
+                    if (!p)
+                    {
+                        return false;
+                    }
+
+                    if (std::string_view *field = field_for_key(out, key))
+                    {
+                        *field = value;
+                    }
+
+                    p = skip_whitespace(p, end);
+                    if (p < end && *p == ',')
+                    {
+                        p = skip_whitespace(p + 1, end);
+                        continue;
+                    }
+                    if (p < end && *p == '}')
+                    {
+                        out.type = message_type(out.type_name);
+                        return true;
+                    }
+                    return false;
+                }
+                return false;
+            }
+
+            FeedArrayReader::FeedArrayReader(std::string_view array)
+                : pos_(array.data()), end_(array.data() + array.size())
+            {
+                // Step inside the outer array
+                pos_ = skip_whitespace(pos_, end_);
+                if (pos_ < end_ && *pos_ == '[')
+                {
+                    pos_++;
+                }
+                else
+                {
+                    pos_ = end_;
+                }
+            }
+
+            size_t FeedArrayReader::next(std::string_view *fields, size_t max_fields)
+            {
+                const char *p = skip_whitespace(pos_, end_);
+                if (p < end_ && *p == ',')
+                {
+                    p = skip_whitespace(p + 1, end_);
+                }
+                if (p >= end_ || *p != '[')
+                {
+                    pos_ = end_;
+                    return 0;
+                }
+                p++;
+
+                size_t count = 0;
+                for (;;)
+                {
+                    p = skip_whitespace(p, end_);
+                    if (p >= end_)
+                    {
+                        pos_ = end_;
+                        return 0;
+                    }
+                    if (*p == ']')
+                    {
+                        pos_ = p + 1;
+                        return count;
+                    }
+                    if (*p == ',')
+                    {
+                        p++;
+                        continue;
+                    }
+
+                    std::string_view value;
+                    if (*p == '"')
+                    {
+                        p = scan_string(p + 1, end_, value);
+                        if (!p)
+                        {
+                            pos_ = end_;
+                            return 0;
+                        }
+                    }
+                    else
+                    {
+                        // Rows hold only strings and literals; an object, a nested array or
+                        // a stray close would otherwise leave p where it is
+                        const char *start = p;
+                        p = scan_literal(p, end_);
+                        if (p == start || *start == '{' || *start == '[')
+                        {
+                            pos_ = end_;
+                            return 0;
+                        }
+                        value = std::string_view(start, static_cast<size_t>(p - start));
+                    }
+                    if (count < max_fields)
+                    {
+                        fields[count++] = value;
+                    }
+                }
+            }
+
+        } // namespace coinbase
+    } // namespace feed
+} // namespace open_dtc_server
@@ -0,0 +1,276 @@
+#include "coinbase_dtc_core/exchanges/coinbase/permessage_deflate.hpp"
+#include <algorithm>
+#include <cstdint>
+
+#ifdef HAS_ZLIB
+#include <zlib.h>
+#else
+struct z_stream_s
+{
+};
+#endif
+
+namespace open_dtc_server
+{
+    namespace feed
+    {
+        namespace coinbase
+        {
+
+            namespace
+            {
+                std::string_view trim(std::string_view text)
+                {
+                    while (!text.empty() && (text.front() == ' ' || text.front() == '\t'))
+                    {
+                        text.remove_prefix(1);
+                    }
+                    while (!text.empty() && (text.back() == ' ' || text.back() == '\t'))
+                    {
+                        text.remove_suffix(1);
+                    }
+                    return text;
+                }
+
+                // Split off the text before the next separator
+                std::string_view next_token(std::string_view &text, char separator)
+                {
+                    size_t end = text.find(separator);
+                    std::string_view token = text.substr(0, end);
+                    text = end == std::string_view::npos ? std::string_view() : text.substr(end + 1);
+                    return trim(token);
+                }
+
+                // RFC 7692 7.1.2: window bits 8-15, optionally quoted
+                bool parse_window_bits(std::string_view value, int &bits)
+                {
+                    if (value.size() >= 2 && value.front() == '"' && value.back() == '"')
+                    {
+                        value = value.substr(1, value.size() - 2);
+                    }
+                    if (value.empty() || value.size() > 2)
+                    {
+                        return false;
+                    }
+                    int parsed = 0;
+                    for (char c : value)
+                    {
+                        if (c < '0' || c > '9')
+                        {
+                            return false;
+                        }
+                        parsed = parsed * 10 + (c - '0');
+                    }
+                    if (parsed < 8 || parsed > 15)
+                    {
+                        return false;
+                    }
+                    bits = parsed;
+                    return true;
+                }
+
+                // Appended by the receiver to complete the sync flush the sender stripped
+                const uint8_t SYNC_FLUSH_TAIL[4] = {0x00, 0x00, 0xFF, 0xFF};
+            } // namespace
+
+            bool parse_permessage_deflate(std::string_view header, DeflateParameters &params)
+            {
+                DeflateParameters parsed;
+                bool found = false;
+
+                while (!header.empty())
+                {
+                    std::string_view extension = next_token(header, ',');
+                    std::string_view name = next_token(extension, ';');
+                    if (name != "permessage-deflate" || found)
+                    {
+                        return false; // only the extension we offered, once
+                    }
+                    found = true;
+
+                    bool seen[4] = {false, false, false, false};
+                    while (!extension.empty())
+                    {
+                        std::string_view parameter = next_token(extension, ';');
+                        size_t equals = parameter.find('=');
+                        std::string_view key = trim(parameter.substr(0, equals));
+                        std::string_view value = equals == std::string_view::npos ? std::string_view()
+                                                                                  : trim(parameter.substr(equals + 1));
+
+                        int index;
+                        bool valid;
+                        if (key == "server_no_context_takeover")
+                        {
+                            index = 0;
+                            valid = equals == std::string_view::npos;
+                            parsed.server_no_context_takeover = true;
+                        }
+                        else if (key == "client_no_context_takeover")
+                        {
+                            index = 1;
+                            valid = equals == std::string_view::npos;
+                            parsed.client_no_context_takeover = true;
+                        }
+                        else if (key == "server_max_window_bits")
+                        {
+                            index = 2;
+                            valid = parse_window_bits(value, parsed.server_max_window_bits);
+                        }
+                        else if (key == "client_max_window_bits")
+                        {
+                            index = 3;
+                            valid = parse_window_bits(value, parsed.client_max_window_bits);
+                        }
+                        else
+                        {
+                            return false;
+                        }
+
+                        if (!valid || seen[index])
+                        {
+                            return false;
+                        }
+                        seen[index] = true;
+                    }
+                }
+
+                if (!found)
+                {
+                    return false;
+                }
+                params = parsed;
+                return true;
+            }
+
+#ifdef HAS_ZLIB
+            MessageInflater::MessageInflater() : stream_(new z_stream_s())
+            {
+            }
+
+            MessageInflater::~MessageInflater()
+            {
+                end();
+            }
+
+            bool MessageInflater::available()
+            {
+                return true;
+            }
+
+            bool MessageInflater::start(const DeflateParameters &params)
+            {
+                end();
+                *stream_ = z_stream_s();
+
+                // Raw deflate; a 15-bit window also reads streams made with a smaller one
+                if (inflateInit2(stream_.get(), -15) != Z_OK)
+                {
+                    return false;
+                }
+                reset_after_message_ = params.server_no_context_takeover;
+                active_ = true;
+                return true;
+            }
+
+            bool MessageInflater::inflate(std::string_view compressed, std::string_view &message)
+            {
+                if (!active_)
+                {
+                    return false;
+                }
+
+                z_stream_s &stream = *stream_;
+                size_t produced = 0;
+                bool ended = false;
+
+                // The message body, then the tail the sender stripped from its sync flush
+                for (int part = 0; part < 2 && !ended; part++)
+                {
+                    stream.next_in = part == 0 ? reinterpret_cast<Bytef *>(const_cast<char *>(compressed.data()))
+                                               : const_cast<Bytef *>(SYNC_FLUSH_TAIL);
+                    stream.avail_in = static_cast<uInt>(part == 0 ? compressed.size() : sizeof(SYNC_FLUSH_TAIL));
+
+                    for (;;)
+                    {
+                        if (output_.size() - produced < 4096)
+                        {
+                            if (output_.size() >= MAX_MESSAGE_SIZE)
+                            {
+                                return false;
+                            }
+                            output_.resize(std::max<size_t>(output_.size() * 2, 64 * 1024));
+                        }
+                        stream.next_out = reinterpret_cast<Bytef *>(output_.data() + produced);
+                        stream.avail_out = static_cast<uInt>(output_.size() - produced);
+
+                        int result = ::inflate(&stream, Z_SYNC_FLUSH);
+                        produced = output_.size() - stream.avail_out;
+
+                        if (result == Z_STREAM_END)
+                        {
+                            ended = true; // final block: the sender starts a new stream next message
+                            break;
+                        }
+                        if (result != Z_OK && result != Z_BUF_ERROR)
+                        {
+                            return false;
+                        }
+                        if (stream.avail_in == 0 && stream.avail_out != 0)
+                        {
+                            break;
+                        }
+                        if (result == Z_BUF_ERROR && stream.avail_out != 0)
+                        {
+                            return false; // no progress with input and room left: corrupt
+                        }
+                    }
+                }
+
+                if (produced > MAX_MESSAGE_SIZE)
+                {
+                    return false;
+                }
+                if (ended || reset_after_message_)
+                {
+                    inflateReset(&stream);
+                }
+
+                message = std::string_view(output_.data(), produced);
+                return true;
+            }
+
+            void MessageInflater::end()
+            {
+                if (active_)
+                {
+                    inflateEnd(stream_.get());
+                    active_ = false;
+                }
+            }
+#else
+            MessageInflater::MessageInflater() = default;
+            MessageInflater::~MessageInflater() = default;
+
+            bool MessageInflater::available()
+            {
+                return false;
+            }
+
+            bool MessageInflater::start(const DeflateParameters &)
+            {
+                return false;
+            }
+
+            bool MessageInflater::inflate(std::string_view, std::string_view &)
+            {
+                return false;
+            }
+
+            void MessageInflater::end()
+            {
+            }
+#endif
+
+        } // namespace coinbase
+    } // namespace feed
+} // namespace open_dtc_server
@@ -0,0 +1,42 @@
+#include "coinbase_dtc_core/exchanges/coinbase/sequence_tracker.hpp"
+#include <charconv>
+
+namespace open_dtc_server
+{
+    namespace feed
+    {
+        namespace coinbase
+        {
+
+            SequenceTracker::Result SequenceTracker::check(uint32_t symbol_id, uint64_t sequence)
+            {
+                auto inserted = last_.emplace(symbol_id, sequence);
+                if (inserted.second)
+                {
+                    return Result::FIRST;
+                }
+
+                uint64_t &last = inserted.first->second;
+                if (sequence <= last)
+                {
+                    return Result::DUPLICATE;
+                }
+
+                Result result = sequence == last + 1 ? Result::NEXT : Result::GAP;
+                last = sequence;
+                return result;
+            }
+
+            bool SequenceTracker::parse(std::string_view field, uint64_t &sequence)
+            {
+                if (field.empty())
+                {
+                    return false;
+                }
+                auto parsed = std::from_chars(field.data(), field.data() + field.size(), sequence);
+                return parsed.ec == std::errc() && parsed.ptr == field.data() + field.size();
+            }
+
+        } // namespace coinbase
+    } // namespace feed
+} // namespace open_dtc_server
@@ -0,0 +1,268 @@
+#include "coinbase_dtc_core/exchanges/coinbase/tls_transport.hpp"
+#include "coinbase_dtc_core/core/util/log.hpp"
+#include <algorithm>
+#include <climits>
+
+#ifdef HAS_OPENSSL
+#include <openssl/err.h>
+#include <openssl/ssl.h>
+#include <openssl/x509v3.h>
+#endif
+
+namespace open_dtc_server
+{
+    namespace feed
+    {
+        namespace coinbase
+        {
+
+#ifdef HAS_OPENSSL
+            namespace
+            {
+                // Read-ahead buffer: several 16 KB records per recv()
+                constexpr long READ_BUFFER_SIZE = 64 * 1024;
+
+                std::string openssl_error()
+                {
+                    unsigned long code = ERR_get_error();
+                    if (code == 0)
+                    {
+                        return "unknown error";
+                    }
+                    char text[256];
+                    ERR_error_string_n(code, text, sizeof(text));
+                    return text;
+                }
+            } // namespace
+
+            TlsTransport::~TlsTransport()
+            {
+                close();
+                if (session_)
+                {
+                    SSL_SESSION_free(session_);
+                }
+                if (ctx_)
+                {
+                    SSL_CTX_free(ctx_);
+                }
+            }
+
+            void TlsTransport::set_ca_file(const std::string &path)
+            {
+                ca_file_ = path;
+
+                // Rebuilt with the new trust store on the next connect()
+                if (ctx_ && !ssl_)
+                {
+                    SSL_CTX_free(ctx_);
+                    ctx_ = nullptr;
+                }
+            }
+
+            bool TlsTransport::create_context()
+            {
+                ctx_ = SSL_CTX_new(TLS_client_method());
+                if (!ctx_)
+                {
+                    util::log("[ERROR] Failed to create TLS context: " + openssl_error());
+                    return false;
+                }
+
+                SSL_CTX_set_min_proto_version(ctx_, TLS1_2_VERSION);
+                SSL_CTX_set_verify(ctx_, SSL_VERIFY_PEER, nullptr);
+                int loaded = ca_file_.empty() ? SSL_CTX_set_default_verify_paths(ctx_)
+                                              : SSL_CTX_load_verify_locations(ctx_, ca_file_.c_str(), nullptr);
+                if (loaded != 1)
+                {
+                    util::log("[ERROR] Failed to load TLS trust store: " + openssl_error());
+                    SSL_CTX_free(ctx_);
+                    ctx_ = nullptr;
+                    return false;
+                }
+
+                // Sessions are kept by on_new_session(), not OpenSSL's internal cache
+                SSL_CTX_set_session_cache_mode(ctx_, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+                SSL_CTX_sess_set_new_cb(ctx_, &TlsTransport::on_new_session);
+
+                SSL_CTX_set_read_ahead(ctx_, 1);
+                SSL_CTX_set_default_read_buffer_len(ctx_, READ_BUFFER_SIZE);
+                return true;
+            }
+
+            bool TlsTransport::connect(int socket, const std::string &host, uint16_t port)
+            {
+                close();
+                if (!ctx_ && !create_context())
+                {
+                    return false;
+                }
+
+                ssl_ = SSL_new(ctx_);
+                if (!ssl_)
+                {
+                    util::log("[ERROR] Failed to create TLS connection: " + openssl_error());
+                    return false;
+                }
+
+                peer_ = host + ":" + std::to_string(port);
+                SSL_set_app_data(ssl_, this);
+                SSL_set_fd(ssl_, socket);
+                SSL_set_tlsext_host_name(ssl_, host.c_str()); // SNI
+                SSL_set1_host(ssl_, host.c_str());            // certificate must name the host
+                if (session_ && session_peer_ == peer_)
+                {
+                    SSL_set_session(ssl_, session_);
+                }
+
+                ERR_clear_error();
+                if (SSL_connect(ssl_) != 1)
+                {
+                    long verify = SSL_get_verify_result(ssl_);
+                    std::string reason = verify != X509_V_OK ? X509_verify_cert_error_string(verify) : openssl_error();
+                    util::log("[ERROR] TLS handshake with " + peer_ + " failed: " + reason);
+                    SSL_free(ssl_);
+                    ssl_ = nullptr;
+                    return false;
+                }
+
+                util::log(std::string("[TLS] Connected to ") + peer_ + " using " + SSL_get_version(ssl_) +
+                          (SSL_session_reused(ssl_) ? " (session resumed)" : ""));
+                return true;
+            }
+
+            // Called for every session the server issues: after the TLS 1.2 handshake,
+            // or for each TLS 1.3 ticket read after it. Keeps the newest one.
+            int TlsTransport::on_new_session(ssl_st *ssl, ssl_session_st *session)
+            {
+                TlsTransport *self = static_cast<TlsTransport *>(SSL_get_app_data(ssl));
+                if (!self)
+                {
+                    return 0;
+                }
+                if (self->session_)
+                {
+                    SSL_SESSION_free(self->session_);
+                }
+                self->session_ = session;
+                self->session_peer_ = self->peer_;
+                return 1; // we own the reference now
+            }
+
+            ptrdiff_t TlsTransport::read(void *data, size_t size, bool &would_block)
+            {
+                would_block = false;
+                if (!ssl_)
+                {
+                    return -1;
+                }
+
+                ERR_clear_error();
+                int count = SSL_read(ssl_, data, static_cast<int>(std::min<size_t>(size, INT_MAX)));
+                if (count > 0)
+                {
+                    return count;
+                }
+
+                switch (SSL_get_error(ssl_, count))
+                {
+                case SSL_ERROR_WANT_READ:
+                case SSL_ERROR_WANT_WRITE:
+                    would_block = true;
+                    return 0;
+                case SSL_ERROR_ZERO_RETURN:
+                    return 0; // close_notify
+                default:
+                    return -1;
+                }
+            }
+
+            ptrdiff_t TlsTransport::write(const void *data, size_t size, bool &would_block)
+            {
+                would_block = false;
+                if (!ssl_)
+                {
+                    return -1;
+                }
+
+                ERR_clear_error();
+                int count = SSL_write(ssl_, data, static_cast<int>(std::min<size_t>(size, INT_MAX)));
+                if (count > 0)
+                {
+                    return count;
+                }
+
+                switch (SSL_get_error(ssl_, count))
+                {
+                case SSL_ERROR_WANT_READ:
+                case SSL_ERROR_WANT_WRITE:
+                    would_block = true;
+                    return 0;
+                default:
+                    return -1;
+                }
+            }
+
+            bool TlsTransport::has_pending() const
+            {
+                return ssl_ && SSL_has_pending(ssl_) == 1;
+            }
+
+            bool TlsTransport::session_reused() const
+            {
+                return ssl_ && SSL_session_reused(ssl_) == 1;
+            }
+
+            void TlsTransport::close()
+            {
+                if (ssl_)
+                {
+                    SSL_shutdown(ssl_); // best effort close_notify; the socket may be gone
+                    SSL_free(ssl_);
+                    ssl_ = nullptr;
+                }
+            }
+#else
+            TlsTransport::~TlsTransport() = default;
+
+            void TlsTransport::set_ca_file(const std::string &path)
+            {
+                ca_file_ = path;
+            }
+
+            bool TlsTransport::connect(int, const std::string &, uint16_t)
+            {
+                util::log("[ERROR] TLS requires OpenSSL, which was not found at build time");
+                return false;
+            }
+
+            ptrdiff_t TlsTransport::read(void *, size_t, bool &would_block)
+            {
+                would_block = false;
+                return -1;
+            }
+
+            ptrdiff_t TlsTransport::write(const void *, size_t, bool &would_block)
+            {
+                would_block = false;
+                return -1;
+            }
+
+            bool TlsTransport::has_pending() const
+            {
+                return false;
+            }
+
+            bool TlsTransport::session_reused() const
+            {
+                return false;
+            }
+
+            void TlsTransport::close()
+            {
+            }
+#endif
+
+        } // namespace coinbase
+    } // namespace feed
+} // namespace open_dtc_server
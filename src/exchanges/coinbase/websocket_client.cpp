@@ -1,13 +1,19 @@
 #include "coinbase_dtc_core/exchanges/coinbase/websocket_client.hpp"
 #include "coinbase_dtc_core/core/util/log.hpp"
+#include "coinbase_dtc_core/core/util/decimal.hpp"
+#include "coinbase_dtc_core/core/util/symbol_table.hpp"
+#include "coinbase_dtc_core/core/util/thread_tuning.hpp"
+#include "coinbase_dtc_core/core/util/timestamp.hpp"
 #include <iostream>
 #include <sstream>
 #include <chrono>
 #include <random>
+#include <cstdlib>
 #include <cstring>
 #include <algorithm>
 #include <vector>
 #include <iomanip>
+#include <cctype>
 
 #ifdef _WIN32
 #include <winsock2.h>
@@ -28,6 +34,9 @@ typedef int ssize_t;
 #include <arpa/inet.h>
 #include <unistd.h>
 #include <netdb.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <cerrno>
 #endif
 
 namespace open_dtc_server
@@ -36,14 +45,43 @@ namespace open_dtc_server
     {
         namespace coinbase
         {
+            namespace
+            {
+                // Value of an HTTP response header (names are case-insensitive), or empty
+                std::string_view header_value(std::string_view headers, std::string_view name)
+                {
+                    size_t line = headers.find("\r\n");
+                    while (line != std::string_view::npos)
+                    {
+                        size_t start = line + 2;
+                        size_t end = headers.find("\r\n", start);
+                        std::string_view field = headers.substr(start, end == std::string_view::npos ? end : end - start);
+                        if (field.size() > name.size() && field[name.size()] == ':' &&
+                            std::equal(name.begin(), name.end(), field.begin(), [](char a, char b)
+                                       { return std::tolower(static_cast<unsigned char>(a)) ==
+                                                std::tolower(static_cast<unsigned char>(b)); }))
+                        {
+                            std::string_view value = field.substr(name.size() + 1);
+                            while (!value.empty() && value.front() == ' ')
+                            {
+                                value.remove_prefix(1);
+                            }
+                            return value;
+                        }
+                        line = end;
+                    }
+                    return std::string_view();
+                }
+            } // namespace
+
             WebSocketClient::WebSocketClient()
                 : connected_(false), should_stop_(false), socket_(-1),
                   host_("ws-feed.exchange.coinbase.com"), port_(443),
-                  ssl_initialized_(false),
-#ifdef _WIN32
-                  ssl_creds_(nullptr), ssl_context_(nullptr),
-                  ssl_context_valid_(false),
-#endif
+                  exchange_id_(util::SymbolTable::exchanges().intern("coinbase")),
+                  use_tls_(true), ingress_cpu_(-1), book_cpu_(-1), busy_poll_(false), socket_busy_poll_us_(0),
+                  use_compression_(MessageInflater::available()),
+                  receive_ring_(RECEIVE_RING_BYTES), parser_parked_(false), ring_full_waits_(0),
+                  book_resyncs_(0), duplicates_dropped_(0),
                   messages_received_(0), messages_sent_(0), last_message_time_(0)
             {
 #ifdef _WIN32
@@ -53,18 +91,12 @@ namespace open_dtc_server
                 {
                     util::log("[ERROR] WSAStartup failed: " + std::to_string(result));
                 }
-
-                // SSL support disabled for basic testing
-                ssl_creds_ = nullptr;
-                ssl_context_ = nullptr;
 #endif
             }
             WebSocketClient::~WebSocketClient()
             {
                 disconnect();
-                cleanup_ssl();
 #ifdef _WIN32
-                // SSL handles cleanup - currently disabled
                 WSACleanup();
 #endif
             }
@@ -76,6 +108,10 @@ namespace open_dtc_server
                     return true;
                 }
 
+                // A peer close leaves the previous connection's threads and socket behind
+                stop_threads();
+                cleanup_socket();
+
                 host_ = host;
                 port_ = port;
 
@@ -91,8 +127,13 @@ namespace open_dtc_server
                 connected_.store(true);
                 should_stop_.store(false);
 
-                // Start worker threads
+                // Start worker threads; neither side of the ring is running yet, and
+                // sequence numbers start over with the new connection
+                receive_ring_.clear();
+                trade_sequences_.clear();
+                pending_resyncs_.clear();
                 worker_thread_ = std::thread(&WebSocketClient::worker_loop, this);
+                parser_thread_ = std::thread(&WebSocketClient::parser_loop, this);
                 ping_thread_ = std::thread(&WebSocketClient::ping_loop, this);
 
                 util::log("[SUCCESS] WebSocket connected to " + host);
@@ -101,83 +142,134 @@ namespace open_dtc_server
 
             void WebSocketClient::disconnect()
             {
-                if (!connected_.load())
+                // The worker clears connected_ when the peer closes, but its threads
+                // still need joining
+                bool was_connected = connected_.exchange(false);
+                if (was_connected)
                 {
-                    return;
+                    util::log("[WS] Disconnecting...");
                 }
 
-                util::log("[WS] Disconnecting...");
+                stop_threads();
+                cleanup_socket();
+
+                if (was_connected)
+                {
+                    util::log("[WS] Disconnected");
+                }
+            }
 
+            void WebSocketClient::stop_threads()
+            {
                 should_stop_.store(true);
-                connected_.store(false);
+                {
+                    std::lock_guard<std::mutex> lock(parser_mutex_);
+                    parser_cv_.notify_one();
+                }
 
                 // Wait for threads to finish
                 if (worker_thread_.joinable())
                 {
                     worker_thread_.join();
                 }
+                if (parser_thread_.joinable())
+                {
+                    parser_thread_.join();
+                }
                 if (ping_thread_.joinable())
                 {
                     ping_thread_.join();
                 }
-
-                cleanup_socket();
-                util::log("[WS] Disconnected");
             }
 
             bool WebSocketClient::subscribe_trades(const std::string &product_id)
             {
-                std::lock_guard<std::mutex> lock(subscriptions_mutex_);
+                return subscribe_channels({"matches"}, {product_id});
+            }
 
-                // Add to subscribed symbols if not already present
-                if (std::find(subscribed_symbols_.begin(), subscribed_symbols_.end(), product_id) == subscribed_symbols_.end())
-                {
-                    subscribed_symbols_.push_back(product_id);
-                    util::log("[WS] Subscribed to trades: " + product_id);
+            bool WebSocketClient::subscribe_level2(const std::string &product_id)
+            {
+                return subscribe_channels({"level2"}, {product_id});
+            }
 
-                    // Send subscription message to WebSocket
-                    if (connected_.load())
-                    {
-                        std::string sub_msg = create_subscribe_message("matches", product_id);
-                        send_websocket_frame(sub_msg);
-                    }
-                }
-                return true;
+            bool WebSocketClient::unsubscribe(const std::string &product_id)
+            {
+                return unsubscribe_channels({"matches", "level2"}, {product_id});
             }
 
-            bool WebSocketClient::subscribe_level2(const std::string &product_id)
+            bool WebSocketClient::subscribe_multiple_symbols(const std::vector<std::string> &product_ids)
             {
-                std::lock_guard<std::mutex> lock(subscriptions_mutex_);
-                util::log("[WS] Subscribed to level2: " + product_id);
+                return subscribe_channels({"matches"}, product_ids);
+            }
 
-                // Send subscription message to WebSocket
-                if (connected_.load())
+            bool WebSocketClient::subscribe_channels(const std::vector<std::string> &channels,
+                                                     const std::vector<std::string> &product_ids)
+            {
                 {
-                    std::string sub_msg = create_subscribe_message("level2", product_id);
-                    send_websocket_frame(sub_msg);
+                    std::lock_guard<std::mutex> lock(subscriptions_mutex_);
+                    for (const auto &product_id : product_ids)
+                    {
+                        util::SymbolTable::symbols().intern(product_id);
+                        if (std::find(subscribed_symbols_.begin(), subscribed_symbols_.end(), product_id) == subscribed_symbols_.end())
+                        {
+                            subscribed_symbols_.push_back(product_id);
+                        }
+                    }
                 }
-                return true;
+                return send_subscription("subscribe", channels, product_ids);
             }
 
-            bool WebSocketClient::unsubscribe(const std::string &product_id)
+            bool WebSocketClient::unsubscribe_channels(const std::vector<std::string> &channels,
+                                                       const std::vector<std::string> &product_ids)
             {
-                std::lock_guard<std::mutex> lock(subscriptions_mutex_);
-                auto it = std::find(subscribed_symbols_.begin(), subscribed_symbols_.end(), product_id);
-                if (it != subscribed_symbols_.end())
                 {
-                    subscribed_symbols_.erase(it);
-                    util::log("[WS] Unsubscribed from: " + product_id);
+                    std::lock_guard<std::mutex> lock(subscriptions_mutex_);
+                    for (const auto &product_id : product_ids)
+                    {
+                        auto it = std::find(subscribed_symbols_.begin(), subscribed_symbols_.end(), product_id);
+                        if (it != subscribed_symbols_.end())
+                        {
+                            subscribed_symbols_.erase(it);
+                        }
+                    }
                 }
-                return true;
+                return send_subscription("unsubscribe", channels, product_ids);
             }
 
-            bool WebSocketClient::subscribe_multiple_symbols(const std::vector<std::string> &product_ids)
+            // One frame per run of products that fits both batch limits
+            bool WebSocketClient::send_subscription(const char *type, const std::vector<std::string> &channels,
+                                                    const std::vector<std::string> &product_ids)
             {
-                for (const auto &product_id : product_ids)
+                if (product_ids.empty() || channels.empty() || !connected_.load())
                 {
-                    subscribe_trades(product_id);
+                    return true;
                 }
-                return true;
+
+                size_t overhead = create_subscription_message(type, channels, product_ids, 0, 0).size();
+                bool sent = true;
+                size_t frames = 0;
+                for (size_t begin = 0; begin < product_ids.size(); frames++)
+                {
+                    size_t end = begin;
+                    size_t bytes = overhead;
+                    while (end < product_ids.size() && end - begin < MAX_PRODUCTS_PER_MESSAGE &&
+                           (end == begin || bytes + product_ids[end].size() + 3 <= MAX_SUBSCRIPTION_MESSAGE_BYTES))
+                    {
+                        bytes += product_ids[end].size() + 3; // quotes and comma
+                        end++;
+                    }
+                    sent = send_websocket_frame(create_subscription_message(type, channels, product_ids, begin, end)) && sent;
+                    begin = end;
+                }
+
+                std::string channel_list;
+                for (const auto &channel : channels)
+                {
+                    channel_list += (channel_list.empty() ? "" : ", ") + channel;
+                }
+                util::log("[WS] Sent " + std::string(type) + " for " + std::to_string(product_ids.size()) + " products (" +
+                          channel_list + ") in " + std::to_string(frames) + " frames");
+                return sent;
             }
 
             std::vector<std::string> WebSocketClient::get_subscribed_symbols() const
@@ -192,57 +284,156 @@ namespace open_dtc_server
                 {
                     return "Connected to " + host_ + ":" + std::to_string(port_) +
                            " (Messages: " + std::to_string(messages_received_.load()) + " received, " +
-                           std::to_string(messages_sent_.load()) + " sent)";
+                           std::to_string(messages_sent_.load()) + " sent, " +
+                           std::to_string(ring_full_waits_.load()) + " waits on a full parser queue, " +
+                           std::to_string(book_resyncs_.load()) + " book resyncs, " +
+                           std::to_string(duplicates_dropped_.load()) + " duplicate trades dropped)";
                 }
                 return "Disconnected";
             }
 
             void WebSocketClient::worker_loop()
             {
+                util::ScopedThreadRegistration registration("coinbase-ingress", ingress_cpu_);
                 util::log("[WS] Worker thread started");
 
+                // Busy polling checks the socket without ever sleeping in the kernel
+                int timeout_ms = busy_poll_ ? 0 : 100;
+
                 while (!should_stop_.load())
                 {
-                    if (connected_.load() && socket_ != -1)
+                    if (!connected_.load() || socket_ == -1)
                     {
-                        // Try to receive WebSocket frames
-                        std::string payload;
-                        if (receive_websocket_frame(payload))
-                        {
-                            if (!payload.empty())
-                            {
-                                // Process received message
-                                process_received_message(payload);
-                            }
-                        }
-                        else
-                        {
-                            // No data available or connection lost, sleep briefly
-                            std::this_thread::sleep_for(std::chrono::milliseconds(10));
-                        }
+                        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                        continue;
                     }
-                    else
+
+                    // A timeout still runs the decoder for frames that came in with the
+                    // handshake response
+                    bool open = !wait_readable(timeout_ms) || read_available();
+
+                    // One timestamp per batch: every frame in it arrived by now
+                    if (!process_frames(util::now_micros()) || !open)
                     {
-                        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                        util::log("[WS] Connection closed by peer");
+                        connected_.store(false);
                     }
                 }
 
                 util::log("[WS] Worker thread stopped");
             }
 
+            void WebSocketClient::parser_loop()
+            {
+                util::ScopedThreadRegistration registration("coinbase-parser", book_cpu_);
+                util::log("[WS] Parser thread started");
+
+                const uint8_t *record;
+                size_t size;
+                while (!should_stop_.load(std::memory_order_relaxed))
+                {
+                    if (!receive_ring_.try_peek(record, size))
+                    {
+                        wait_for_messages();
+                        continue;
+                    }
+
+                    uint64_t receive_time;
+                    std::memcpy(&receive_time, record, sizeof(receive_time));
+                    process_received_message(std::string_view(reinterpret_cast<const char *>(record) + sizeof(receive_time),
+                                                              size - sizeof(receive_time)),
+                                             receive_time);
+                    receive_ring_.release();
+                }
+
+                util::log("[WS] Parser thread stopped");
+            }
+
+            // Called by the parser thread after finding the ring empty
+            void WebSocketClient::wait_for_messages()
+            {
+                // A burst usually follows within microseconds; spin briefly before
+                // paying for a sleep and a wakeup. Busy polling never sleeps.
+                for (unsigned int spin = 0; busy_poll_ || spin < 2000; spin++)
+                {
+                    if (!receive_ring_.empty() || should_stop_.load(std::memory_order_relaxed))
+                    {
+                        return;
+                    }
+                    if (busy_poll_ && spin % 1024 == 1023)
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+
+                // Announce the park before the final check; the receive thread publishes
+                // before it reads parser_parked_, so one of the two sees the other
+                std::unique_lock<std::mutex> lock(parser_mutex_);
+                parser_parked_.store(true, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (receive_ring_.empty() && !should_stop_.load())
+                {
+                    parser_cv_.wait_for(lock, std::chrono::milliseconds(100));
+                }
+                parser_parked_.store(false, std::memory_order_relaxed);
+            }
+
+            bool WebSocketClient::enqueue_message(std::string_view message, uint64_t receive_time)
+            {
+                size_t size = sizeof(receive_time) + message.size();
+                if (size > receive_ring_.max_record_size())
+                {
+                    util::log("[ERROR] Dropped a " + std::to_string(message.size()) + " byte message from " + host_ +
+                              ": larger than the parser queue allows");
+                    return true;
+                }
+
+                // A full ring means the parser is behind by RECEIVE_RING_BYTES; only
+                // then does the socket stop being drained
+                uint8_t *slot = receive_ring_.try_reserve(size);
+                if (!slot)
+                {
+                    ring_full_waits_++;
+                    while (!(slot = receive_ring_.try_reserve(size)))
+                    {
+                        if (should_stop_.load(std::memory_order_relaxed))
+                        {
+                            return false;
+                        }
+                        std::this_thread::yield();
+                    }
+                }
+
+                std::memcpy(slot, &receive_time, sizeof(receive_time));
+                std::memcpy(slot + sizeof(receive_time), message.data(), message.size());
+                receive_ring_.commit(size);
+
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (parser_parked_.load(std::memory_order_relaxed))
+                {
+                    std::lock_guard<std::mutex> lock(parser_mutex_);
+                    parser_cv_.notify_one();
+                }
+                return true;
+            }
+
             void WebSocketClient::ping_loop()
             {
+                util::ScopedThreadRegistration registration("coinbase-ping");
                 util::log("[WS] Ping thread started");
 
                 while (!should_stop_.load())
                 {
                     if (connected_.load())
                     {
-                        // Simulate sending ping
-                        messages_sent_++;
+                        send_websocket_frame("", WebSocketFrameDecoder::OPCODE_PING);
                     }
 
-                    std::this_thread::sleep_for(std::chrono::seconds(30));
+                    // Sleep in short steps so disconnect() does not wait out the interval
+                    for (int i = 0; i < 300 && !should_stop_.load(); i++)
+                    {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                    }
                 }
 
                 util::log("[WS] Ping thread stopped");
@@ -250,7 +441,10 @@ namespace open_dtc_server
 
             void WebSocketClient::cleanup_socket()
             {
-                cleanup_ssl();
+                {
+                    std::lock_guard<std::mutex> lock(tls_mutex_);
+                    tls_.close();
+                }
                 if (socket_ != -1)
                 {
 #ifdef _WIN32
@@ -265,8 +459,6 @@ namespace open_dtc_server
             // WebSocket protocol helpers (real implementation)
             bool WebSocketClient::establish_websocket_connection()
             {
-                util::log("[INFO] Note: SSL/TLS support not yet implemented - testing basic TCP connection");
-
                 // Create TCP socket
                 socket_ = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
                 if (socket_ == -1)
@@ -301,14 +493,37 @@ namespace open_dtc_server
 
                 util::log("[INFO] TCP connection established to " + host_ + ":" + std::to_string(port_));
 
-                // Perform WebSocket handshake (will fail without SSL, but tests protocol)
+                // TLS handshake while the socket is still blocking
+                if (use_tls_ && !tls_.connect(socket_, host_, port_))
+                {
+                    cleanup_socket();
+                    return false;
+                }
+
                 if (!perform_websocket_handshake())
                 {
-                    util::log("[INFO] WebSocket handshake failed (expected without SSL/TLS)");
+                    util::log("[ERROR] WebSocket handshake failed");
                     cleanup_socket();
                     return false;
                 }
 
+                // The receive path polls for readiness instead of blocking in recv
+#ifdef _WIN32
+                u_long non_blocking = 1;
+                ioctlsocket(socket_, FIONBIO, &non_blocking);
+#else
+                fcntl(socket_, F_SETFL, fcntl(socket_, F_GETFL, 0) | O_NONBLOCK);
+#endif
+
+#ifdef SO_BUSY_POLL
+                if (socket_busy_poll_us_ > 0 &&
+                    setsockopt(socket_, SOL_SOCKET, SO_BUSY_POLL, &socket_busy_poll_us_, sizeof(socket_busy_poll_us_)) != 0)
+                {
+                    // Raising it above net.core.busy_read needs CAP_NET_ADMIN
+                    util::log("[WARNING] SO_BUSY_POLL not set: " + std::string(std::strerror(errno)));
+                }
+#endif
+
                 util::log("[SUCCESS] WebSocket connection established");
                 return true;
             }
@@ -326,30 +541,39 @@ namespace open_dtc_server
                 request << "Connection: Upgrade\r\n";
                 request << "Sec-WebSocket-Key: " << ws_key << "\r\n";
                 request << "Sec-WebSocket-Version: 13\r\n";
+                if (use_compression_)
+                {
+                    // We only inflate; outgoing subscribe messages are small and sent as is
+                    request << "Sec-WebSocket-Extensions: permessage-deflate; client_max_window_bits\r\n";
+                }
                 request << "\r\n";
 
                 std::string handshake = request.str();
 
-                // Send handshake request via TCP
-                ssize_t sent = send(socket_, handshake.c_str(), handshake.length(), 0);
-                if (sent != (ssize_t)handshake.length())
+                // Send handshake request (the socket is still blocking)
+                if (!send_all(handshake.data(), handshake.size()))
                 {
-                    util::log("[ERROR] Failed to send WebSocket handshake via TCP");
+                    util::log("[ERROR] Failed to send WebSocket handshake");
                     return false;
                 }
 
-                // Read handshake response via TCP
+                // Read handshake response via TCP, up to the blank line ending the headers
+                std::string response;
+                size_t header_end = std::string::npos;
                 char buffer[4096];
-                ssize_t received = recv(socket_, buffer, sizeof(buffer) - 1, 0);
-                if (received <= 0)
+                while (header_end == std::string::npos && response.size() < 64 * 1024)
                 {
-                    util::log("[ERROR] Failed to receive WebSocket handshake response via TCP");
-                    return false;
+                    bool would_block = false;
+                    ptrdiff_t received = transport_receive(buffer, sizeof(buffer), would_block);
+                    if (received <= 0)
+                    {
+                        util::log("[ERROR] Failed to receive WebSocket handshake response");
+                        return false;
+                    }
+                    response.append(buffer, static_cast<size_t>(received));
+                    header_end = response.find("\r\n\r\n");
                 }
 
-                buffer[received] = '\0';
-                std::string response(buffer);
-
                 // Basic validation of handshake response
                 if (response.find("HTTP/1.1 101") == std::string::npos)
                 {
@@ -357,317 +581,468 @@ namespace open_dtc_server
                     return false;
                 }
 
-                util::log("[SUCCESS] WebSocket handshake completed");
-                return true;
-            }
-
-            bool WebSocketClient::send_websocket_frame(const std::string &payload)
-            {
-                if (socket_ == -1 || !connected_.load())
+                // permessage-deflate, if the server took it up
+                std::string_view headers(response.data(), std::min(header_end, response.size()));
+                std::string_view extensions = header_value(headers, "Sec-WebSocket-Extensions");
+                DeflateParameters deflate;
+                bool compressed = !extensions.empty();
+                if (compressed && (!use_compression_ || !parse_permessage_deflate(extensions, deflate)))
                 {
+                    util::log("[ERROR] Server accepted an extension that was not offered: " + std::string(extensions));
                     return false;
                 }
-
-                // Encode WebSocket frame
-                std::string frame = encode_websocket_frame(payload);
-
-                // Send frame via regular TCP (SSL disabled for now)
-                ssize_t sent = send(socket_, frame.c_str(), frame.length(), 0);
-                if (sent != (ssize_t)frame.length())
+                inflater_.end();
+                if (compressed && !inflater_.start(deflate))
                 {
-                    util::log("[ERROR] Failed to send WebSocket frame via TCP");
+                    util::log("[ERROR] Failed to initialize permessage-deflate");
                     return false;
                 }
+                if (compressed)
+                {
+                    util::log("[WS] permessage-deflate negotiated: " + std::string(extensions));
+                }
 
-                messages_sent_++;
+                // Frames the server sent right behind the response belong to the decoder
+                frame_decoder_.reset();
+                frame_decoder_.set_compression(compressed);
+                if (header_end != std::string::npos)
+                {
+                    size_t extra = response.size() - (header_end + 4);
+                    if (extra > frame_decoder_.writable())
+                    {
+                        util::log("[ERROR] Too much data after the WebSocket handshake");
+                        return false;
+                    }
+                    std::memcpy(frame_decoder_.write_position(), response.data() + header_end + 4, extra);
+                    frame_decoder_.commit(extra);
+                }
+
+                util::log("[SUCCESS] WebSocket handshake completed");
                 return true;
             }
 
-            bool WebSocketClient::receive_websocket_frame(std::string &payload)
+            bool WebSocketClient::send_websocket_frame(std::string_view payload, uint8_t opcode)
             {
                 if (socket_ == -1 || !connected_.load())
                 {
-                    payload = "";
                     return false;
                 }
 
-                // Read frame header (minimum 2 bytes)
-                char header[2];
-                ssize_t received = recv(socket_, header, 2, 0);
-                if (received != 2)
+                // The encoder's buffer is shared, so encode under the send lock too
+                std::lock_guard<std::mutex> lock(send_mutex_);
+                std::string_view frame = frame_encoder_.encode(payload, opcode);
+                if (!send_all(frame.data(), frame.size()))
                 {
-                    payload = "";
+                    util::log("[ERROR] Failed to send WebSocket frame");
                     return false;
                 }
 
-                // Parse frame header
-                bool fin = (header[0] & 0x80) != 0;
-                uint8_t opcode = header[0] & 0x0F;
-                bool mask = (header[1] & 0x80) != 0;
-                uint8_t payload_len = header[1] & 0x7F;
+                messages_sent_++;
+                return true;
+            }
 
-                // Handle extended payload length
-                uint64_t extended_len = payload_len;
-                if (payload_len == 126)
-                {
-                    char len_bytes[2];
-                    if (recv(socket_, len_bytes, 2, 0) != 2)
-                        return false;
-                    extended_len = (uint16_t(len_bytes[0]) << 8) | uint8_t(len_bytes[1]);
-                }
-                else if (payload_len == 127)
+            // The socket is non-blocking once connected: wait for room instead of
+            // giving up on a partial send
+            bool WebSocketClient::send_all(const char *data, size_t size)
+            {
+                while (size > 0)
                 {
-                    char len_bytes[8];
-                    if (recv(socket_, len_bytes, 8, 0) != 8)
-                        return false;
-                    extended_len = 0;
-                    for (int i = 0; i < 8; i++)
+                    bool would_block = false;
+                    ptrdiff_t sent = transport_send(data, size, would_block);
+                    if (sent > 0)
                     {
-                        extended_len = (extended_len << 8) | uint8_t(len_bytes[i]);
+                        data += sent;
+                        size -= static_cast<size_t>(sent);
+                        continue;
+                    }
+#ifdef _WIN32
+                    WSAPOLLFD pfd{static_cast<SOCKET>(socket_), POLLOUT, 0};
+                    if (!would_block || WSAPoll(&pfd, 1, 1000) <= 0)
+#else
+                    pollfd pfd{socket_, POLLOUT, 0};
+                    if (!would_block || poll(&pfd, 1, 1000) <= 0)
+#endif
+                    {
+                        return false;
                     }
                 }
+                return true;
+            }
 
-                // Read masking key if present
-                char mask_key[4] = {0};
-                if (mask && recv(socket_, mask_key, 4, 0) != 4)
+            bool WebSocketClient::wait_readable(int timeout_ms)
+            {
+                // Records already pulled into the TLS layer never show up in poll()
+                if (transport_pending())
                 {
-                    return false;
+                    return true;
                 }
+#ifdef _WIN32
+                WSAPOLLFD pfd{static_cast<SOCKET>(socket_), POLLRDNORM, 0};
+                return WSAPoll(&pfd, 1, timeout_ms) > 0;
+#else
+                pollfd pfd{socket_, POLLIN, 0};
+                return poll(&pfd, 1, timeout_ms) > 0;
+#endif
+            }
 
-                // Read payload
-                std::vector<char> buffer(extended_len);
-                if (extended_len > 0)
+            // Read everything the socket has into the frame decoder, many frames per
+            // recv. Returns false once the peer has closed the connection or it failed.
+            bool WebSocketClient::read_available()
+            {
+                for (;;)
                 {
-                    ssize_t total_received = 0;
-                    while (total_received < (ssize_t)extended_len)
+                    uint8_t *destination = frame_decoder_.write_position();
+                    size_t space = frame_decoder_.writable();
+                    if (space == 0)
                     {
-                        ssize_t chunk = recv(socket_, buffer.data() + total_received,
-                                             extended_len - total_received, 0);
-                        if (chunk <= 0)
-                            return false;
-                        total_received += chunk;
+                        return true; // a frame larger than the buffer grows it in process_frames()
                     }
-                }
 
-                // Unmask payload if needed
-                if (mask)
-                {
-                    for (uint64_t i = 0; i < extended_len; i++)
+                    bool would_block = false;
+                    ptrdiff_t received = transport_receive(reinterpret_cast<char *>(destination), space, would_block);
+                    if (received > 0)
                     {
-                        buffer[i] ^= mask_key[i % 4];
+                        frame_decoder_.commit(static_cast<size_t>(received));
+                        if (static_cast<size_t>(received) < space && !transport_pending())
+                        {
+                            return true; // drained; skip the read that would only say EAGAIN
+                        }
+                        continue;
                     }
+                    return would_block;
                 }
-
-                payload = std::string(buffer.begin(), buffer.end());
-                messages_received_++;
-                last_message_time_ = get_current_timestamp();
-
-                return fin && opcode == 0x1; // Text frame
-            } // Message creation and parsing (Coinbase-specific)
-            std::string WebSocketClient::create_subscribe_message(const std::string &channel, const std::string &product_id) const
-            {
-                // TODO: Create Coinbase WebSocket subscription message
-                return "{\"type\":\"subscribe\",\"product_ids\":[\"" + product_id + "\"],\"channels\":[\"" + channel + "\"]}";
             }
 
-            std::string WebSocketClient::create_unsubscribe_message(const std::string &product_id) const
+            // Handle every complete message in the decoder. Returns false on a close
+            // frame or a protocol violation.
+            bool WebSocketClient::process_frames(uint64_t receive_time)
             {
-                // TODO: Create Coinbase WebSocket unsubscription message
-                return "{\"type\":\"unsubscribe\",\"product_ids\":[\"" + product_id + "\"]}";
+                uint8_t opcode;
+                std::string_view payload;
+                for (;;)
+                {
+                    switch (frame_decoder_.next_message(opcode, payload))
+                    {
+                    case WebSocketFrameDecoder::Status::INCOMPLETE:
+                        return true;
+                    case WebSocketFrameDecoder::Status::INVALID:
+                        util::log("[ERROR] Invalid WebSocket frame from " + host_);
+                        return false;
+                    case WebSocketFrameDecoder::Status::MESSAGE:
+                        break;
+                    }
+
+                    messages_received_++;
+                    last_message_time_ = get_current_timestamp();
+
+                    switch (opcode)
+                    {
+                    case WebSocketFrameDecoder::OPCODE_TEXT:
+                        if (frame_decoder_.compressed() && !inflater_.inflate(payload, payload))
+                        {
+                            util::log("[ERROR] Failed to inflate message from " + host_);
+                            return false;
+                        }
+                        if (!payload.empty() && !enqueue_message(payload, receive_time))
+                        {
+                            return true; // stopping
+                        }
+                        break;
+                    case WebSocketFrameDecoder::OPCODE_PING:
+                        send_websocket_frame(payload, WebSocketFrameDecoder::OPCODE_PONG);
+                        break;
+                    case WebSocketFrameDecoder::OPCODE_CLOSE:
+                        send_websocket_frame(payload.substr(0, std::min<size_t>(payload.size(), 2)),
+                                             WebSocketFrameDecoder::OPCODE_CLOSE);
+                        return false;
+                    default:
+                        break; // pong, binary
+                    }
+                }
             }
 
-            void WebSocketClient::process_received_message(const std::string &message)
+            // Message creation and parsing (Coinbase-specific)
+            std::string WebSocketClient::create_subscription_message(const char *type, const std::vector<std::string> &channels,
+                                                                     const std::vector<std::string> &product_ids,
+                                                                     size_t begin, size_t end) const
             {
-                util::log("[WS] Received message: " + message.substr(0, 100) + (message.length() > 100 ? "..." : ""));
-
-                // Simple JSON parsing (looking for type field)
-                if (message.find("\"type\":\"match\"") != std::string::npos)
+                std::string message = "{\"type\":\"";
+                message += type;
+                message += "\",\"product_ids\":[";
+                for (size_t i = begin; i < end; i++)
                 {
-                    parse_trade_message(message);
+                    message += i == begin ? "\"" : ",\"";
+                    message += product_ids[i];
+                    message += '"';
                 }
-                else if (message.find("\"type\":\"l2update\"") != std::string::npos)
+                message += "],\"channels\":[";
+                for (size_t i = 0; i < channels.size(); i++)
                 {
-                    parse_level2_message(message);
+                    message += i == 0 ? "\"" : ",\"";
+                    message += channels[i];
+                    message += '"';
                 }
-                else if (message.find("\"type\":\"subscriptions\"") != std::string::npos)
+                message += "]}";
+                return message;
+            }
+
+            void WebSocketClient::process_received_message(std::string_view message, uint64_t receive_time)
+            {
+                // One pass over the message; fields are views into it, nothing is copied
+                FeedMessage msg;
+                if (!parse_feed_message(message, msg))
                 {
-                    util::log("[WS] Subscription confirmation received");
+                    util::log("[WS] Malformed message: " + std::string(message.substr(0, 50)));
+                    return;
                 }
-                else
+
+                switch (msg.type)
                 {
-                    util::log("[WS] Unknown message type: " + message.substr(0, 50));
+                case FeedMessageType::MATCH:
+                    parse_trade_message(msg, receive_time);
+                    break;
+                case FeedMessageType::L2UPDATE:
+                    parse_level2_message(msg, receive_time);
+                    break;
+                case FeedMessageType::SNAPSHOT:
+                    parse_snapshot_message(msg, receive_time);
+                    break;
+                case FeedMessageType::TICKER:
+                case FeedMessageType::HEARTBEAT:
+                    break;
+                case FeedMessageType::SUBSCRIPTIONS:
+                    util::log("[WS] Subscription confirmation received");
+                    break;
+                case FeedMessageType::ERROR_MESSAGE:
+                    util::log("[ERROR] Coinbase error: " + std::string(msg.message));
+                    break;
+                default:
+                    util::log("[WS] Unknown message type: " + std::string(message.substr(0, 50)));
+                    break;
                 }
             }
 
-            void WebSocketClient::parse_trade_message(const std::string &message)
+            // Missing or malformed numbers read as zero
+            static double parse_decimal(std::string_view field)
             {
-                // Parse Coinbase trade message format:
+                double value = 0.0;
+                util::parse_decimal(field, value);
+                return value;
+            }
+
+            // Exchange time of a message, or when it was received if it has none
+            static uint64_t message_time(const FeedMessage &msg, uint64_t receive_time)
+            {
+                uint64_t exchange_time;
+                return util::parse_iso8601_micros(msg.time, exchange_time) ? exchange_time : receive_time;
+            }
+
+            void WebSocketClient::parse_trade_message(const FeedMessage &msg, uint64_t receive_time)
+            {
+                // Coinbase trade message format:
                 // {"type":"match","trade_id":12345,"sequence":123,"maker_order_id":"...",
                 //  "taker_order_id":"...","time":"2023-01-01T00:00:00.000Z",
                 //  "product_id":"BTC-USD","size":"0.01","price":"50000.00","side":"buy"}
 
-                try
+                // Products we never subscribed to stay INVALID_ID
+                uint32_t symbol_id = util::SymbolTable::symbols().find(msg.product_id);
+                if (!trade_callback_ || symbol_id == util::SymbolTable::INVALID_ID)
                 {
-                    exchanges::base::MarketTrade trade;
+                    return;
+                }
 
-                    // Extract product_id
-                    size_t product_start = message.find("\"product_id\":\"");
-                    if (product_start != std::string::npos)
-                    {
-                        product_start += 14; // length of "product_id":"
-                        size_t product_end = message.find("\"", product_start);
-                        if (product_end != std::string::npos)
-                        {
-                            trade.symbol = message.substr(product_start, product_end - product_start);
-                        }
-                    }
+                // A trade replayed after a resubscribe must not be counted twice
+                uint64_t sequence;
+                if (SequenceTracker::parse(msg.sequence, sequence) &&
+                    trade_sequences_.check(symbol_id, sequence) == SequenceTracker::Result::DUPLICATE)
+                {
+                    duplicates_dropped_++;
+                    return;
+                }
 
-                    // Extract price
-                    size_t price_start = message.find("\"price\":\"");
-                    if (price_start != std::string::npos)
-                    {
-                        price_start += 9; // length of "price":"
-                        size_t price_end = message.find("\"", price_start);
-                        if (price_end != std::string::npos)
-                        {
-                            std::string price_str = message.substr(price_start, price_end - price_start);
-                            trade.price = std::stod(price_str);
-                        }
-                    }
+                exchanges::base::MarketTrade trade;
+                trade.symbol_id = symbol_id;
+                trade.exchange_id = exchange_id_;
+                trade.price = parse_decimal(msg.price);
+                trade.volume = parse_decimal(msg.size);
+                trade.side = std::string(msg.side);
+                trade.timestamp = message_time(msg, receive_time);
+                trade.receive_time = receive_time;
 
-                    // Extract size
-                    size_t size_start = message.find("\"size\":\"");
-                    if (size_start != std::string::npos)
-                    {
-                        size_start += 8; // length of "size":"
-                        size_t size_end = message.find("\"", size_start);
-                        if (size_end != std::string::npos)
-                        {
-                            std::string size_str = message.substr(size_start, size_end - size_start);
-                            trade.volume = std::stod(size_str);
-                        }
-                    }
+                trade_callback_(trade);
+            }
 
-                    // Extract side
-                    size_t side_start = message.find("\"side\":\"");
-                    if (side_start != std::string::npos)
-                    {
-                        side_start += 8; // length of "side":"
-                        size_t side_end = message.find("\"", side_start);
-                        if (side_end != std::string::npos)
-                        {
-                            trade.side = message.substr(side_start, side_end - side_start);
-                        }
-                    }
+            void WebSocketClient::parse_snapshot_message(const FeedMessage &msg, uint64_t receive_time)
+            {
+                // Coinbase level2 snapshot format:
+                // {"type":"snapshot","product_id":"BTC-USD",
+                //  "bids":[["50000.00","1.5"],...],"asks":[["50100.00","2.0"],...]}
 
-                    trade.timestamp = get_current_timestamp();
+                uint32_t symbol_id = util::SymbolTable::symbols().find(msg.product_id);
+                if (symbol_id == util::SymbolTable::INVALID_ID)
+                {
+                    return;
+                }
 
-                    // Call trade callback
-                    if (trade_callback_ && !trade.symbol.empty())
-                    {
-                        std::lock_guard<std::mutex> lock(callback_mutex_);
-                        trade_callback_(trade);
-                    }
+                if (pending_resyncs_.erase(symbol_id))
+                {
+                    util::log("[WS] Order book for " + util::SymbolTable::symbols().name(symbol_id) + " resynchronized");
                 }
-                catch (const std::exception &e)
+
+                exchanges::base::OrderBook &book = books_[symbol_id];
+                depth_update_.symbol_id = symbol_id;
+                depth_update_.is_snapshot = true;
+                depth_update_.changes.clear();
+                book.begin_snapshot();
+                for (auto side : {exchanges::base::BookSide::BID, exchanges::base::BookSide::ASK})
                 {
-                    util::log("[ERROR] Failed to parse trade message: " + std::string(e.what()));
+                    FeedArrayReader levels(side == exchanges::base::BookSide::BID ? msg.bids : msg.asks);
+                    std::string_view fields[2];
+                    while (levels.next(fields, 2) == 2)
+                    {
+                        double price = parse_decimal(fields[0]);
+                        double size = parse_decimal(fields[1]);
+                        book.add_snapshot_level(side, price, size);
+                        if (depth_callback_)
+                        {
+                            depth_update_.changes.push_back(exchanges::base::DepthChange{side, price, size});
+                        }
+                    }
                 }
+                book.end_snapshot();
+
+                util::log("[WS] Order book snapshot for " + util::SymbolTable::symbols().name(symbol_id) + ": " +
+                          std::to_string(book.level_count(exchanges::base::BookSide::BID)) + " bids, " +
+                          std::to_string(book.level_count(exchanges::base::BookSide::ASK)) + " asks");
+                uint64_t timestamp = message_time(msg, receive_time);
+                publish_top_of_book(symbol_id, book, timestamp);
+                publish_depth(timestamp);
             }
 
-            void WebSocketClient::parse_level2_message(const std::string &message)
+            void WebSocketClient::parse_level2_message(const FeedMessage &msg, uint64_t receive_time)
             {
-                // Parse Coinbase level2 update format:
+                // Coinbase level2 update format:
                 // {"type":"l2update","product_id":"BTC-USD","time":"2023-01-01T00:00:00.000Z",
                 //  "changes":[["buy","50000.00","1.0"],["sell","50100.00","2.0"]]}
 
-                try
+                uint32_t symbol_id = util::SymbolTable::symbols().find(msg.product_id);
+                auto book = books_.find(symbol_id);
+                if (book == books_.end())
                 {
-                    exchanges::base::MarketLevel2 level2;
-
-                    // Extract product_id
-                    size_t product_start = message.find("\"product_id\":\"");
-                    if (product_start != std::string::npos)
+                    // Updates before the snapshot cannot be applied. A resync whose
+                    // snapshot never came is asked for again.
+                    auto pending = pending_resyncs_.find(symbol_id);
+                    if (pending != pending_resyncs_.end() && receive_time > pending->second + RESYNC_RETRY_US)
                     {
-                        product_start += 14; // length of "product_id":"
-                        size_t product_end = message.find("\"", product_start);
-                        if (product_end != std::string::npos)
-                        {
-                            level2.symbol = message.substr(product_start, product_end - product_start);
-                        }
+                        request_book_resync(symbol_id, receive_time);
                     }
+                    return;
+                }
 
-                    // For simplified parsing, set sample bid/ask data
-                    // In a real implementation, you would parse the changes array
-                    level2.bid_price = 49900.0 + (rand() % 200);
-                    level2.bid_size = 1.0 + (rand() % 5);
-                    level2.ask_price = 50100.0 + (rand() % 200);
-                    level2.ask_size = 1.0 + (rand() % 5);
-                    level2.timestamp = get_current_timestamp();
+                depth_update_.symbol_id = symbol_id;
+                depth_update_.is_snapshot = false;
+                depth_update_.changes.clear();
 
-                    // Call level2 callback
-                    if (level2_callback_ && !level2.symbol.empty())
+                bool changed = false;
+                FeedArrayReader changes(msg.changes);
+                std::string_view fields[3];
+                while (changes.next(fields, 3) == 3)
+                {
+                    auto side = fields[0] == "buy" ? exchanges::base::BookSide::BID : exchanges::base::BookSide::ASK;
+                    double price = parse_decimal(fields[1]);
+                    double size = parse_decimal(fields[2]);
+                    if (book->second.apply(side, price, size))
                     {
-                        std::lock_guard<std::mutex> lock(callback_mutex_);
-                        level2_callback_(level2);
+                        changed = true;
+                        if (depth_callback_)
+                        {
+                            depth_update_.changes.push_back(exchanges::base::DepthChange{side, price, size});
+                        }
                     }
                 }
-                catch (const std::exception &e)
+
+                // A bid at or above the best ask means the book missed an update that
+                // removed a level, so neither this update nor the book can be trusted
+                const exchanges::base::PriceLevel *bid = book->second.best_bid();
+                const exchanges::base::PriceLevel *ask = book->second.best_ask();
+                if (bid && ask && bid->price >= ask->price)
                 {
-                    util::log("[ERROR] Failed to parse level2 message: " + std::string(e.what()));
+                    request_book_resync(symbol_id, receive_time);
+                    return;
                 }
-            }
 
-            // WebSocket protocol helpers
-            std::string WebSocketClient::create_websocket_handshake() const
-            {
-                // TODO: Create proper WebSocket handshake headers
-                return "";
+                if (changed)
+                {
+                    uint64_t timestamp = message_time(msg, receive_time);
+                    publish_top_of_book(symbol_id, book->second, timestamp);
+                    publish_depth(timestamp);
+                }
             }
 
-            std::string WebSocketClient::encode_websocket_frame(const std::string &payload) const
+            void WebSocketClient::publish_top_of_book(uint32_t symbol_id, exchanges::base::OrderBook &book, uint64_t timestamp)
             {
-                std::vector<uint8_t> frame;
-
-                // Frame header: FIN=1, RSV=000, OPCODE=0001 (text)
-                frame.push_back(0x81);
-
-                // Payload length and masking
-                uint64_t len = payload.length();
-                if (len < 126)
+                bool bid_changed = false;
+                bool ask_changed = false;
+                if (!book.update_top_of_book(bid_changed, ask_changed))
                 {
-                    frame.push_back(0x80 | (uint8_t)len); // MASK=1, payload length
-                }
-                else if (len < 65536)
-                {
-                    frame.push_back(0x80 | 126); // MASK=1, extended length indicator
-                    frame.push_back((len >> 8) & 0xFF);
-                    frame.push_back(len & 0xFF);
-                }
-                else
-                {
-                    frame.push_back(0x80 | 127); // MASK=1, extended length indicator
-                    for (int i = 7; i >= 0; i--)
-                    {
-                        frame.push_back((len >> (i * 8)) & 0xFF);
-                    }
+                    return;
                 }
 
-                // Generate masking key (client must mask data)
-                uint8_t mask_key[4];
-                for (int i = 0; i < 4; i++)
+                const exchanges::base::PriceLevel *bid = book.best_bid();
+                const exchanges::base::PriceLevel *ask = book.best_ask();
+                if (!level2_callback_ || !bid || !ask)
                 {
-                    mask_key[i] = rand() & 0xFF;
-                    frame.push_back(mask_key[i]);
+                    return;
                 }
 
-                // Add masked payload
-                for (size_t i = 0; i < payload.length(); i++)
+                exchanges::base::MarketLevel2 level2;
+                level2.symbol_id = symbol_id;
+                level2.exchange_id = exchange_id_;
+                level2.bid_price = bid->price;
+                level2.bid_size = bid->size;
+                level2.ask_price = ask->price;
+                level2.ask_size = ask->size;
+                level2.timestamp = timestamp;
+                level2.is_bid_change = bid_changed;
+                level2.is_ask_change = ask_changed;
+
+                level2_callback_(level2);
+            }
+
+            // The book missed updates: drop it and resubscribe only this product's
+            // level2 channel, which makes Coinbase send a fresh snapshot. Updates
+            // that arrive before the snapshot are ignored.
+            void WebSocketClient::request_book_resync(uint32_t symbol_id, uint64_t now)
+            {
+                const std::string &product_id = util::SymbolTable::symbols().name(symbol_id);
+                util::log("[WARNING] " + product_id + " order book is inconsistent, requesting a new snapshot");
+
+                books_.erase(symbol_id);
+                pending_resyncs_[symbol_id] = now;
+                book_resyncs_++;
+
+                send_subscription("unsubscribe", {"level2"}, {product_id});
+                send_subscription("subscribe", {"level2"}, {product_id});
+            }
+
+            void WebSocketClient::publish_depth(uint64_t timestamp)
+            {
+                if (!depth_callback_)
                 {
-                    frame.push_back(payload[i] ^ mask_key[i % 4]);
+                    return;
                 }
 
-                return std::string(frame.begin(), frame.end());
+                depth_update_.exchange_id = exchange_id_;
+                depth_update_.timestamp = timestamp;
+
+                depth_callback_(depth_update_);
+            }
+
+            // WebSocket protocol helpers
+            std::string WebSocketClient::create_websocket_handshake() const
+            {
+                // TODO: Create proper WebSocket handshake headers
+                return "";
             }
 
             std::string WebSocketClient::decode_websocket_frame(const std::string &frame) const
@@ -719,63 +1094,55 @@ namespace open_dtc_server
                 return "s3pPLMBiTxaQ9kYGzzhZRbK+xOo=";
             }
 
-#ifdef _WIN32
-            bool WebSocketClient::initialize_ssl()
-            {
-                util::log("[INFO] SSL support not yet implemented - using TCP fallback");
-                return false;
-            }
-
-            bool WebSocketClient::perform_ssl_handshake()
+            bool WebSocketClient::tls_session_reused() const
             {
-                util::log("[INFO] SSL handshake not yet implemented - using TCP fallback");
-                return false;
+                std::lock_guard<std::mutex> lock(tls_mutex_);
+                return tls_.session_reused();
             }
 
-            ssize_t WebSocketClient::ssl_send(const void *data, size_t len)
+            ptrdiff_t WebSocketClient::transport_send(const char *data, size_t size, bool &would_block)
             {
-                // Fallback to regular TCP send for now
-                return send(socket_, static_cast<const char *>(data), static_cast<int>(len), 0);
-            }
-
-            ssize_t WebSocketClient::ssl_receive(void *data, size_t len)
-            {
-                // Fallback to regular TCP receive for now
-                return recv(socket_, static_cast<char *>(data), static_cast<int>(len), 0);
-            }
+                if (use_tls_)
+                {
+                    std::lock_guard<std::mutex> lock(tls_mutex_);
+                    return tls_.write(data, size, would_block);
+                }
 
-            void WebSocketClient::cleanup_ssl()
-            {
-                // Nothing to clean up in stub implementation
-            }
+                ssize_t sent = send(socket_, data, static_cast<int>(size), 0);
+#ifdef _WIN32
+                would_block = sent < 0 && WSAGetLastError() == WSAEWOULDBLOCK;
 #else
-            // Placeholder implementations for non-Windows platforms
-            bool WebSocketClient::initialize_ssl()
-            {
-                util::log("[ERROR] SSL support not implemented for this platform");
-                return false;
-            }
-
-            bool WebSocketClient::perform_ssl_handshake()
-            {
-                util::log("[ERROR] SSL support not implemented for this platform");
-                return false;
+                would_block = sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR);
+#endif
+                return would_block ? 0 : sent;
             }
 
-            ssize_t WebSocketClient::ssl_send(const void *data, size_t len)
+            ptrdiff_t WebSocketClient::transport_receive(char *data, size_t size, bool &would_block)
             {
-                return -1;
-            }
+                if (use_tls_)
+                {
+                    std::lock_guard<std::mutex> lock(tls_mutex_);
+                    return tls_.read(data, size, would_block);
+                }
 
-            ssize_t WebSocketClient::ssl_receive(void *data, size_t len)
-            {
-                return -1;
+                ssize_t received = recv(socket_, data, static_cast<int>(size), 0);
+#ifdef _WIN32
+                would_block = received < 0 && WSAGetLastError() == WSAEWOULDBLOCK;
+#else
+                would_block = received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR);
+#endif
+                return would_block ? 0 : received;
             }
 
-            void WebSocketClient::cleanup_ssl()
+            bool WebSocketClient::transport_pending()
             {
+                if (!use_tls_)
+                {
+                    return false;
+                }
+                std::lock_guard<std::mutex> lock(tls_mutex_);
+                return tls_.has_pending();
             }
-#endif
 
         } // namespace coinbase
     } // namespace feed
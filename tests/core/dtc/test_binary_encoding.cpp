@@ -0,0 +1,239 @@
+#include "coinbase_dtc_core/core/dtc/protocol.hpp"
+#include "coinbase_dtc_core/core/dtc/binary_encoder.hpp"
+#include "coinbase_dtc_core/core/dtc/message_views.hpp"
+#include "coinbase_dtc_core/core/util/log.hpp"
+#include "../../test_check.hpp"
+#include <iostream>
+#include <cstring>
+#include <string>
+
+using namespace open_dtc_server::core::dtc;
+
+template <typename T>
+static T read_field(const uint8_t *data, size_t offset)
+{
+    T value;
+    std::memcpy(&value, data + offset, sizeof(T));
+    return value;
+}
+
+static void test_trade_encoding()
+{
+    std::cout << "\n[TEST] Testing MarketDataUpdateTrade encoding..." << std::endl;
+
+    uint8_t buffer[MAX_ENCODED_MARKET_DATA_SIZE];
+    std::memset(buffer, 0xAB, sizeof(buffer));
+    uint16_t written = encode_trade_update(buffer, sizeof(buffer), 7, 65432.5, 0.025, 1700000000.125,
+                                           wire::AtBidOrAsk::AT_ASK);
+
+    check(written == 40, "Trade update is 40 bytes");
+    check(read_field<uint16_t>(buffer, 0) == 40, "Header size field");
+    check(read_field<uint16_t>(buffer, 2) == static_cast<uint16_t>(MessageType::MARKET_DATA_UPDATE_TRADE), "Header type field");
+    check(read_field<uint32_t>(buffer, 4) == 7, "SymbolID at offset 4");
+    check(read_field<uint16_t>(buffer, 8) == 2, "AtBidOrAsk at offset 8");
+    check(read_field<uint32_t>(buffer, 10) == 0 && read_field<uint16_t>(buffer, 14) == 0, "Padding is zeroed");
+    check(read_field<double>(buffer, 16) == 65432.5, "Price at offset 16");
+    check(read_field<double>(buffer, 24) == 0.025, "Volume at offset 24");
+    check(read_field<double>(buffer, 32) == 1700000000.125, "DateTime at offset 32");
+    check(buffer[40] == 0xAB, "Encoder does not write past the message");
+
+    check(encode_trade_update(buffer, 39, 7, 1.0, 1.0, 0.0) == 0, "Short buffer is rejected");
+
+    // Legacy serialize() path must produce the same bytes
+    MarketDataUpdateTrade trade;
+    trade.symbol_id = 7;
+    trade.at_bid_or_ask = 2;
+    trade.price = 65432.5;
+    trade.volume = 0.025;
+    trade.date_time = 1700000000.125;
+    auto serialized = trade.serialize();
+    encode_trade_update(buffer, sizeof(buffer), trade);
+    check(serialized.size() == 40 && std::memcmp(serialized.data(), buffer, 40) == 0, "serialize() matches encoder output");
+
+    Protocol protocol;
+    auto parsed = protocol.parse_message(serialized.data(), static_cast<uint16_t>(serialized.size()));
+    check(parsed && parsed->get_type() == MessageType::MARKET_DATA_UPDATE_TRADE, "Encoded trade parses");
+    if (parsed)
+    {
+        auto *round_trip = static_cast<MarketDataUpdateTrade *>(parsed.get());
+        check(round_trip->symbol_id == 7 && round_trip->price == 65432.5 && round_trip->volume == 0.025 &&
+                  round_trip->date_time == 1700000000.125,
+              "Trade round trip preserves fields");
+    }
+}
+
+static void test_bid_ask_encoding()
+{
+    std::cout << "\n[TEST] Testing MarketDataUpdateBidAsk encoding..." << std::endl;
+
+    uint8_t buffer[MAX_ENCODED_MARKET_DATA_SIZE];
+    uint16_t written = encode_bid_ask_update(buffer, sizeof(buffer), 3, 65430.0, 1.25f, 65435.0, 0.75f, 1700000000u);
+
+    check(written == 40, "Bid/ask update is 40 bytes");
+    check(read_field<uint16_t>(buffer, 2) == static_cast<uint16_t>(MessageType::MARKET_DATA_UPDATE_BID_ASK), "Header type field");
+    check(read_field<uint32_t>(buffer, 4) == 3, "SymbolID at offset 4");
+    check(read_field<double>(buffer, 8) == 65430.0, "BidPrice at offset 8");
+    check(read_field<float>(buffer, 16) == 1.25f, "BidQuantity at offset 16");
+    check(read_field<double>(buffer, 24) == 65435.0, "AskPrice at offset 24");
+    check(read_field<float>(buffer, 32) == 0.75f, "AskQuantity at offset 32");
+    check(read_field<uint32_t>(buffer, 36) == 1700000000u, "DateTime at offset 36");
+
+    MarketDataUpdateBidAsk decoded;
+    check(decoded.deserialize(buffer, written) && decoded.ask_price == 65435.0 && decoded.bid_quantity == 1.25f,
+          "Bid/ask round trip preserves fields");
+}
+
+static void test_compact_encoding()
+{
+    std::cout << "\n[TEST] Testing compact market data encoding..." << std::endl;
+
+    uint8_t buffer[MAX_ENCODED_MARKET_DATA_SIZE];
+    uint16_t written = encode_trade_update_compact(buffer, sizeof(buffer), 9, 65432.5f, 0.5f, 1700000000u,
+                                                   wire::AtBidOrAsk::AT_BID);
+
+    check(written == 24, "Compact trade update is 24 bytes");
+    check(read_field<uint16_t>(buffer, 2) == static_cast<uint16_t>(MessageType::MARKET_DATA_UPDATE_TRADE_COMPACT), "Header type field");
+    check(read_field<float>(buffer, 4) == 65432.5f, "Price at offset 4");
+    check(read_field<float>(buffer, 8) == 0.5f, "Volume at offset 8");
+    check(read_field<uint32_t>(buffer, 12) == 1700000000u, "DateTime at offset 12");
+    check(read_field<uint32_t>(buffer, 16) == 9, "SymbolID at offset 16");
+    check(read_field<uint16_t>(buffer, 20) == 1, "AtBidOrAsk at offset 20");
+
+    written = encode_bid_ask_update_compact(buffer, sizeof(buffer), 9, 100.25f, 1.5f, 100.5f, 2.5f, 1700000000u);
+    check(written == 28, "Compact bid/ask update is 28 bytes");
+    check(read_field<uint16_t>(buffer, 2) == static_cast<uint16_t>(MessageType::MARKET_DATA_UPDATE_BID_ASK_COMPACT), "Header type field");
+    check(read_field<float>(buffer, 4) == 100.25f && read_field<float>(buffer, 12) == 100.5f, "Bid/ask prices");
+    check(read_field<float>(buffer, 8) == 1.5f && read_field<float>(buffer, 16) == 2.5f, "Bid/ask quantities");
+    check(read_field<uint32_t>(buffer, 24) == 9, "SymbolID at offset 24");
+    check(encode_bid_ask_update_compact(buffer, 27, 9, 1, 1, 1, 1, 0) == 0, "Short buffer is rejected");
+
+    // Negotiated dispatch picks the message family and converts the timestamp
+    written = encode_trade_update(MarketDataEncoding::COMPACT, buffer, sizeof(buffer), 9, 1.0, 2.0,
+                                  1700000000250000ull, wire::AtBidOrAsk::AT_ASK);
+    check(written == 24 && read_field<uint32_t>(buffer, 12) == 1700000000u, "Compact dispatch uses seconds");
+    written = encode_trade_update(MarketDataEncoding::STANDARD, buffer, sizeof(buffer), 9, 1.0, 2.0,
+                                  1700000000250001ull, wire::AtBidOrAsk::AT_ASK);
+    check(written == 40 && read_field<double>(buffer, 32) == 1700000000.250001, "Standard dispatch keeps microseconds");
+    written = encode_bid_ask_update(MarketDataEncoding::COMPACT, buffer, sizeof(buffer), 9, 1.0, 2.0, 3.0, 4.0,
+                                    1700000000000000ull);
+    check(written == 28, "Compact bid/ask dispatch");
+}
+
+static void test_integer_encoding()
+{
+    std::cout << "\n[TEST] Testing integer price market data encoding..." << std::endl;
+
+    int32_t scaled = 0;
+    check(to_integer_price(65432.51, 100, scaled) && scaled == 6543251, "Price is scaled and rounded");
+    check(to_integer_price(0.025, 1000000, scaled) && scaled == 25000, "Volume is scaled and rounded");
+    check(to_integer_price(0.0, 100, scaled) && scaled == 0, "Zero stays representable");
+    check(!to_integer_price(1e12, 100, scaled) && !to_integer_price(-1e12, 100, scaled) &&
+              !to_integer_price(2147.483648, 1000000, scaled),
+          "Out of range values are refused, not clamped");
+    check(!to_integer_price(0.004, 100, scaled), "Nonzero value rounding to 0 is refused");
+
+    uint8_t buffer[MAX_ENCODED_MARKET_DATA_SIZE];
+    IntegerPriceScale scale;
+    scale.price_multiplier = 100;
+    scale.volume_multiplier = 1000000;
+
+    uint16_t written = encode_trade_update(MarketDataEncoding::INTEGER, buffer, sizeof(buffer), 5, 65432.51, 0.025,
+                                           1700000000500000ull, wire::AtBidOrAsk::AT_ASK, scale);
+    check(written == 24, "Integer trade update is 24 bytes");
+    check(read_field<uint16_t>(buffer, 2) == static_cast<uint16_t>(MessageType::MARKET_DATA_UPDATE_TRADE_INT), "Header type field");
+    check(read_field<uint32_t>(buffer, 4) == 5 && read_field<uint16_t>(buffer, 8) == 2, "SymbolID and AtBidOrAsk");
+    check(read_field<int32_t>(buffer, 12) == 6543251, "Price at offset 12");
+    check(read_field<int32_t>(buffer, 16) == 25000, "Volume at offset 16");
+    check(read_field<uint32_t>(buffer, 20) == 1700000000u, "DateTime at offset 20");
+
+    written = encode_bid_ask_update(MarketDataEncoding::INTEGER, buffer, sizeof(buffer), 5, 100.25, 1.5, 100.5, 2.0,
+                                    1700000000000000ull, scale);
+    check(written == 28, "Integer bid/ask update is 28 bytes");
+    check(read_field<uint16_t>(buffer, 2) == static_cast<uint16_t>(MessageType::MARKET_DATA_UPDATE_BID_ASK_INT), "Header type field");
+    check(read_field<int32_t>(buffer, 8) == 10025 && read_field<int32_t>(buffer, 16) == 10050, "Bid/ask prices");
+    check(read_field<int32_t>(buffer, 12) == 1500000 && read_field<int32_t>(buffer, 20) == 2000000, "Bid/ask quantities");
+
+    check(encode_trade_update(MarketDataEncoding::INTEGER, buffer, sizeof(buffer), 5, 65432.51, 5000.0,
+                              1700000000500000ull, wire::AtBidOrAsk::AT_ASK, scale) == 0,
+          "Trade volume beyond the scale is not encoded");
+    check(encode_bid_ask_update(MarketDataEncoding::INTEGER, buffer, sizeof(buffer), 5, 0.00001, 1.5, 100.5, 2.0,
+                                1700000000000000ull, scale) == 0,
+          "Sub-cent bid price at a cent scale is not encoded");
+
+    written = encode_depth_update_int(buffer, sizeof(buffer), 5, wire::AtBidOrAsk::AT_BID, 10025, 1500000,
+                                      wire::MarketDepthUpdateType::MARKET_DEPTH_DELETE_LEVEL, 1700000000.5, 3);
+    check(written == 40, "Integer depth update is 40 bytes");
+    check(read_field<uint16_t>(buffer, 2) == static_cast<uint16_t>(MessageType::MARKET_DEPTH_UPDATE_LEVEL_INT), "Header type field");
+    check(read_field<int32_t>(buffer, 12) == 10025 && read_field<int32_t>(buffer, 16) == 1500000, "Depth price and quantity");
+    check(buffer[20] == 2 && read_field<double>(buffer, 24) == 1700000000.5 && read_field<uint32_t>(buffer, 32) == 3,
+          "Depth update type, time and order count");
+}
+
+static void test_request_views()
+{
+    std::cout << "\n[TEST] Testing zero-copy request views..." << std::endl;
+
+    uint8_t buffer[MAX_ENCODED_MESSAGE_SIZE];
+
+    LogonRequest logon;
+    logon.username = "trader";
+    logon.password = "secret";
+    logon.heartbeat_interval_in_seconds = 30;
+    logon.integer_1 = 5;
+    logon.client_name = "SierraChart";
+    uint16_t written = encode_logon_request(buffer, sizeof(buffer), logon);
+    check(written == sizeof(wire::LogonRequest), "Logon request is 284 bytes");
+
+    LogonRequestView logon_view(buffer, written);
+    check(logon_view.is_valid(), "Logon view accepts logon request");
+    check(logon_view.username() == "trader" && logon_view.password() == "secret", "Logon view reads credentials");
+    check(logon_view.heartbeat_interval_in_seconds() == 30 && logon_view.integer_1() == 5, "Logon view reads integers");
+    check(logon_view.client_name() == "SierraChart", "Logon view reads client name");
+    check(logon_view.username().data() == reinterpret_cast<const char *>(buffer) + offsetof(wire::LogonRequest, username),
+          "Logon view strings point into the receive buffer");
+
+    // Older clients may send a shorter structure; missing fields read as defaults
+    uint16_t truncated_size = offsetof(wire::LogonRequest, integer_1);
+    std::memcpy(buffer, &truncated_size, sizeof(truncated_size));
+    LogonRequestView truncated(buffer, written);
+    check(truncated.is_valid() && truncated.size() == truncated_size, "Truncated logon view uses declared size");
+    check(truncated.username() == "trader" && truncated.integer_1() == 0 && truncated.client_name().empty(),
+          "Fields beyond the declared size read as defaults");
+
+    written = encode_market_data_request(buffer, sizeof(buffer), RequestAction::UNSUBSCRIBE, 42, "BTC-USD", "coinbase");
+    MarketDataRequestView request_view(buffer, written);
+    check(written == sizeof(wire::MarketDataRequest) && request_view.is_valid(), "Market data request view is valid");
+    check(request_view.request_action() == RequestAction::UNSUBSCRIBE && request_view.symbol_id() == 42,
+          "Market data request view reads action and symbol ID");
+    check(request_view.symbol() == "BTC-USD" && request_view.exchange() == "coinbase",
+          "Market data request view reads symbol and exchange");
+    check(!LogonRequestView(buffer, written).is_valid(), "View rejects a message of another type");
+
+    written = encode_heartbeat(buffer, sizeof(buffer), 3, 1700000000);
+    HeartbeatView heartbeat_view(buffer, written);
+    check(heartbeat_view.is_valid() && heartbeat_view.num_drops() == 3 &&
+              heartbeat_view.current_date_time() == 1700000000,
+          "Heartbeat view reads fields");
+
+    check(!HeartbeatView(buffer, 2).is_valid(), "View rejects a buffer shorter than the header");
+}
+
+int main()
+{
+    open_dtc_server::util::log("[TEST] Testing DTC binary encoding...");
+
+    test_trade_encoding();
+    test_bid_ask_encoding();
+    test_compact_encoding();
+    test_integer_encoding();
+    test_request_views();
+
+    if (failures > 0)
+    {
+        std::cout << "\n[ERROR] " << failures << " binary encoding check(s) failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\n[SUCCESS] All DTC binary encoding tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,167 @@
+#include "coinbase_dtc_core/core/dtc/binary_encoder.hpp"
+#include "coinbase_dtc_core/core/dtc/frame_reassembler.hpp"
+#include "coinbase_dtc_core/core/util/log.hpp"
+#include "../../test_check.hpp"
+#include <algorithm>
+#include <iostream>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace open_dtc_server::core::dtc;
+
+// Feed bytes to the reassembler in chunks of at most chunk_size, collecting frame types
+static std::vector<uint16_t> feed(FrameReassembler &reassembler, const std::vector<uint8_t> &stream, size_t chunk_size,
+                                  const uint8_t **last_frame = nullptr)
+{
+    std::vector<uint16_t> types;
+    size_t offset = 0;
+    while (offset < stream.size())
+    {
+        size_t length = std::min({chunk_size, stream.size() - offset, reassembler.writable()});
+        std::memcpy(reassembler.write_position(), stream.data() + offset, length);
+        reassembler.commit(length);
+        offset += length;
+
+        const uint8_t *data;
+        uint16_t size;
+        while (reassembler.next_frame(data, size) == FrameReassembler::Status::FRAME)
+        {
+            uint16_t type;
+            std::memcpy(&type, data + 2, sizeof(type));
+            types.push_back(type);
+            if (last_frame)
+            {
+                *last_frame = data;
+            }
+        }
+    }
+    return types;
+}
+
+static std::vector<uint8_t> build_stream(int heartbeats)
+{
+    std::vector<uint8_t> stream;
+    uint8_t buffer[MAX_ENCODED_MESSAGE_SIZE];
+    for (int i = 0; i < heartbeats; i++)
+    {
+        uint16_t length = encode_heartbeat(buffer, sizeof(buffer), static_cast<uint32_t>(i), 0);
+        stream.insert(stream.end(), buffer, buffer + length);
+
+        if (i % 10 == 0)
+        {
+            length = encode_market_data_request(buffer, sizeof(buffer), RequestAction::SUBSCRIBE, i + 1, "BTC-USD", "");
+            stream.insert(stream.end(), buffer, buffer + length);
+        }
+    }
+    return stream;
+}
+
+static void test_coalesced_frames()
+{
+    std::cout << "\n[TEST] Testing coalesced frames..." << std::endl;
+
+    FrameReassembler reassembler;
+    const uint8_t *last_frame = nullptr;
+    auto stream = build_stream(100);
+    auto types = feed(reassembler, stream, stream.size(), &last_frame);
+
+    check(types.size() == 110, "One read yields every message in the stream");
+    check(types.front() == static_cast<uint16_t>(MessageType::HEARTBEAT) &&
+              types[1] == static_cast<uint16_t>(MessageType::MARKET_DATA_REQUEST),
+          "Frames come out in order");
+    check(reassembler.buffered() == 0, "Nothing is left buffered");
+
+    uint16_t last_type;
+    std::memcpy(&last_type, last_frame + 2, sizeof(last_type));
+    check(last_type == types.back(), "Frames point into the receive buffer");
+}
+
+static void test_partial_frames()
+{
+    std::cout << "\n[TEST] Testing partial frames..." << std::endl;
+
+    auto stream = build_stream(100);
+    for (size_t chunk : {1u, 3u, 7u, 91u, 1000u})
+    {
+        FrameReassembler reassembler;
+        auto types = feed(reassembler, stream, chunk);
+        check(types.size() == 110 && reassembler.buffered() == 0,
+              "Frames split into " + std::to_string(chunk) + "-byte reads are reassembled");
+    }
+
+    FrameReassembler reassembler;
+    uint8_t header[3] = {16, 0, 3};
+    std::memcpy(reassembler.write_position(), header, sizeof(header));
+    reassembler.commit(sizeof(header));
+    const uint8_t *data;
+    uint16_t size;
+    check(reassembler.next_frame(data, size) == FrameReassembler::Status::INCOMPLETE, "Partial header is incomplete");
+}
+
+static void test_compaction()
+{
+    std::cout << "\n[TEST] Testing buffer compaction..." << std::endl;
+
+    // Far more data than the buffer holds, read in chunks that leave partial frames behind
+    std::vector<uint8_t> stream;
+    while (stream.size() < 4 * FrameReassembler::DEFAULT_CAPACITY)
+    {
+        auto chunk = build_stream(100);
+        stream.insert(stream.end(), chunk.begin(), chunk.end());
+    }
+
+    FrameReassembler reassembler;
+    size_t expected = 0;
+    for (size_t offset = 0; offset < stream.size();)
+    {
+        uint16_t size;
+        std::memcpy(&size, stream.data() + offset, sizeof(size));
+        offset += size;
+        expected++;
+    }
+
+    auto types = feed(reassembler, stream, 5000);
+    check(types.size() == expected, "All frames survive compaction");
+    check(reassembler.capacity() == FrameReassembler::DEFAULT_CAPACITY, "Buffer does not grow");
+
+    // Largest possible DTC message still fits
+    std::vector<uint8_t> large(65535, 0);
+    uint16_t large_size = 65535;
+    std::memcpy(large.data(), &large_size, sizeof(large_size));
+    large[2] = 3;
+    types = feed(reassembler, large, 4096);
+    check(types.size() == 1, "Maximum size message is reassembled");
+}
+
+static void test_invalid_header()
+{
+    std::cout << "\n[TEST] Testing invalid header..." << std::endl;
+
+    FrameReassembler reassembler;
+    uint8_t header[4] = {2, 0, 3, 0};
+    std::memcpy(reassembler.write_position(), header, sizeof(header));
+    reassembler.commit(sizeof(header));
+    const uint8_t *data;
+    uint16_t size;
+    check(reassembler.next_frame(data, size) == FrameReassembler::Status::INVALID, "Size smaller than header is invalid");
+}
+
+int main()
+{
+    open_dtc_server::util::log("[TEST] Testing DTC frame reassembly...");
+
+    test_coalesced_frames();
+    test_partial_frames();
+    test_compaction();
+    test_invalid_header();
+
+    if (failures > 0)
+    {
+        std::cout << "\n[ERROR] " << failures << " frame reassembly check(s) failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\n[SUCCESS] All DTC frame reassembly tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,80 @@
+#include "coinbase_dtc_core/core/server/level2_conflator.hpp"
+#include "coinbase_dtc_core/core/util/log.hpp"
+#include "../../test_check.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+
+using coinbase_dtc_core::core::server::Level2Conflator;
+using open_dtc_server::exchanges::base::MarketLevel2;
+
+static MarketLevel2 make_level2(uint32_t symbol_id, double bid_price, double ask_price, bool bid_change, bool ask_change)
+{
+    MarketLevel2 level2;
+    level2.symbol_id = symbol_id;
+    level2.bid_price = bid_price;
+    level2.bid_size = 1.0;
+    level2.ask_price = ask_price;
+    level2.ask_size = 1.0;
+    level2.is_bid_change = bid_change;
+    level2.is_ask_change = ask_change;
+    return level2;
+}
+
+static void test_latest_wins()
+{
+    std::cout << "\n[TEST] Testing latest update per symbol..." << std::endl;
+
+    Level2Conflator conflator;
+    std::vector<MarketLevel2> pending;
+    check(!conflator.has_pending() && conflator.take(pending) == 0, "Nothing pending initially");
+
+    check(conflator.offer(make_level2(5, 100.0, 101.0, true, false)), "First update for a symbol is new");
+    check(conflator.offer(make_level2(2, 10.0, 11.0, true, true)), "Other symbol is independent");
+    check(!conflator.offer(make_level2(5, 100.0, 100.5, false, true)), "Second update replaces the pending one");
+
+    check(conflator.take(pending) == 2 && pending[0].symbol_id == 5 && pending[1].symbol_id == 2,
+          "Symbols are flushed in the order they became pending");
+    check(pending[0].ask_price == 100.5 && pending[0].is_bid_change && pending[0].is_ask_change,
+          "Latest prices with the change flags of both updates");
+    check(!conflator.has_pending() && conflator.take(pending) == 0, "Take empties the conflator");
+    check(conflator.get_conflated_count() == 1, "Replaced update is counted");
+
+    check(conflator.offer(make_level2(5, 99.0, 100.0, false, true)), "Symbol is new again after a flush");
+    conflator.take(pending);
+    check(pending.size() == 1 && !pending[0].is_bid_change, "Flags do not leak across flushes");
+}
+
+static void test_burst_is_bounded()
+{
+    std::cout << "\n[TEST] Testing a burst across a few symbols..." << std::endl;
+
+    Level2Conflator conflator;
+    const int updates = 100000;
+    for (int i = 0; i < updates; i++)
+    {
+        uint32_t symbol = 1 + static_cast<uint32_t>(i % 8);
+        conflator.offer(make_level2(symbol, 100.0 + i, 101.0 + i, true, false));
+    }
+
+    std::vector<MarketLevel2> pending;
+    check(conflator.take(pending) == 8, "One update per symbol regardless of input rate");
+    check(pending[7].symbol_id == 8 && pending[7].bid_price == 100.0 + (updates - 1), "Each symbol keeps its last update");
+}
+
+int main()
+{
+    open_dtc_server::util::log("[TEST] Testing level 2 conflation...");
+
+    test_latest_wins();
+    test_burst_is_bounded();
+
+    if (failures > 0)
+    {
+        std::cout << "\n[ERROR] " << failures << " conflation check(s) failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\n[SUCCESS] All conflation tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,221 @@
+#include "coinbase_dtc_core/core/server/server.hpp"
+#include "coinbase_dtc_core/core/server/outbound_queue.hpp"
+#include "coinbase_dtc_core/core/dtc/binary_encoder.hpp"
+#include "coinbase_dtc_core/core/util/log.hpp"
+#include "../../test_check.hpp"
+#include <iostream>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+using namespace open_dtc_server::core::dtc;
+using coinbase_dtc_core::core::server::ClientConnection;
+using coinbase_dtc_core::core::server::OutboundQueue;
+using coinbase_dtc_core::core::server::SendStatus;
+using coinbase_dtc_core::core::server::SharedMessage;
+using coinbase_dtc_core::core::server::SlowConsumerPolicy;
+
+static std::vector<uint8_t> drain(OutboundQueue &queue)
+{
+    std::vector<uint8_t> bytes;
+    iovec iov[8];
+    size_t count;
+    while ((count = queue.peek(iov, 8)) > 0)
+    {
+        size_t length = 0;
+        for (size_t i = 0; i < count; i++)
+        {
+            auto *base = static_cast<uint8_t *>(iov[i].iov_base);
+            bytes.insert(bytes.end(), base, base + iov[i].iov_len);
+            length += iov[i].iov_len;
+        }
+        queue.consume(length);
+    }
+    return bytes;
+}
+
+static void test_ring_wrap()
+{
+    std::cout << "\n[TEST] Testing outbound ring wrap-around..." << std::endl;
+
+    OutboundQueue queue(100);
+    uint8_t message[40];
+    for (int i = 0; i < 40; i++)
+    {
+        message[i] = static_cast<uint8_t>(i);
+    }
+
+    check(queue.push(message, 40) && queue.push(message, 40), "Two messages fit");
+    check(!queue.push(message, 40), "Third message does not fit");
+
+    iovec iov[8];
+    check(queue.peek(iov, 8) == 1 && iov[0].iov_len == 80, "Contiguous data is one iovec");
+    queue.consume(60);
+    check(queue.push(message, 40), "Freed space is reused");
+    check(queue.peek(iov, 8) == 2 && iov[0].iov_len == 40 && iov[1].iov_len == 20, "Wrapped data is two iovecs");
+
+    auto bytes = drain(queue);
+    check(bytes.size() == 60 && bytes[0] == 20 && bytes[20] == 0 && bytes[59] == 39, "Bytes come out in order");
+    check(queue.empty(), "Queue is empty after draining");
+}
+
+static void test_conflation_slots()
+{
+    std::cout << "\n[TEST] Testing conflation slots..." << std::endl;
+
+    OutboundQueue queue(64);
+    uint8_t filler[64] = {};
+    uint8_t update[8] = {};
+    check(queue.push(filler, 64), "Queue filled");
+
+    update[0] = 1;
+    queue.conflate(7, update, sizeof(update));
+    update[0] = 2;
+    queue.conflate(7, update, sizeof(update));
+    update[0] = 9;
+    queue.conflate(8, update, sizeof(update));
+    check(queue.conflated_count() == 2 && queue.has_conflated(7), "One slot per key");
+
+    queue.consume(64);
+    check(queue.conflated_count() == 0 && queue.size() == 16, "Slots move into the ring as it drains");
+    auto bytes = drain(queue);
+    check(bytes.size() == 16 && bytes[0] == 2 && bytes[8] == 9, "Latest update per key in first-conflated order");
+}
+
+static std::shared_ptr<const SharedMessage> make_shared_bid_ask(double bid)
+{
+    auto message = std::make_shared<SharedMessage>();
+    message->size = encode_bid_ask_update(message->data, sizeof(message->data), 0, bid, 1.0f, 101.0f, 1.0f, 0);
+    message->symbol_id_offset = static_cast<uint16_t>(symbol_id_offset(MessageType::MARKET_DATA_UPDATE_BID_ASK));
+    return message;
+}
+
+static void test_shared_messages()
+{
+    std::cout << "\n[TEST] Testing shared messages..." << std::endl;
+
+    auto message = make_shared_bid_ask(100.0);
+    OutboundQueue first(1024);
+    OutboundQueue second(1024);
+    uint8_t heartbeat[16] = {16, 0, 3, 0};
+
+    check(first.push(heartbeat, sizeof(heartbeat)) && first.push_shared(message, 7), "Shared message queued after inline bytes");
+    check(second.push_shared(message, 42), "Same buffer queued for a second client");
+    check(message.use_count() == 3, "Queues share one encoded buffer");
+    check(first.size() == sizeof(heartbeat) + message->size, "Shared message counts at its wire size");
+
+    // Partial write that ends inside the symbol ID
+    iovec iov[8];
+    first.consume(sizeof(heartbeat) + message->symbol_id_offset + 1);
+    check(first.peek(iov, 8) == 2 && iov[0].iov_len == 3, "Partial write resumes inside the symbol ID");
+
+    auto bytes = drain(second);
+    uint32_t symbol_id;
+    double bid;
+    std::memcpy(&symbol_id, bytes.data() + message->symbol_id_offset, sizeof(symbol_id));
+    std::memcpy(&bid, bytes.data() + 8, sizeof(bid));
+    check(bytes.size() == message->size && symbol_id == 42 && bid == 100.0, "Client's symbol ID is patched into the wire bytes");
+    check(message->data[message->symbol_id_offset] == 0, "Shared buffer is left untouched");
+
+    drain(first);
+    check(message.use_count() == 1, "Queues release the buffer once sent");
+
+    OutboundQueue small(message->size + 8);
+    check(small.push_shared(message, 1) && !small.push_shared(message, 2), "Shared messages count against capacity");
+}
+
+#ifndef _WIN32
+static void test_slow_consumer_policies()
+{
+    std::cout << "\n[TEST] Testing slow consumer policies..." << std::endl;
+
+    uint8_t buffer[MAX_ENCODED_MARKET_DATA_SIZE];
+    uint16_t length = encode_bid_ask_update(buffer, sizeof(buffer), 1, 100.0, 1.0f, 101.0f, 1.0f, 0);
+
+    for (auto policy : {SlowConsumerPolicy::DROP, SlowConsumerPolicy::CONFLATE, SlowConsumerPolicy::DISCONNECT})
+    {
+        int fds[2];
+        socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+        ClientConnection client(fds[0], 1, 4 * length, policy);
+
+        check(client.send_market_data(buffer, length, 1) == SendStatus::NEEDS_FLUSH,
+              "First update asks for a flush");
+        for (int i = 0; i < 3; i++)
+        {
+            client.send_market_data(buffer, length, 1);
+        }
+
+        encode_bid_ask_update(buffer, sizeof(buffer), 1, 200.0, 1.0f, 201.0f, 1.0f, 0);
+        auto status = client.send_market_data(buffer, length, 1);
+        encode_bid_ask_update(buffer, sizeof(buffer), 1, 100.0, 1.0f, 101.0f, 1.0f, 0);
+
+        if (policy == SlowConsumerPolicy::DROP)
+        {
+            check(status == SendStatus::DROPPED && client.take_num_drops() == 1,
+                  "DROP policy drops and counts the update");
+        }
+        else if (policy == SlowConsumerPolicy::CONFLATE)
+        {
+            check(status == SendStatus::QUEUED && client.take_num_drops() == 0,
+                  "CONFLATE policy keeps the latest bid/ask");
+            check(client.send_market_data(buffer, 40) == SendStatus::DROPPED,
+                  "CONFLATE policy drops updates that cannot be conflated");
+
+            check(client.flush_send_queue(), "Flush succeeds");
+            std::vector<uint8_t> received(10 * length);
+            ssize_t total = recv(fds[1], received.data(), received.size(), 0);
+            double last_bid;
+            std::memcpy(&last_bid, received.data() + 4 * length + 8, sizeof(last_bid));
+            check(total == 5 * length && last_bid == 200.0, "Conflated update is sent once the queue drains");
+        }
+        else
+        {
+            check(status == SendStatus::DISCONNECTED && !client.is_connected(),
+                  "DISCONNECT policy closes the connection");
+        }
+
+        close(fds[1]);
+    }
+
+    // A shared update that finds the queue full is conflated with the client's symbol ID
+    int fds[2];
+    socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+    auto message = make_shared_bid_ask(300.0);
+    ClientConnection client(fds[0], 1, message->size, SlowConsumerPolicy::CONFLATE);
+    client.send_market_data(message, 5, 5);
+    check(client.send_market_data(message, 5, 5) == SendStatus::QUEUED, "Full queue conflates shared update");
+    check(client.flush_send_queue(), "Flush succeeds");
+    std::vector<uint8_t> received(4 * message->size);
+    ssize_t total = recv(fds[1], received.data(), received.size(), 0);
+    uint32_t symbol_id;
+    std::memcpy(&symbol_id, received.data() + message->size + message->symbol_id_offset, sizeof(symbol_id));
+    check(total == 2 * message->size && symbol_id == 5, "Conflated copy carries the client's symbol ID");
+    close(fds[1]);
+}
+#endif
+
+int main()
+{
+    open_dtc_server::util::log("[TEST] Testing outbound queue...");
+
+    test_ring_wrap();
+    test_conflation_slots();
+    test_shared_messages();
+#ifndef _WIN32
+    test_slow_consumer_policies();
+#endif
+
+    if (failures > 0)
+    {
+        std::cout << "\n[ERROR] " << failures << " outbound queue check(s) failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\n[SUCCESS] All outbound queue tests passed!" << std::endl;
+    return 0;
+}
@@ -1,11 +1,716 @@
 #include "coinbase_dtc_core/core/server/server.hpp"
+#include "coinbase_dtc_core/core/dtc/binary_encoder.hpp"
 #include "coinbase_dtc_core/core/util/log.hpp"
+#include "coinbase_dtc_core/core/util/symbol_table.hpp"
 #include "coinbase_dtc_core/exchanges/factory/exchange_factory.hpp"
+#include <algorithm>
 #include <iostream>
 #include <thread>
 #include <chrono>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#endif
 
 using namespace open_dtc_server;
+using namespace open_dtc_server::core::dtc;
+using coinbase_dtc_core::core::server::DTCServer;
+using coinbase_dtc_core::core::server::ServerConfig;
+
+#ifndef _WIN32
+static int connect_client(uint16_t port)
+{
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0)
+    {
+        return -1;
+    }
+
+    struct timeval timeout;
+    timeout.tv_sec = 5;
+    timeout.tv_usec = 0;
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    inet_pton(AF_INET, "127.0.0.1", &address.sin_addr);
+    if (connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0)
+    {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static bool receive_exact(int fd, uint8_t *buffer, size_t length)
+{
+    size_t received = 0;
+    while (received < length)
+    {
+        ssize_t result = recv(fd, buffer + received, length - received, 0);
+        if (result <= 0)
+        {
+            return false;
+        }
+        received += static_cast<size_t>(result);
+    }
+    return true;
+}
+
+static bool wait_for(const std::function<bool()> &condition)
+{
+    for (int i = 0; i < 200; i++)
+    {
+        if (condition())
+        {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return false;
+}
+
+static bool test_event_loop_server()
+{
+    util::log("[TEST] Testing epoll server with multiple I/O threads...");
+
+    ServerConfig config;
+    config.bind_address = "127.0.0.1";
+    config.port = 0;
+    config.io_threads = 2;
+    config.io_thread_cpus = {0};
+    DTCServer server(config);
+
+    if (!server.start() || server.get_port() == 0)
+    {
+        util::log("[ERROR] Server failed to start");
+        return false;
+    }
+
+    constexpr int CLIENTS = 8;
+    std::vector<int> sockets;
+    uint8_t buffer[MAX_ENCODED_MESSAGE_SIZE];
+
+    for (int i = 0; i < CLIENTS; i++)
+    {
+        int fd = connect_client(server.get_port());
+        if (fd < 0)
+        {
+            util::log("[ERROR] Client connection failed");
+            return false;
+        }
+        sockets.push_back(fd);
+
+        LogonRequest logon;
+        logon.username = "client" + std::to_string(i);
+        logon.client_name = "test_server";
+        uint16_t length = encode_logon_request(buffer, sizeof(buffer), logon);
+
+        // Split the request across two writes to exercise reassembly
+        send(fd, buffer, 10, 0);
+        send(fd, buffer + 10, length - 10, 0);
+
+        if (!receive_exact(fd, buffer, sizeof(wire::LogonResponse)))
+        {
+            util::log("[ERROR] No logon response");
+            return false;
+        }
+
+        wire::LogonResponse response;
+        std::memcpy(&response, buffer, sizeof(response));
+        if (response.type != static_cast<uint16_t>(MessageType::LOGON_RESPONSE) ||
+            response.result != static_cast<int32_t>(wire::LogonStatus::LOGON_SUCCESS))
+        {
+            util::log("[ERROR] Logon was not accepted");
+            return false;
+        }
+    }
+    util::log("[TEST] ✅ " + std::to_string(CLIENTS) + " clients logged on");
+
+    if (!wait_for([&]()
+                  { return server.get_client_count() == CLIENTS; }))
+    {
+        util::log("[ERROR] Expected " + std::to_string(CLIENTS) + " clients, got " +
+                  std::to_string(server.get_client_count()));
+        return false;
+    }
+
+    // A subscribe without a symbol ID is rejected on the same connection
+    uint16_t length = encode_market_data_request(buffer, sizeof(buffer), RequestAction::SUBSCRIBE, 0, "BTC-USD", "coinbase");
+    send(sockets[0], buffer, length, 0);
+    if (!receive_exact(sockets[0], buffer, sizeof(wire::MarketDataReject)) ||
+        buffer[2] != static_cast<uint8_t>(MessageType::MARKET_DATA_REJECT))
+    {
+        util::log("[ERROR] Expected a market data reject");
+        return false;
+    }
+    util::log("[TEST] ✅ Invalid market data request rejected");
+
+    // So is a symbol the config does not list, without interning it
+    length = encode_market_data_request(buffer, sizeof(buffer), RequestAction::SUBSCRIBE, 5, "UNLISTED-USD", "coinbase");
+    send(sockets[0], buffer, length, 0);
+    if (!receive_exact(sockets[0], buffer, sizeof(wire::MarketDataReject)) ||
+        buffer[2] != static_cast<uint8_t>(MessageType::MARKET_DATA_REJECT) ||
+        util::SymbolTable::symbols().find("UNLISTED-USD") != util::SymbolTable::INVALID_ID ||
+        !server.get_subscribed_symbols().empty())
+    {
+        util::log("[ERROR] Expected unknown symbol to be rejected");
+        return false;
+    }
+    util::log("[TEST] ✅ Unknown symbol rejected");
+
+    // Being in the process-wide symbol table is not enough
+    util::SymbolTable::symbols().intern("ELSEWHERE-USD");
+    length = encode_market_data_request(buffer, sizeof(buffer), RequestAction::SUBSCRIBE, 5, "ELSEWHERE-USD", "coinbase");
+    send(sockets[0], buffer, length, 0);
+    if (!receive_exact(sockets[0], buffer, sizeof(wire::MarketDataReject)) ||
+        buffer[2] != static_cast<uint8_t>(MessageType::MARKET_DATA_REJECT) || !server.get_subscribed_symbols().empty())
+    {
+        util::log("[ERROR] Expected a symbol interned elsewhere but not configured to be rejected");
+        return false;
+    }
+    util::log("[TEST] ✅ Unconfigured symbol rejected");
+
+    close(sockets.back());
+    sockets.pop_back();
+    if (!wait_for([&]()
+                  { return server.get_client_count() == CLIENTS - 1; }))
+    {
+        util::log("[ERROR] Closed client was not removed");
+        return false;
+    }
+    util::log("[TEST] ✅ Disconnected client removed");
+
+    // Both I/O threads report CPU usage; only the first was pinned
+    std::string statistics = server.get_statistics();
+    if (statistics.find("dtc-io-0") == std::string::npos || statistics.find("dtc-io-1") == std::string::npos ||
+        statistics.find("cpu 0") == std::string::npos)
+    {
+        util::log("[ERROR] I/O threads missing from statistics:\n" + statistics);
+        return false;
+    }
+    util::log("[TEST] ✅ Per-thread CPU usage reported");
+
+    for (int fd : sockets)
+    {
+        close(fd);
+    }
+    server.stop();
+    return server.get_client_count() == 0;
+}
+
+// Read one depth message and check its side, price, and either its level
+// (snapshot) or update type (incremental)
+static bool expect_depth(int fd, MessageType type, wire::AtBidOrAsk side, double price, int level_or_update,
+                         uint32_t symbol_id = 7)
+{
+    uint8_t buffer[sizeof(wire::MarketDepthUpdateLevel)];
+    static_assert(sizeof(wire::MarketDepthSnapshotLevel) == sizeof(wire::MarketDepthUpdateLevel),
+                  "depth messages are read with one buffer");
+    if (!receive_exact(fd, buffer, sizeof(buffer)) || buffer[2] != static_cast<uint8_t>(type))
+    {
+        return false;
+    }
+
+    if (type == MessageType::MARKET_DEPTH_SNAPSHOT_LEVEL)
+    {
+        wire::MarketDepthSnapshotLevel message;
+        std::memcpy(&message, buffer, sizeof(message));
+        return message.symbol_id == symbol_id && message.side == static_cast<uint16_t>(side) &&
+               message.price == price && message.level == level_or_update;
+    }
+
+    wire::MarketDepthUpdateLevel message;
+    std::memcpy(&message, buffer, sizeof(message));
+    return message.symbol_id == symbol_id && message.side == static_cast<uint16_t>(side) && message.price == price &&
+           message.update_type == level_or_update;
+}
+
+static bool test_market_depth()
+{
+    using open_dtc_server::exchanges::base::BookSide;
+    using open_dtc_server::exchanges::base::DepthChange;
+    using open_dtc_server::exchanges::base::MarketDepthUpdate;
+
+    util::log("[TEST] Testing market depth snapshot and updates...");
+
+    ServerConfig config;
+    config.bind_address = "127.0.0.1";
+    config.port = 0;
+    config.io_threads = 1;
+    config.symbols = {"DEPTH-USD", "DEPTH-ALT"};
+    DTCServer server(config);
+    if (!server.start())
+    {
+        util::log("[ERROR] Server failed to start");
+        return false;
+    }
+
+    int fd = connect_client(server.get_port());
+    uint8_t buffer[MAX_ENCODED_MESSAGE_SIZE];
+    LogonRequest logon;
+    logon.username = "depth";
+    uint16_t length = encode_logon_request(buffer, sizeof(buffer), logon);
+    send(fd, buffer, length, 0);
+    if (fd < 0 || !receive_exact(fd, buffer, sizeof(wire::LogonResponse)))
+    {
+        util::log("[ERROR] Logon failed");
+        return false;
+    }
+
+    const int INSERT = static_cast<int>(wire::MarketDepthUpdateType::MARKET_DEPTH_INSERT_UPDATE_LEVEL);
+    const int DELETE = static_cast<int>(wire::MarketDepthUpdateType::MARKET_DEPTH_DELETE_LEVEL);
+    const auto SNAPSHOT = MessageType::MARKET_DEPTH_SNAPSHOT_LEVEL;
+    const auto UPDATE = MessageType::MARKET_DEPTH_UPDATE_LEVEL;
+    const auto BID = wire::AtBidOrAsk::AT_BID;
+    const auto ASK = wire::AtBidOrAsk::AT_ASK;
+
+    // A symbol the config does not list is rejected without interning it
+    length = encode_market_depth_request(buffer, sizeof(buffer), RequestAction::SUBSCRIBE, 6, "UNLISTED-USD", "coinbase", 2);
+    send(fd, buffer, length, 0);
+    if (!receive_exact(fd, buffer, sizeof(wire::MarketDepthReject)) ||
+        buffer[2] != static_cast<uint8_t>(MessageType::MARKET_DEPTH_REJECT) ||
+        util::SymbolTable::symbols().find("UNLISTED-USD") != util::SymbolTable::INVALID_ID)
+    {
+        util::log("[ERROR] Expected unknown depth symbol to be rejected");
+        return false;
+    }
+    util::log("[TEST] ✅ Unknown depth symbol rejected");
+
+    // Nothing is known about the book yet: the snapshot is one empty message
+    length = encode_market_depth_request(buffer, sizeof(buffer), RequestAction::SUBSCRIBE, 7, "DEPTH-USD", "coinbase", 2);
+    send(fd, buffer, length, 0);
+    if (!expect_depth(fd, SNAPSHOT, wire::AtBidOrAsk::BID_ASK_UNSET, 0.0, 0))
+    {
+        util::log("[ERROR] Expected an empty depth snapshot");
+        return false;
+    }
+    util::log("[TEST] ✅ Empty book sent as a one-message snapshot");
+
+    MarketDepthUpdate depth;
+    depth.symbol_id = util::SymbolTable::symbols().find("DEPTH-USD");
+    depth.is_snapshot = true;
+    depth.timestamp = 1700000000000000;
+    depth.changes = {{BookSide::BID, 101.0, 1.0}, {BookSide::BID, 100.0, 1.0}, {BookSide::BID, 99.0, 1.0},
+                     {BookSide::ASK, 102.0, 1.0}, {BookSide::ASK, 103.0, 1.0}, {BookSide::ASK, 104.0, 1.0}};
+    server.on_depth_data(depth);
+    if (!expect_depth(fd, SNAPSHOT, BID, 101.0, 0) || !expect_depth(fd, SNAPSHOT, BID, 100.0, 1) ||
+        !expect_depth(fd, SNAPSHOT, ASK, 102.0, 0) || !expect_depth(fd, SNAPSHOT, ASK, 103.0, 1))
+    {
+        util::log("[ERROR] Feed snapshot was not limited to the requested levels");
+        return false;
+    }
+    util::log("[TEST] ✅ Feed snapshot sent up to the requested depth");
+
+    depth.is_snapshot = false;
+    depth.changes = {{BookSide::BID, 101.5, 1.0}, {BookSide::BID, 101.5, 0.0},
+                     {BookSide::ASK, 104.0, 5.0}, {BookSide::ASK, 102.0, 9.0}};
+    server.on_depth_data(depth);
+    if (!expect_depth(fd, UPDATE, BID, 101.5, INSERT) || !expect_depth(fd, UPDATE, BID, 100.0, DELETE))
+    {
+        util::log("[ERROR] Insert did not push the last visible level out");
+        return false;
+    }
+    if (!expect_depth(fd, UPDATE, BID, 101.5, DELETE) || !expect_depth(fd, UPDATE, BID, 100.0, INSERT))
+    {
+        util::log("[ERROR] Delete did not pull the next level in");
+        return false;
+    }
+    if (!expect_depth(fd, UPDATE, ASK, 102.0, INSERT))
+    {
+        util::log("[ERROR] Change outside the requested depth was sent");
+        return false;
+    }
+    util::log("[TEST] ✅ Incremental updates keep the client at its requested depth");
+
+    // Symbol ID 7 now names DEPTH-ALT: DEPTH-USD changes no longer reach the client
+    const auto UNSET = wire::AtBidOrAsk::BID_ASK_UNSET;
+    length = encode_market_depth_request(buffer, sizeof(buffer), RequestAction::SUBSCRIBE, 7, "DEPTH-ALT", "coinbase", 2);
+    send(fd, buffer, length, 0);
+    if (!expect_depth(fd, SNAPSHOT, UNSET, 0.0, 0))
+    {
+        util::log("[ERROR] Expected an empty DEPTH-ALT snapshot");
+        return false;
+    }
+    depth.changes = {{BookSide::BID, 101.8, 1.0}};
+    server.on_depth_data(depth);
+    MarketDepthUpdate alt;
+    alt.symbol_id = util::SymbolTable::symbols().find("DEPTH-ALT");
+    alt.is_snapshot = true;
+    alt.timestamp = 1700000000000000;
+    alt.changes = {{BookSide::BID, 50.0, 1.0}};
+    server.on_depth_data(alt);
+    if (!expect_depth(fd, SNAPSHOT, BID, 50.0, 0))
+    {
+        util::log("[ERROR] Reusing a depth symbol ID left the old symbol subscribed");
+        return false;
+    }
+
+    // DEPTH-ALT again under ID 8: unsubscribing the stale ID 7 leaves it subscribed.
+    // The snapshot request under ID 9 returns once the unsubscribe is handled.
+    length = encode_market_depth_request(buffer, sizeof(buffer), RequestAction::SUBSCRIBE, 8, "DEPTH-ALT", "coinbase", 2);
+    send(fd, buffer, length, 0);
+    length = encode_market_depth_request(buffer, sizeof(buffer), RequestAction::UNSUBSCRIBE, 7, "", "", 0);
+    send(fd, buffer, length, 0);
+    length = encode_market_depth_request(buffer, sizeof(buffer), RequestAction::SNAPSHOT, 9, "DEPTH-ALT", "coinbase", 2);
+    send(fd, buffer, length, 0);
+    if (!expect_depth(fd, SNAPSHOT, BID, 50.0, 0, 8) || !expect_depth(fd, SNAPSHOT, BID, 50.0, 0, 9))
+    {
+        util::log("[ERROR] Expected DEPTH-ALT snapshots under symbol IDs 8 and 9");
+        return false;
+    }
+    alt.is_snapshot = false;
+    alt.changes = {{BookSide::BID, 51.0, 1.0}};
+    server.on_depth_data(alt);
+    if (!expect_depth(fd, UPDATE, BID, 51.0, INSERT, 8))
+    {
+        util::log("[ERROR] Unsubscribing a replaced depth symbol ID dropped its symbol");
+        return false;
+    }
+    util::log("[TEST] ✅ Reused depth symbol IDs replace the old subscription");
+
+    close(fd);
+    server.stop();
+    return true;
+}
+
+static bool test_level2_conflation()
+{
+    util::log("[TEST] Testing bid/ask conflation window...");
+
+    ServerConfig config;
+    config.bind_address = "127.0.0.1";
+    config.port = 0;
+    config.io_threads = 1;
+    config.level2_conflation_interval_ms = 10;
+    config.symbols = {"CONFLATE-USD"};
+    DTCServer server(config);
+    if (!server.start())
+    {
+        util::log("[ERROR] Server failed to start");
+        return false;
+    }
+
+    int fd = connect_client(server.get_port());
+    uint8_t buffer[MAX_ENCODED_MESSAGE_SIZE];
+    LogonRequest logon;
+    logon.username = "conflation";
+    uint16_t length = encode_logon_request(buffer, sizeof(buffer), logon);
+    send(fd, buffer, length, 0);
+    if (fd < 0 || !receive_exact(fd, buffer, sizeof(wire::LogonResponse)))
+    {
+        util::log("[ERROR] Logon failed");
+        return false;
+    }
+
+    length = encode_market_data_request(buffer, sizeof(buffer), RequestAction::SUBSCRIBE, 9, "CONFLATE-USD", "coinbase");
+    send(fd, buffer, length, 0);
+    uint32_t symbol = util::SymbolTable::symbols().find("CONFLATE-USD");
+    if (!wait_for([&]()
+                  { return !server.get_subscribed_symbols().empty(); }))
+    {
+        util::log("[ERROR] Subscription was not registered");
+        return false;
+    }
+
+    const int updates = 5000;
+    open_dtc_server::exchanges::base::MarketLevel2 level2;
+    level2.symbol_id = symbol;
+    level2.ask_price = 200000.0;
+    level2.ask_size = 1.0;
+    level2.bid_size = 1.0;
+    for (int i = 1; i <= updates; i++)
+    {
+        level2.bid_price = 100000.0 + i;
+        server.on_level2_data(level2);
+    }
+
+    int received = 0;
+    wire::MarketDataUpdateBidAsk update{};
+    while (update.bid_price != 100000.0 + updates)
+    {
+        if (!receive_exact(fd, buffer, sizeof(update)) ||
+            buffer[2] != static_cast<uint8_t>(MessageType::MARKET_DATA_UPDATE_BID_ASK))
+        {
+            util::log("[ERROR] Latest bid/ask was not delivered");
+            return false;
+        }
+        std::memcpy(&update, buffer, sizeof(update));
+        received++;
+    }
+
+    util::log("[TEST] " + std::to_string(updates) + " updates delivered as " + std::to_string(received));
+    if (received > updates / 10 || update.symbol_id != 9)
+    {
+        util::log("[ERROR] Updates were not conflated");
+        return false;
+    }
+
+    close(fd);
+    server.stop();
+    return true;
+}
+
+// Receive one trade update
+static bool receive_trade(int fd, wire::MarketDataUpdateTrade &update)
+{
+    uint8_t buffer[sizeof(wire::MarketDataUpdateTrade)];
+    if (!receive_exact(fd, buffer, sizeof(buffer)) ||
+        buffer[2] != static_cast<uint8_t>(MessageType::MARKET_DATA_UPDATE_TRADE))
+    {
+        return false;
+    }
+    std::memcpy(&update, buffer, sizeof(update));
+    return true;
+}
+
+// Receive one trade update and return its DateTime (negative on failure)
+static double receive_trade_date_time(int fd)
+{
+    wire::MarketDataUpdateTrade update;
+    return receive_trade(fd, update) ? update.date_time : -1.0;
+}
+
+static bool test_trade_side()
+{
+    util::log("[TEST] Testing trade AtBidOrAsk...");
+
+    ServerConfig config;
+    config.bind_address = "127.0.0.1";
+    config.port = 0;
+    config.io_threads = 1;
+    config.symbols = {"SIDE-USD"};
+    DTCServer server(config);
+    if (!server.start())
+    {
+        util::log("[ERROR] Server failed to start");
+        return false;
+    }
+
+    int fd = connect_client(server.get_port());
+    uint8_t buffer[MAX_ENCODED_MESSAGE_SIZE];
+    LogonRequest logon;
+    logon.username = "side";
+    uint16_t length = encode_logon_request(buffer, sizeof(buffer), logon);
+    send(fd, buffer, length, 0);
+    if (fd < 0 || !receive_exact(fd, buffer, sizeof(wire::LogonResponse)))
+    {
+        util::log("[ERROR] Logon failed");
+        return false;
+    }
+
+    open_dtc_server::exchanges::base::MarketTrade trade;
+    trade.symbol_id = util::SymbolTable::symbols().find("SIDE-USD");
+    trade.price = 100.0;
+    trade.volume = 1.0;
+    trade.timestamp = 1715694127104523ULL;
+
+    length = encode_market_data_request(buffer, sizeof(buffer), RequestAction::SUBSCRIBE, 12, "SIDE-USD", "coinbase");
+    send(fd, buffer, length, 0);
+    if (!wait_for([&]()
+                  { return !server.get_subscribed_symbols().empty(); }))
+    {
+        util::log("[ERROR] Subscription was not registered");
+        return false;
+    }
+
+    // A Coinbase match's side is the resting (maker) order's side
+    wire::MarketDataUpdateTrade update;
+    trade.side = "buy";
+    server.on_trade_data(trade);
+    if (!receive_trade(fd, update) || update.at_bid_or_ask != static_cast<uint16_t>(wire::AtBidOrAsk::AT_BID))
+    {
+        util::log("[ERROR] Buy-side match was not reported at the bid");
+        return false;
+    }
+    trade.side = "sell";
+    server.on_trade_data(trade);
+    if (!receive_trade(fd, update) || update.at_bid_or_ask != static_cast<uint16_t>(wire::AtBidOrAsk::AT_ASK))
+    {
+        util::log("[ERROR] Sell-side match was not reported at the ask");
+        return false;
+    }
+
+    close(fd);
+    server.stop();
+    util::log("[TEST] ✅ Maker buys trade at the bid, maker sells at the ask");
+    return true;
+}
+
+// Receive one trade update and check which symbol ID and price it carries
+static bool expect_trade(int fd, uint32_t symbol_id, double price)
+{
+    wire::MarketDataUpdateTrade update;
+    return receive_trade(fd, update) && update.symbol_id == symbol_id && update.price == price;
+}
+
+static bool test_symbol_id_reuse()
+{
+    util::log("[TEST] Testing reused market data symbol IDs...");
+
+    ServerConfig config;
+    config.bind_address = "127.0.0.1";
+    config.port = 0;
+    config.io_threads = 1;
+    config.symbols = {"REUSE-A", "REUSE-B"};
+    DTCServer server(config);
+    if (!server.start())
+    {
+        util::log("[ERROR] Server failed to start");
+        return false;
+    }
+
+    int fd = connect_client(server.get_port());
+    uint8_t buffer[MAX_ENCODED_MESSAGE_SIZE];
+    LogonRequest logon;
+    logon.username = "reuse";
+    uint16_t length = encode_logon_request(buffer, sizeof(buffer), logon);
+    send(fd, buffer, length, 0);
+    if (fd < 0 || !receive_exact(fd, buffer, sizeof(wire::LogonResponse)))
+    {
+        util::log("[ERROR] Logon failed");
+        return false;
+    }
+
+    open_dtc_server::exchanges::base::MarketTrade trade_a;
+    trade_a.symbol_id = util::SymbolTable::symbols().find("REUSE-A");
+    trade_a.price = 10.0;
+    trade_a.volume = 1.0;
+    trade_a.side = "buy";
+    open_dtc_server::exchanges::base::MarketTrade trade_b = trade_a;
+    trade_b.symbol_id = util::SymbolTable::symbols().find("REUSE-B");
+    trade_b.price = 20.0;
+
+    auto subscribed_to = [&](std::vector<std::string> symbols)
+    {
+        std::sort(symbols.begin(), symbols.end());
+        return wait_for([&]()
+                        {
+                            auto subscribed = server.get_subscribed_symbols();
+                            std::sort(subscribed.begin(), subscribed.end());
+                            return subscribed == symbols; });
+    };
+
+    // Symbol ID 20 names REUSE-A, then REUSE-B: only REUSE-B trades reach the client
+    length = encode_market_data_request(buffer, sizeof(buffer), RequestAction::SUBSCRIBE, 20, "REUSE-A", "coinbase");
+    send(fd, buffer, length, 0);
+    length = encode_market_data_request(buffer, sizeof(buffer), RequestAction::SUBSCRIBE, 20, "REUSE-B", "coinbase");
+    send(fd, buffer, length, 0);
+    if (!subscribed_to({"REUSE-B"}))
+    {
+        util::log("[ERROR] Reusing a symbol ID left the old symbol subscribed");
+        return false;
+    }
+    server.on_trade_data(trade_a);
+    server.on_trade_data(trade_b);
+    if (!expect_trade(fd, 20, 20.0))
+    {
+        util::log("[ERROR] Expected only the REUSE-B trade under symbol ID 20");
+        return false;
+    }
+
+    // REUSE-B again under ID 21: the stale ID 20 no longer unsubscribes it
+    length = encode_market_data_request(buffer, sizeof(buffer), RequestAction::SUBSCRIBE, 21, "REUSE-B", "coinbase");
+    send(fd, buffer, length, 0);
+    length = encode_market_data_request(buffer, sizeof(buffer), RequestAction::UNSUBSCRIBE, 20, "", "");
+    send(fd, buffer, length, 0);
+    length = encode_market_data_request(buffer, sizeof(buffer), RequestAction::SUBSCRIBE, 22, "REUSE-A", "coinbase");
+    send(fd, buffer, length, 0);
+    if (!subscribed_to({"REUSE-B", "REUSE-A"}))
+    {
+        util::log("[ERROR] Unsubscribing a replaced symbol ID dropped its symbol");
+        return false;
+    }
+    server.on_trade_data(trade_b);
+    if (!expect_trade(fd, 21, 20.0))
+    {
+        util::log("[ERROR] Expected the REUSE-B trade under symbol ID 21");
+        return false;
+    }
+
+    close(fd);
+    server.stop();
+    util::log("[TEST] ✅ Reused symbol IDs replace the old subscription");
+    return true;
+}
+
+static bool test_trade_time_source()
+{
+    using coinbase_dtc_core::core::server::TradeTimeSource;
+
+    util::log("[TEST] Testing trade DateTime sources...");
+
+    open_dtc_server::exchanges::base::MarketTrade trade;
+    trade.price = 100.0;
+    trade.volume = 1.0;
+    trade.side = "buy";
+    trade.timestamp = 1715694127104523ULL;
+    trade.receive_time = 1715694127106001ULL;
+
+    const TradeTimeSource sources[] = {TradeTimeSource::EXCHANGE, TradeTimeSource::RECEIVE, TradeTimeSource::SEND};
+    for (TradeTimeSource source : sources)
+    {
+        ServerConfig config;
+        config.bind_address = "127.0.0.1";
+        config.port = 0;
+        config.io_threads = 1;
+        config.trade_time_source = source;
+        config.symbols = {"TIME-USD"};
+        DTCServer server(config);
+        if (!server.start())
+        {
+            util::log("[ERROR] Server failed to start");
+            return false;
+        }
+
+        int fd = connect_client(server.get_port());
+        uint8_t buffer[MAX_ENCODED_MESSAGE_SIZE];
+        LogonRequest logon;
+        logon.username = "time";
+        uint16_t length = encode_logon_request(buffer, sizeof(buffer), logon);
+        send(fd, buffer, length, 0);
+        if (fd < 0 || !receive_exact(fd, buffer, sizeof(wire::LogonResponse)))
+        {
+            util::log("[ERROR] Logon failed");
+            return false;
+        }
+
+        length = encode_market_data_request(buffer, sizeof(buffer), RequestAction::SUBSCRIBE, 11, "TIME-USD", "coinbase");
+        send(fd, buffer, length, 0);
+        trade.symbol_id = util::SymbolTable::symbols().find("TIME-USD");
+        if (!wait_for([&]()
+                      { return !server.get_subscribed_symbols().empty(); }))
+        {
+            util::log("[ERROR] Subscription was not registered");
+            return false;
+        }
+
+        double before = Protocol::get_current_date_time();
+        server.on_trade_data(trade);
+        double date_time = receive_trade_date_time(fd);
+        bool correct = source == TradeTimeSource::EXCHANGE  ? date_time == 1715694127.104523
+                       : source == TradeTimeSource::RECEIVE ? date_time == 1715694127.106001
+                                                            : date_time >= before && date_time < before + 5.0;
+        if (!correct)
+        {
+            util::log("[ERROR] Unexpected trade DateTime " + std::to_string(date_time));
+            return false;
+        }
+
+        close(fd);
+        server.stop();
+    }
+    util::log("[TEST] ✅ Exchange, receive and send times reach DateTime with microseconds");
+    return true;
+}
+#endif
 
 int main()
 {
@@ -15,10 +720,56 @@ int main()
     {
         // Test 1: Server creation
         {
-            coinbase_dtc_core::core::server::DTCServer dtc_server(11000);
+            ServerConfig config;
+            config.port = 11000;
+            coinbase_dtc_core::core::server::DTCServer dtc_server(config);
             util::log("[TEST] ✅ Server created successfully");
         }
 
+#ifndef _WIN32
+        // Test 2: Accept, logon and disconnect over loopback
+        if (!test_event_loop_server())
+        {
+            return 1;
+        }
+        util::log("[TEST] ✅ Event loop server test passed");
+
+        // Test 3: Market depth served from the server's book
+        if (!test_market_depth())
+        {
+            return 1;
+        }
+        util::log("[TEST] ✅ Market depth test passed");
+
+        // Test 4: Bid/ask bursts are conflated per symbol
+        if (!test_level2_conflation())
+        {
+            return 1;
+        }
+        util::log("[TEST] ✅ Conflation test passed");
+
+        // Test 5: Trade DateTime carries the configured timestamp with sub-second precision
+        if (!test_trade_time_source())
+        {
+            return 1;
+        }
+        util::log("[TEST] ✅ Trade time test passed");
+
+        // Test 6: Trades carry the side of the book they traded against
+        if (!test_trade_side())
+        {
+            return 1;
+        }
+        util::log("[TEST] ✅ Trade side test passed");
+
+        // Test 7: A reused symbol ID or a re-subscribed symbol drops the stale mapping
+        if (!test_symbol_id_reuse())
+        {
+            return 1;
+        }
+        util::log("[TEST] ✅ Symbol ID reuse test passed");
+#endif
+
         util::log("[TEST] All Server tests completed successfully! ✅");
         return 0;
     }
@@ -27,4 +778,4 @@ int main()
         util::log("[ERROR] Server test failed: " + std::string(e.what()));
         return 1;
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,135 @@
+#include "coinbase_dtc_core/core/server/server.hpp"
+#include "coinbase_dtc_core/core/server/subscription_index.hpp"
+#include "coinbase_dtc_core/core/util/log.hpp"
+#include "coinbase_dtc_core/core/util/symbol_table.hpp"
+#include "../../test_check.hpp"
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+
+using open_dtc_server::core::dtc::MarketDataEncoding;
+using coinbase_dtc_core::core::server::ClientConnection;
+using coinbase_dtc_core::core::server::SubscriptionIndex;
+using open_dtc_server::util::SymbolTable;
+
+static void test_symbol_table()
+{
+    std::cout << "\n[TEST] Testing symbol interning..." << std::endl;
+
+    SymbolTable table;
+    uint32_t btc = table.intern("BTC-USD");
+    uint32_t eth = table.intern("ETH-USD");
+    check(btc == 1 && eth == 2, "IDs are dense and start at 1");
+    check(table.intern(std::string("BTC-USD")) == btc && table.size() == 2, "Interning is idempotent");
+
+    std::string message = "{\"product_id\":\"ETH-USD\"}";
+    check(table.find(std::string_view(message).substr(15, 7)) == eth, "Lookup by string_view into a message");
+    check(table.find("SOL-USD") == SymbolTable::INVALID_ID && table.intern("") == SymbolTable::INVALID_ID,
+          "Unknown and empty names have no ID");
+
+    const std::string &name = table.name(btc);
+    for (int i = 0; i < 1000; i++)
+    {
+        table.intern("SYM-" + std::to_string(i));
+    }
+    check(name == "BTC-USD" && table.name(999) == "SYM-996", "Names stay valid as the table grows");
+    check(table.name(SymbolTable::INVALID_ID).empty(), "Invalid ID has an empty name");
+}
+
+static void test_routing()
+{
+    std::cout << "\n[TEST] Testing subscription routing..." << std::endl;
+
+    SubscriptionIndex index;
+    auto first = std::make_shared<ClientConnection>(-1, 1);
+    auto second = std::make_shared<ClientConnection>(-1, 2);
+    SymbolTable::symbols().intern("BTC-USD");
+    SymbolTable::symbols().intern("ETH-USD");
+
+    check(!index.add("UNKNOWN-USD", first, 9, MarketDataEncoding::STANDARD) &&
+              SymbolTable::symbols().find("UNKNOWN-USD") == SymbolTable::INVALID_ID && index.symbols().empty(),
+          "Unknown symbol is neither added nor interned");
+    check(index.add("BTC-USD", first, 10, MarketDataEncoding::STANDARD), "First subscriber is reported");
+    check(!index.add("BTC-USD", second, 20, MarketDataEncoding::COMPACT), "Second subscriber is not");
+    index.add("ETH-USD", second, 21, MarketDataEncoding::COMPACT);
+
+    uint32_t btc = SymbolTable::symbols().find("BTC-USD");
+    uint32_t eth = SymbolTable::symbols().find("ETH-USD");
+    auto subscribers = index.subscribers(btc);
+    check(btc != SymbolTable::INVALID_ID && subscribers && subscribers->size() == 2,
+          "Subscribing routes to both subscribers");
+    check((*subscribers)[1].symbol_id == 20 && (*subscribers)[1].encoding == MarketDataEncoding::COMPACT,
+          "Subscriber carries its own symbol ID and encoding");
+    check(!index.subscribers(SymbolTable::symbols().intern("SOL-USD")), "Symbol without subscribers has no list");
+
+    index.add("BTC-USD", first, 11, MarketDataEncoding::STANDARD);
+    check(index.subscribers(btc)->size() == 2 && (*index.subscribers(btc))[0].symbol_id == 11,
+          "Resubscribing replaces the client's entry");
+
+    index.remove("BTC-USD", first.get());
+    check(subscribers->size() == 2, "Readers keep their snapshot across updates");
+    check(index.subscribers(btc)->size() == 1, "Unsubscribe removes only that client");
+
+    index.remove_client(second.get());
+    check(!index.subscribers(btc) && !index.subscribers(eth) && index.symbols().empty(),
+          "Disconnect removes every subscription of the client");
+    check(index.add("BTC-USD", first, 12, MarketDataEncoding::STANDARD) && SymbolTable::symbols().find("BTC-USD") == btc,
+          "Symbol IDs survive their last subscriber");
+}
+
+static void test_concurrent_readers()
+{
+    std::cout << "\n[TEST] Testing readers during updates..." << std::endl;
+
+    SubscriptionIndex index;
+    std::atomic<bool> done{false};
+    std::atomic<bool> consistent{true};
+    uint32_t btc = SymbolTable::symbols().intern("BTC-USD");
+
+    std::thread reader([&]()
+                       {
+                           while (!done)
+                           {
+                               auto subscribers = index.subscribers(btc);
+                               if (subscribers && subscribers->empty())
+                               {
+                                   consistent = false;
+                               }
+                           } });
+
+    for (int i = 0; i < 1000; i++)
+    {
+        auto client = std::make_shared<ClientConnection>(-1, i);
+        index.add("BTC-USD", client, static_cast<uint32_t>(i + 1), MarketDataEncoding::STANDARD);
+        if (i % 2 == 0)
+        {
+            index.remove_client(client.get());
+        }
+    }
+    done = true;
+    reader.join();
+
+    auto subscribers = index.subscribers(btc);
+    check(consistent, "Readers never observe a partially built list");
+    check(subscribers && subscribers->size() == 500, "All writes are applied");
+}
+
+int main()
+{
+    open_dtc_server::util::log("[TEST] Testing subscription index...");
+
+    test_symbol_table();
+    test_routing();
+    test_concurrent_readers();
+
+    if (failures > 0)
+    {
+        std::cout << "\n[ERROR] " << failures << " subscription index check(s) failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\n[SUCCESS] All subscription index tests passed!" << std::endl;
+    return 0;
+}
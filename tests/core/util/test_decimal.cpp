@@ -0,0 +1,101 @@
+#include "coinbase_dtc_core/core/util/decimal.hpp"
+#include "coinbase_dtc_core/core/util/log.hpp"
+#include "../../test_check.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+using open_dtc_server::util::parse_decimal;
+using open_dtc_server::util::parse_fixed_point;
+
+static bool decimal_is(const std::string &text, double expected)
+{
+    double value = -1.0;
+    return parse_decimal(text, value) && value == expected;
+}
+
+static bool fixed_is(const std::string &text, int scale, int64_t expected)
+{
+    int64_t value = -1;
+    return parse_fixed_point(text, scale, value) && value == expected;
+}
+
+static void test_double()
+{
+    std::cout << "\n[TEST] Testing decimal to double..." << std::endl;
+
+    check(decimal_is("67012.46", 67012.46), "Price");
+    check(decimal_is("0.00310000", 0.0031), "Size with leading and trailing zeros");
+    check(decimal_is("5", 5.0) && decimal_is("0", 0.0) && decimal_is("-2.5", -2.5), "Integer, zero and negative");
+    check(decimal_is("123456789.12345678", 123456789.12345678), "Sixteen digits through the eight-digit path");
+    check(decimal_is("1234567890123456789012", 1234567890123456789012.0), "Long integer falls back");
+    check(decimal_is("0.1234567890123456789012345", 0.1234567890123456789012345), "Long fraction falls back");
+    check(decimal_is("1.5e-3", 0.0015), "Exponent falls back");
+
+    double value = 42.0;
+    check(!parse_decimal("", value) && !parse_decimal("-", value) && !parse_decimal(".", value), "Empty input rejected");
+    check(!parse_decimal("12.3.4", value) && !parse_decimal("12a", value) && !parse_decimal(" 1", value),
+          "Trailing or leading junk rejected");
+    check(value == 42.0, "Value untouched on failure");
+
+    // Every value the fast path accepts must match strtod bit for bit
+    char text[32];
+    int mismatches = 0;
+    uint64_t state = 88172645463325252ULL;
+    for (int i = 0; i < 200000; i++)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        int fraction = static_cast<int>(state % 9);
+        uint64_t mantissa = (state >> 8) % 100000000000000ULL;
+        std::snprintf(text, sizeof(text), "%llu", static_cast<unsigned long long>(mantissa));
+        std::string digits(text);
+        if (fraction > 0 && static_cast<int>(digits.size()) > fraction)
+        {
+            digits.insert(digits.size() - fraction, ".");
+        }
+        double parsed = 0.0;
+        if (!parse_decimal(digits, parsed) || parsed != std::strtod(digits.c_str(), nullptr))
+        {
+            mismatches++;
+        }
+    }
+    check(mismatches == 0, "Random prices match strtod exactly");
+}
+
+static void test_fixed_point()
+{
+    std::cout << "\n[TEST] Testing decimal to fixed point..." << std::endl;
+
+    check(fixed_is("67012.46", 8, 6701246000000LL), "Price scaled by 1e8");
+    check(fixed_is("0.00310000", 8, 310000LL), "Size scaled by 1e8");
+    check(fixed_is("-1.25", 2, -125LL) && fixed_is("7", 0, 7LL), "Negative and unscaled");
+    check(fixed_is("1.50000000000000000000000", 2, 150LL), "Trailing zeros beyond the scale are exact");
+    check(fixed_is("92233720368.54775807", 8, 9223372036854775807LL), "Largest int64");
+
+    int64_t value = 0;
+    check(!parse_fixed_point("0.001", 2, value), "Non-zero digits beyond the scale rejected");
+    check(!parse_fixed_point("92233720368.54775808", 8, value), "Overflow rejected");
+    check(!parse_fixed_point("1e5", 2, value), "Exponent rejected");
+    check(!parse_fixed_point("1.0", 19, value), "Scale out of range rejected");
+}
+
+int main()
+{
+    open_dtc_server::util::log("[TEST] Testing decimal parsing...");
+
+    test_double();
+    test_fixed_point();
+
+    if (failures > 0)
+    {
+        std::cout << "\n[ERROR] " << failures << " decimal check(s) failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\n[SUCCESS] All decimal parsing tests passed!" << std::endl;
+    return 0;
+}
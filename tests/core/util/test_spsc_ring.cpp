@@ -0,0 +1,156 @@
+#include "coinbase_dtc_core/core/util/spsc_ring.hpp"
+#include "coinbase_dtc_core/core/util/log.hpp"
+#include "../../test_check.hpp"
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using open_dtc_server::util::SpscByteRing;
+
+static bool push(SpscByteRing &ring, const std::string &record)
+{
+    uint8_t *slot = ring.try_reserve(record.size());
+    if (!slot)
+    {
+        return false;
+    }
+    std::memcpy(slot, record.data(), record.size());
+    ring.commit(record.size());
+    return true;
+}
+
+static bool pop(SpscByteRing &ring, std::string &record)
+{
+    const uint8_t *data;
+    size_t size;
+    if (!ring.try_peek(data, size))
+    {
+        return false;
+    }
+    record.assign(reinterpret_cast<const char *>(data), size);
+    ring.release();
+    return true;
+}
+
+static void test_single_thread()
+{
+    std::cout << "\n[TEST] Testing ring records..." << std::endl;
+
+    SpscByteRing ring(1000);
+    check(ring.capacity() == 4096, "Capacity rounds up to at least 4 KB");
+    check(ring.empty(), "New ring is empty");
+
+    std::string record;
+    check(!pop(ring, record), "Nothing to read from an empty ring");
+
+    check(push(ring, "hello") && push(ring, "") && push(ring, "world!"), "Records written");
+    check(!ring.empty(), "Ring with records is not empty");
+    check(pop(ring, record) && record == "hello", "First record read back");
+    check(pop(ring, record) && record.empty(), "Empty record read back");
+    check(pop(ring, record) && record == "world!", "Records come out in order");
+    check(ring.empty(), "Ring empty after reading everything");
+
+    check(!ring.try_reserve(ring.max_record_size() + 1), "Oversized record rejected");
+
+    // Fill it up: 1000-byte records take 1008 bytes, so four fit in 4 KB
+    std::string big(1000, 'x');
+    int written = 0;
+    while (push(ring, big))
+    {
+        written++;
+    }
+    check(written == 4, "Full ring refuses more records");
+    check(pop(ring, record) && record == big && push(ring, big), "Reading one makes room for one");
+
+    // Sizes that do not divide the buffer force records to wrap to the start
+    ring.clear();
+    bool ordered = true;
+    for (int i = 0; i < 2000 && ordered; i++)
+    {
+        std::string item = std::to_string(i) + std::string(static_cast<size_t>(i * 37 % 1500), static_cast<char>('a' + i % 26));
+        ordered = push(ring, item) && pop(ring, record) && record == item;
+    }
+    check(ordered, "Records survive wrapping around the buffer");
+
+    // A record as large as max_record_size() fits at any position
+    bool large_fits = true;
+    std::string largest(ring.max_record_size(), 'L');
+    for (size_t offset = 0; offset < 8 && large_fits; offset++)
+    {
+        large_fits = push(ring, std::string(offset * 250, 'p')) && pop(ring, record) &&
+                     push(ring, largest) && pop(ring, record) && record == largest;
+    }
+    check(large_fits, "Largest record fits into an empty ring at any offset");
+}
+
+static void test_two_threads()
+{
+    std::cout << "\n[TEST] Testing producer and consumer threads..." << std::endl;
+
+    constexpr uint32_t COUNT = 200000;
+    SpscByteRing ring(64 * 1024);
+
+    std::thread producer([&]()
+                         {
+                             std::vector<uint8_t> record;
+                             for (uint32_t i = 0; i < COUNT; i++)
+                             {
+                                 // Record i is i % 500 + 4 bytes: the sequence number, then a fill byte
+                                 record.assign(i % 500 + 4, static_cast<uint8_t>(i));
+                                 std::memcpy(record.data(), &i, sizeof(i));
+                                 uint8_t *slot;
+                                 while (!(slot = ring.try_reserve(record.size())))
+                                 {
+                                     std::this_thread::yield();
+                                 }
+                                 std::memcpy(slot, record.data(), record.size());
+                                 ring.commit(record.size());
+                             } });
+
+    bool intact = true;
+    uint32_t received = 0;
+    while (received < COUNT)
+    {
+        const uint8_t *data;
+        size_t size;
+        if (!ring.try_peek(data, size))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        uint32_t sequence;
+        std::memcpy(&sequence, data, sizeof(sequence));
+        intact = intact && sequence == received && size == received % 500 + 4;
+        for (size_t i = sizeof(sequence); i < size && intact; i++)
+        {
+            intact = data[i] == static_cast<uint8_t>(received);
+        }
+        ring.release();
+        received++;
+    }
+    producer.join();
+
+    check(intact && received == COUNT, "Every record arrives once, in order and intact");
+    check(ring.empty(), "Ring drained");
+}
+
+int main()
+{
+    open_dtc_server::util::log("[TEST] Testing SPSC byte ring...");
+
+    test_single_thread();
+    test_two_threads();
+
+    if (failures > 0)
+    {
+        std::cout << "\n[ERROR] " << failures << " SPSC ring check(s) failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\n[SUCCESS] All SPSC ring tests passed!" << std::endl;
+    return 0;
+}
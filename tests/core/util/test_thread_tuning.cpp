@@ -0,0 +1,154 @@
+#include "coinbase_dtc_core/core/util/thread_tuning.hpp"
+#include "coinbase_dtc_core/core/util/log.hpp"
+#include "../../test_check.hpp"
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+using open_dtc_server::util::pin_current_thread;
+using open_dtc_server::util::ScopedThreadRegistration;
+using open_dtc_server::util::ThreadCpuUsage;
+using open_dtc_server::util::ThreadRegistry;
+
+static const ThreadCpuUsage *find_thread(const std::vector<ThreadCpuUsage> &threads, const std::string &name)
+{
+    for (const auto &thread : threads)
+    {
+        if (thread.name == name)
+        {
+            return &thread;
+        }
+    }
+    return nullptr;
+}
+
+// A CPU the test may run on: CPU 0 can be outside a container's or taskset's mask
+static int allowed_cpu()
+{
+#ifdef __linux__
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0)
+    {
+        for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+        {
+            if (CPU_ISSET(cpu, &allowed))
+            {
+                return cpu;
+            }
+        }
+    }
+#endif
+    return 0;
+}
+
+static void test_pinning()
+{
+    std::cout << "\n[TEST] Testing thread pinning..." << std::endl;
+
+    check(!pin_current_thread(-1), "Negative CPU rejected");
+    check(!pin_current_thread(1 << 20), "CPU beyond the machine rejected");
+
+#ifdef __linux__
+    int cpu = allowed_cpu();
+    bool pinned = false;
+    int running_on = -1;
+    std::thread worker([&]()
+                       {
+                           pinned = pin_current_thread(cpu);
+                           running_on = sched_getcpu(); });
+    worker.join();
+    if (pinned)
+    {
+        check(running_on == cpu, "Thread pinned to CPU " + std::to_string(cpu) + " runs there");
+    }
+    else
+    {
+        std::cout << "[SKIP] Pinning to CPU " << cpu << " refused" << std::endl;
+    }
+#endif
+}
+
+static void test_registry()
+{
+    std::cout << "\n[TEST] Testing per-thread CPU usage..." << std::endl;
+
+    int cpu = allowed_cpu();
+    std::atomic<bool> registered{false};
+    std::atomic<bool> pinned{false};
+    std::atomic<bool> release{false};
+    std::thread spinner([&]()
+                        {
+                            ScopedThreadRegistration registration("test-spinner", cpu);
+                            pinned = registration.pinned();
+                            registered = true;
+
+                            // Burn CPU so the usage is measurably above zero
+                            auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds(50);
+                            while (std::chrono::steady_clock::now() < until)
+                            {
+                            }
+                            while (!release)
+                            {
+                                std::this_thread::yield();
+                            } });
+    std::thread sleeper([&]()
+                        {
+                            ScopedThreadRegistration registration("test-sleeper");
+                            while (!release)
+                            {
+                                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                            } });
+
+    while (!registered)
+    {
+        std::this_thread::yield();
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    auto threads = ThreadRegistry::instance().snapshot();
+    const ThreadCpuUsage *spinning = find_thread(threads, "test-spinner");
+    const ThreadCpuUsage *sleeping = find_thread(threads, "test-sleeper");
+    check(spinning && sleeping, "Registered threads are listed");
+    if (spinning && sleeping)
+    {
+        check(spinning->cpu_time_us > 0 && spinning->cpu_time_us >= sleeping->cpu_time_us,
+              "Spinning thread used CPU time");
+        check(spinning->wall_time_us >= spinning->cpu_time_us / 2 && spinning->cpu_percent() > 0.0,
+              "CPU share is computed against wall time");
+        check(sleeping->cpu_percent() < spinning->cpu_percent(), "Sleeping thread uses less CPU than a spinning one");
+        check(spinning->cpu == (pinned ? cpu : -1), "Pinned CPU is reported, or none if pinning was refused");
+        check(sleeping->cpu == -1, "Unpinned thread reports no CPU");
+    }
+
+    release = true;
+    spinner.join();
+    sleeper.join();
+
+    threads = ThreadRegistry::instance().snapshot();
+    check(!find_thread(threads, "test-spinner") && !find_thread(threads, "test-sleeper"),
+          "Threads leave the registry when they exit");
+}
+
+int main()
+{
+    open_dtc_server::util::log("[TEST] Testing thread tuning...");
+
+    test_pinning();
+    test_registry();
+
+    if (failures > 0)
+    {
+        std::cout << "\n[ERROR] " << failures << " thread tuning check(s) failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\n[SUCCESS] All thread tuning tests passed!" << std::endl;
+    return 0;
+}
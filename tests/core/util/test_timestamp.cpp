@@ -0,0 +1,69 @@
+#include "coinbase_dtc_core/core/util/timestamp.hpp"
+#include "coinbase_dtc_core/core/util/log.hpp"
+#include "../../test_check.hpp"
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+using open_dtc_server::util::parse_iso8601_micros;
+
+static bool parses_to(const std::string &text, uint64_t expected)
+{
+    uint64_t micros = 0;
+    return parse_iso8601_micros(text, micros) && micros == expected;
+}
+
+static bool rejected(const std::string &text)
+{
+    uint64_t micros = 42;
+    return !parse_iso8601_micros(text, micros) && micros == 42;
+}
+
+static void test_parse()
+{
+    std::cout << "\n[TEST] Testing ISO-8601 parsing..." << std::endl;
+
+    check(parses_to("1970-01-01T00:00:00Z", 0), "Epoch");
+    check(parses_to("2024-05-14T13:42:07.104523Z", 1715694127104523ULL), "Coinbase time with microseconds");
+    check(parses_to("2024-05-14T13:42:07.1Z", 1715694127100000ULL), "Short fraction is scaled");
+    check(parses_to("2024-05-14T13:42:07.104523999Z", 1715694127104523ULL), "Nanoseconds are truncated");
+    check(parses_to("2024-05-14T13:42:07Z", 1715694127000000ULL), "No fraction");
+    check(parses_to("2024-02-29T23:59:59.999999Z", 1709251199999999ULL), "Leap day");
+    check(parses_to("2000-03-01T00:00:00Z", 951868800000000ULL), "Day after a 400-year leap day");
+    check(parses_to("2024-05-14T15:42:07.5+02:00", 1715694127500000ULL), "Positive offset");
+    check(parses_to("2024-05-14T08:12:07.5-05:30", 1715694127500000ULL), "Negative offset");
+
+    check(rejected("") && rejected("2024-05-14") && rejected("2024-05-14T13:42:07"), "Truncated text");
+    check(rejected("2023-02-29T00:00:00Z") && rejected("2024-13-01T00:00:00Z") && rejected("2024-05-14T24:00:00Z"),
+          "Out of range fields");
+    check(rejected("2024-05-14 13:42:07Z") && rejected("2024-05-14T13:42:07.Z") && rejected("2024-05-14T13:42:07.5ZZ"),
+          "Malformed separators and trailers");
+    check(rejected("1969-12-31T23:59:59Z"), "Before the epoch");
+}
+
+static void test_clock()
+{
+    std::cout << "\n[TEST] Testing clock helpers..." << std::endl;
+
+    uint64_t now = open_dtc_server::util::now_micros();
+    check(now > 1700000000000000ULL, "now_micros() is microseconds since epoch");
+    check(open_dtc_server::util::to_dtc_date_time(1715694127104523ULL) == 1715694127.104523,
+          "DTC date time keeps microseconds");
+}
+
+int main()
+{
+    open_dtc_server::util::log("[TEST] Testing timestamp parsing...");
+
+    test_parse();
+    test_clock();
+
+    if (failures > 0)
+    {
+        std::cout << "\n[ERROR] " << failures << " timestamp check(s) failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\n[SUCCESS] All timestamp tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,175 @@
+#include "coinbase_dtc_core/exchanges/base/order_book.hpp"
+#include "coinbase_dtc_core/core/util/log.hpp"
+#include "../../test_check.hpp"
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+
+using namespace open_dtc_server::exchanges::base;
+
+static void test_snapshot()
+{
+    std::cout << "\n[TEST] Testing order book snapshot..." << std::endl;
+
+    OrderBook book;
+    book.begin_snapshot();
+    book.add_snapshot_level(BookSide::BID, 100.0, 1.0);
+    book.add_snapshot_level(BookSide::BID, 101.0, 2.0);
+    book.add_snapshot_level(BookSide::BID, 99.5, 3.0);
+    book.add_snapshot_level(BookSide::ASK, 103.0, 4.0);
+    book.add_snapshot_level(BookSide::ASK, 102.0, 5.0);
+    book.add_snapshot_level(BookSide::ASK, 104.0, 0.0);
+    book.end_snapshot();
+
+    check(book.best_bid() && book.best_bid()->price == 101.0 && book.best_bid()->size == 2.0, "Best bid is the highest bid");
+    check(book.best_ask() && book.best_ask()->price == 102.0 && book.best_ask()->size == 5.0, "Best ask is the lowest ask");
+    check(book.level_count(BookSide::BID) == 3 && book.level_count(BookSide::ASK) == 2, "Zero-size snapshot levels are skipped");
+
+    PriceLevel levels[5];
+    size_t count = book.depth(BookSide::BID, levels, 5);
+    check(count == 3 && levels[0].price == 101.0 && levels[1].price == 100.0 && levels[2].price == 99.5,
+          "Bid depth is best first");
+    check(book.level(BookSide::ASK, 1)->price == 103.0 && !book.level(BookSide::ASK, 2), "Level lookup by depth index");
+
+    book.begin_snapshot();
+    for (int i = 1; i <= 40; i++)
+    {
+        book.add_snapshot_level(BookSide::BID, 100.0 - i % 4, i);
+    }
+    book.end_snapshot();
+    check(book.level_count(BookSide::BID) == 4 && book.best_bid()->size == 40.0 && book.level(BookSide::BID, 3)->size == 39.0,
+          "Repeated snapshot price keeps its last size");
+
+    book.begin_snapshot();
+    book.end_snapshot();
+    check(book.empty() && !book.best_bid(), "New snapshot replaces the book");
+}
+
+static void test_updates()
+{
+    std::cout << "\n[TEST] Testing order book updates..." << std::endl;
+
+    OrderBook book;
+    check(book.apply(BookSide::BID, 100.0, 1.0), "Insert into empty side");
+    check(book.apply(BookSide::BID, 102.0, 1.0) && book.best_bid()->price == 102.0, "Better price becomes the top");
+    check(book.apply(BookSide::BID, 101.0, 1.0) && book.best_bid()->price == 102.0, "Inner price is inserted below the top");
+    check(!book.apply(BookSide::BID, 101.0, 1.0), "Same size is not a change");
+    check(book.apply(BookSide::BID, 101.0, 7.0) && book.level(BookSide::BID, 1)->size == 7.0, "Size update in place");
+    check(book.apply(BookSide::BID, 102.0, 0.0) && book.best_bid()->price == 101.0, "Deleting the top exposes the next level");
+    check(!book.apply(BookSide::BID, 150.0, 0.0), "Deleting an unknown price is not a change");
+
+    book.apply(BookSide::ASK, 105.0, 1.0);
+    book.apply(BookSide::ASK, 104.0, 2.0);
+    book.apply(BookSide::ASK, 106.0, 3.0);
+    PriceLevel levels[2];
+    check(book.depth(BookSide::ASK, levels, 2) == 2 && levels[0].price == 104.0 && levels[1].price == 105.0,
+          "Ask depth is limited to the requested levels");
+
+    check(book.rank(BookSide::ASK, 104.0) == 0 && book.rank(BookSide::ASK, 106.0) == 2, "Rank of existing levels");
+    check(book.rank(BookSide::ASK, 104.5) == 1 && book.rank(BookSide::ASK, 110.0) == 3 && book.rank(BookSide::BID, 200.0) == 0,
+          "Rank of a price not in the book is where it would be inserted");
+}
+
+static void test_top_of_book_changes()
+{
+    std::cout << "\n[TEST] Testing top of book change detection..." << std::endl;
+
+    OrderBook book;
+    bool bid_changed = false;
+    bool ask_changed = false;
+    check(!book.update_top_of_book(bid_changed, ask_changed), "Empty book has no change");
+
+    book.begin_snapshot();
+    for (int i = 0; i < 50; i++)
+    {
+        book.add_snapshot_level(BookSide::BID, 100.0 - i, 1.0);
+        book.add_snapshot_level(BookSide::ASK, 101.0 + i, 1.0);
+    }
+    book.end_snapshot();
+    check(book.update_top_of_book(bid_changed, ask_changed) && bid_changed && ask_changed, "Snapshot changes both sides");
+
+    book.apply(BookSide::BID, 90.0, 4.0);
+    book.apply(BookSide::ASK, 120.0, 0.0);
+    check(!book.update_top_of_book(bid_changed, ask_changed) && !bid_changed && !ask_changed,
+          "Changes below the top are not a top of book change");
+
+    book.apply(BookSide::ASK, 101.0, 2.0);
+    check(book.update_top_of_book(bid_changed, ask_changed) && !bid_changed && ask_changed, "Best ask size change");
+
+    book.apply(BookSide::BID, 100.5, 1.0);
+    book.apply(BookSide::BID, 100.5, 0.0);
+    check(!book.update_top_of_book(bid_changed, ask_changed), "A level added and removed between checks is no change");
+
+    book.apply(BookSide::BID, 100.0, 0.0);
+    check(book.update_top_of_book(bid_changed, ask_changed) && bid_changed && !ask_changed && book.best_bid()->price == 99.0,
+          "Deleting the best bid changes the bid side only");
+
+    // Random L2 traffic over a deep book: only a small share moves the top
+    std::mt19937 rng(7);
+    std::geometric_distribution<int> distance(0.1);
+    int updates = 10000;
+    int top_changes = 0;
+    for (int i = 0; i < updates; i++)
+    {
+        int ticks = distance(rng);
+        book.apply(BookSide::BID, 99.0 - ticks, 1.0 + (i % 3));
+        top_changes += book.update_top_of_book(bid_changed, ask_changed) ? 1 : 0;
+    }
+    std::cout << "[INFO] " << top_changes << " of " << updates << " updates changed the top of book" << std::endl;
+    check(top_changes * 5 < updates, "Most updates leave the top of book unchanged");
+}
+
+static void test_throughput()
+{
+    std::cout << "\n[TEST] Testing order book throughput..." << std::endl;
+
+    // A deep book with updates clustered near the top, like a busy product
+    OrderBook book;
+    book.begin_snapshot();
+    for (int i = 0; i < 20000; i++)
+    {
+        book.add_snapshot_level(BookSide::BID, 50000.0 - i * 0.01, 1.0);
+        book.add_snapshot_level(BookSide::ASK, 50000.01 + i * 0.01, 1.0);
+    }
+    book.end_snapshot();
+
+    std::mt19937 rng(42);
+    std::geometric_distribution<int> distance(0.05);
+    std::uniform_int_distribution<int> size(0, 4);
+    const int updates = 1000000;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < updates; i++)
+    {
+        BookSide side = (i & 1) ? BookSide::ASK : BookSide::BID;
+        int ticks = distance(rng);
+        double price = side == BookSide::BID ? 50000.0 - ticks * 0.01 : 50000.01 + ticks * 0.01;
+        book.apply(side, price, static_cast<double>(size(rng)));
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double rate = updates / seconds;
+
+    std::cout << "[INFO] " << static_cast<uint64_t>(rate) << " updates/sec" << std::endl;
+    check(rate > 100000.0, "Book keeps up with a busy L2 feed on one core");
+    check(book.best_bid()->price < book.best_ask()->price, "Book stays uncrossed");
+}
+
+int main()
+{
+    open_dtc_server::util::log("[TEST] Testing order book...");
+
+    test_snapshot();
+    test_updates();
+    test_top_of_book_changes();
+    test_throughput();
+
+    if (failures > 0)
+    {
+        std::cout << "\n[ERROR] " << failures << " order book check(s) failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\n[SUCCESS] All order book tests passed!" << std::endl;
+    return 0;
+}
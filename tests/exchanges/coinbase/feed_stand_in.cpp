@@ -0,0 +1,198 @@
+#include "feed_stand_in.hpp"
+#include "coinbase_dtc_core/exchanges/coinbase/frame_decoder.hpp"
+#include <chrono>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#endif
+
+using open_dtc_server::feed::coinbase::WebSocketFrameDecoder;
+
+namespace coinbase_test
+{
+
+    const char *const UPGRADE_RESPONSE = "HTTP/1.1 101 Switching Protocols\r\n"
+                                         "Upgrade: websocket\r\n"
+                                         "Connection: Upgrade\r\n"
+                                         "Sec-WebSocket-Accept: s3pPLMBiTxaQ9kYGzzhZRbK+xOo=\r\n\r\n";
+
+    void close_socket(int fd)
+    {
+#ifdef _WIN32
+        closesocket(fd);
+#else
+        close(fd);
+#endif
+    }
+
+    int listen_on_loopback(int backlog, uint16_t &port)
+    {
+        int fd = static_cast<int>(socket(AF_INET, SOCK_STREAM, IPPROTO_TCP));
+        if (fd < 0)
+        {
+            return -1;
+        }
+
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = 0;
+        socklen_t length = sizeof(address);
+        if (bind(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 ||
+            listen(fd, backlog) != 0 ||
+            getsockname(fd, reinterpret_cast<sockaddr *>(&address), &length) != 0)
+        {
+            close_socket(fd);
+            return -1;
+        }
+        port = ntohs(address.sin_port);
+        return fd;
+    }
+
+    std::string text_frame(const std::string &payload)
+    {
+        std::string out(1, static_cast<char>(0x81));
+        if (payload.size() < 126)
+        {
+            out.push_back(static_cast<char>(payload.size()));
+        }
+        else
+        {
+            out.push_back(static_cast<char>(126));
+            out.push_back(static_cast<char>(payload.size() >> 8));
+            out.push_back(static_cast<char>(payload.size() & 0xFF));
+        }
+        return out + payload;
+    }
+
+    bool FeedStandIn::start()
+    {
+        listen_fd_ = listen_on_loopback(1, port_);
+        if (listen_fd_ == -1)
+        {
+            return false;
+        }
+        thread_ = std::thread([this]()
+                              { serve(); });
+        return true;
+    }
+
+    void FeedStandIn::stop()
+    {
+        if (thread_.joinable())
+        {
+            thread_.join();
+        }
+        if (listen_fd_ != -1)
+        {
+            close_socket(listen_fd_);
+            listen_fd_ = -1;
+        }
+    }
+
+    bool FeedStandIn::send_text(const std::string &payload)
+    {
+        int fd = client_fd_.load();
+        std::string frame = text_frame(payload);
+        return fd != -1 && send(fd, frame.data(), static_cast<int>(frame.size()), 0) == static_cast<int>(frame.size());
+    }
+
+    void FeedStandIn::close_client()
+    {
+        // serve() sees the shutdown as end of stream and closes the socket
+        int fd = client_fd_.load();
+        if (fd != -1)
+        {
+#ifdef _WIN32
+            shutdown(fd, SD_BOTH);
+#else
+            shutdown(fd, SHUT_RDWR);
+#endif
+        }
+    }
+
+    std::vector<std::string> FeedStandIn::messages() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return messages_;
+    }
+
+    std::vector<std::string> FeedStandIn::wait_for_messages(const MessagesPredicate &done) const
+    {
+        for (int i = 0; i < 50; i++)
+        {
+            if (done(messages()))
+            {
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+        return messages();
+    }
+
+    std::vector<std::string> FeedStandIn::wait_for_messages(size_t count) const
+    {
+        return wait_for_messages([count](const std::vector<std::string> &messages)
+                                 { return messages.size() >= count; });
+    }
+
+    void FeedStandIn::serve()
+    {
+        int fd = static_cast<int>(accept(listen_fd_, nullptr, nullptr));
+        if (fd < 0)
+        {
+            return;
+        }
+
+        std::string request;
+        char buffer[4096];
+        while (request.find("\r\n\r\n") == std::string::npos)
+        {
+            int count = static_cast<int>(recv(fd, buffer, sizeof(buffer), 0));
+            if (count <= 0)
+            {
+                close_socket(fd);
+                return;
+            }
+            request.append(buffer, count);
+        }
+
+        // Published before the response, so it is set once the client's connect() returns
+        client_fd_ = fd;
+        send(fd, UPGRADE_RESPONSE, static_cast<int>(std::char_traits<char>::length(UPGRADE_RESPONSE)), 0);
+
+        // Until the client disconnects
+        WebSocketFrameDecoder decoder;
+        while (true)
+        {
+            int count = static_cast<int>(recv(fd, reinterpret_cast<char *>(decoder.write_position()),
+                                              static_cast<int>(decoder.writable()), 0));
+            if (count <= 0)
+            {
+                break;
+            }
+            decoder.commit(static_cast<size_t>(count));
+
+            uint8_t opcode;
+            std::string_view message;
+            while (decoder.next_message(opcode, message) == WebSocketFrameDecoder::Status::MESSAGE)
+            {
+                if (opcode == 0x1) // text; skip the client's pings
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    messages_.emplace_back(message);
+                }
+            }
+        }
+
+        client_fd_ = -1;
+        close_socket(fd);
+    }
+
+} // namespace coinbase_test
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Loopback stand-ins for ws-feed.exchange.coinbase.com shared by the Coinbase
+// client tests. On Windows, construct a WebSocketClient first: it initializes
+// Winsock.
+
+namespace coinbase_test
+{
+
+    // Upgrade response accepting any client key; the client does not check it
+    extern const char *const UPGRADE_RESPONSE;
+
+    void close_socket(int fd);
+
+    /**
+     * Listen on an ephemeral loopback port.
+     * @param port Set to the port chosen
+     * @return Listening socket, or -1 on failure
+     */
+    int listen_on_loopback(int backlog, uint16_t &port);
+
+    /** Unmasked server-to-client text frame */
+    std::string text_frame(const std::string &payload);
+
+    /**
+     * Plain ws:// feed that accepts one client, completes the upgrade and
+     * records every text message the client sends. The test thread sends feed
+     * messages with send_text() once the client is connected.
+     */
+    class FeedStandIn
+    {
+    public:
+        using MessagesPredicate = std::function<bool(const std::vector<std::string> &)>;
+
+        bool start();
+
+        /** Wait for the client to disconnect, then close the listening socket */
+        void stop();
+
+        uint16_t port() const { return port_; }
+
+        /** Send one text frame to the connected client */
+        bool send_text(const std::string &payload);
+
+        /** Close the connection from the feed's side, as a peer close */
+        void close_client();
+
+        /** Client messages received so far, in order */
+        std::vector<std::string> messages() const;
+
+        /** Wait up to 5 s for done(messages) to hold, then return the messages */
+        std::vector<std::string> wait_for_messages(const MessagesPredicate &done) const;
+        std::vector<std::string> wait_for_messages(size_t count) const;
+
+    private:
+        void serve();
+
+        int listen_fd_ = -1;
+        std::atomic<int> client_fd_{-1};
+        uint16_t port_ = 0;
+        mutable std::mutex mutex_;
+        std::vector<std::string> messages_;
+        std::thread thread_;
+    };
+
+} // namespace coinbase_test
@@ -1,5 +1,6 @@
 #include "coinbase_dtc_core/exchanges/coinbase/coinbase_feed.hpp"
 #include "coinbase_dtc_core/core/util/log.hpp"
+#include "coinbase_dtc_core/core/util/symbol_table.hpp"
 #include <iostream>
 #include <thread>
 #include <chrono>
@@ -16,7 +17,7 @@ public:
     void on_trade(const exchanges::base::MarketTrade &trade)
     {
         trade_count++;
-        util::log("[CALLBACK] Trade received: " + trade.symbol + " Price: " + std::to_string(trade.price) +
+        util::log("[CALLBACK] Trade received: " + util::SymbolTable::symbols().name(trade.symbol_id) + " Price: " + std::to_string(trade.price) +
                   " Volume: " + std::to_string(trade.volume) +
                   " Side: " + trade.side);
     }
@@ -24,7 +25,7 @@ public:
     void on_level2(const exchanges::base::MarketLevel2 &level2)
     {
         level2_count++;
-        util::log("[CALLBACK] Level2 received: " + level2.symbol +
+        util::log("[CALLBACK] Level2 received: " + util::SymbolTable::symbols().name(level2.symbol_id) +
                   " Bid: " + std::to_string(level2.bid_price) + "x" + std::to_string(level2.bid_size) +
                   " Ask: " + std::to_string(level2.ask_price) + "x" + std::to_string(level2.ask_size));
     }
@@ -0,0 +1,280 @@
+#include "coinbase_dtc_core/exchanges/coinbase/frame_decoder.hpp"
+#include "coinbase_dtc_core/core/util/log.hpp"
+#include "../../test_check.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+using open_dtc_server::feed::coinbase::WebSocketFrameDecoder;
+
+// Build a server-style frame (optionally masked like a client frame)
+static std::string make_frame(const std::string &payload, uint8_t opcode = WebSocketFrameDecoder::OPCODE_TEXT,
+                              bool fin = true, bool masked = false)
+{
+    std::string frame;
+    frame.push_back(static_cast<char>((fin ? 0x80 : 0x00) | opcode));
+    uint8_t mask_bit = masked ? 0x80 : 0x00;
+    if (payload.size() < 126)
+    {
+        frame.push_back(static_cast<char>(mask_bit | payload.size()));
+    }
+    else if (payload.size() <= 0xFFFF)
+    {
+        frame.push_back(static_cast<char>(mask_bit | 126));
+        frame.push_back(static_cast<char>(payload.size() >> 8));
+        frame.push_back(static_cast<char>(payload.size() & 0xFF));
+    }
+    else
+    {
+        frame.push_back(static_cast<char>(mask_bit | 127));
+        for (int shift = 56; shift >= 0; shift -= 8)
+        {
+            frame.push_back(static_cast<char>((static_cast<uint64_t>(payload.size()) >> shift) & 0xFF));
+        }
+    }
+
+    const uint8_t mask_key[4] = {0x37, 0xFA, 0x21, 0x3D};
+    if (masked)
+    {
+        frame.append(reinterpret_cast<const char *>(mask_key), 4);
+    }
+    for (size_t i = 0; i < payload.size(); i++)
+    {
+        frame.push_back(masked ? static_cast<char>(payload[i] ^ mask_key[i & 3]) : payload[i]);
+    }
+    return frame;
+}
+
+static void feed(WebSocketFrameDecoder &decoder, const std::string &bytes)
+{
+    size_t offset = 0;
+    while (offset < bytes.size())
+    {
+        uint8_t *destination = decoder.write_position();
+        size_t chunk = std::min(decoder.writable(), bytes.size() - offset);
+        std::memcpy(destination, bytes.data() + offset, chunk);
+        decoder.commit(chunk);
+        offset += chunk;
+    }
+}
+
+static bool next_is(WebSocketFrameDecoder &decoder, uint8_t expected_opcode, const std::string &expected_payload)
+{
+    uint8_t opcode = 0;
+    std::string_view payload;
+    return decoder.next_message(opcode, payload) == WebSocketFrameDecoder::Status::MESSAGE &&
+           opcode == expected_opcode && payload == expected_payload;
+}
+
+static bool is_incomplete(WebSocketFrameDecoder &decoder)
+{
+    uint8_t opcode = 0;
+    std::string_view payload;
+    return decoder.next_message(opcode, payload) == WebSocketFrameDecoder::Status::INCOMPLETE;
+}
+
+static bool is_invalid(WebSocketFrameDecoder &decoder)
+{
+    uint8_t opcode = 0;
+    std::string_view payload;
+    return decoder.next_message(opcode, payload) == WebSocketFrameDecoder::Status::INVALID;
+}
+
+static void test_many_frames_per_read()
+{
+    std::cout << "\n[TEST] Testing several frames in one read..." << std::endl;
+
+    WebSocketFrameDecoder decoder;
+    feed(decoder, make_frame("{\"type\":\"match\"}") + make_frame("{\"type\":\"l2update\"}") + make_frame(""));
+
+    check(next_is(decoder, WebSocketFrameDecoder::OPCODE_TEXT, "{\"type\":\"match\"}"), "First frame");
+    check(next_is(decoder, WebSocketFrameDecoder::OPCODE_TEXT, "{\"type\":\"l2update\"}"), "Second frame");
+    check(next_is(decoder, WebSocketFrameDecoder::OPCODE_TEXT, ""), "Empty frame");
+    check(is_incomplete(decoder) && decoder.buffered() == 0, "Buffer drained");
+}
+
+static void test_split_reads()
+{
+    std::cout << "\n[TEST] Testing frames split across reads..." << std::endl;
+
+    WebSocketFrameDecoder decoder;
+    std::string medium(300, 'm');
+    std::string bytes = make_frame("hello") + make_frame(medium);
+
+    bool all_incomplete = true;
+    size_t messages = 0;
+    for (char byte : bytes)
+    {
+        feed(decoder, std::string(1, byte));
+        uint8_t opcode = 0;
+        std::string_view payload;
+        WebSocketFrameDecoder::Status status = decoder.next_message(opcode, payload);
+        if (status == WebSocketFrameDecoder::Status::MESSAGE)
+        {
+            messages++;
+            all_incomplete = all_incomplete && (messages == 1 ? payload == "hello" : payload == medium);
+        }
+        else if (status != WebSocketFrameDecoder::Status::INCOMPLETE)
+        {
+            all_incomplete = false;
+        }
+    }
+    check(messages == 2 && all_incomplete, "Byte-at-a-time delivery yields both messages intact");
+}
+
+static void test_lengths_and_masking()
+{
+    std::cout << "\n[TEST] Testing extended lengths and masking..." << std::endl;
+
+    WebSocketFrameDecoder decoder;
+    std::string length16(1000, 'a');
+    std::string length64(70000, 'b');
+    feed(decoder, make_frame(length16) + make_frame(length64) + make_frame("masked payload", 1, true, true));
+
+    check(next_is(decoder, WebSocketFrameDecoder::OPCODE_TEXT, length16), "16-bit extended length");
+    check(next_is(decoder, WebSocketFrameDecoder::OPCODE_TEXT, length64), "64-bit extended length");
+    check(next_is(decoder, WebSocketFrameDecoder::OPCODE_TEXT, "masked payload"), "Masked payload is unmasked");
+}
+
+static void test_fragmentation()
+{
+    std::cout << "\n[TEST] Testing fragmented messages..." << std::endl;
+
+    WebSocketFrameDecoder decoder;
+    feed(decoder, make_frame("{\"type\":", WebSocketFrameDecoder::OPCODE_TEXT, false) +
+                      make_frame("ping-data", WebSocketFrameDecoder::OPCODE_PING) +
+                      make_frame("\"snapshot\"", WebSocketFrameDecoder::OPCODE_CONTINUATION, false) +
+                      make_frame("}", WebSocketFrameDecoder::OPCODE_CONTINUATION, true));
+
+    check(next_is(decoder, WebSocketFrameDecoder::OPCODE_PING, "ping-data"), "Ping between fragments is returned first");
+    check(next_is(decoder, WebSocketFrameDecoder::OPCODE_TEXT, "{\"type\":\"snapshot\"}"), "Fragments are joined");
+    check(is_incomplete(decoder), "Nothing left after the final fragment");
+}
+
+static void test_growth()
+{
+    std::cout << "\n[TEST] Testing frames larger than the buffer..." << std::endl;
+
+    WebSocketFrameDecoder decoder(WebSocketFrameDecoder::MIN_READ_SIZE);
+    std::string snapshot(200000, 's');
+    std::string bytes = make_frame("before") + make_frame(snapshot) + make_frame("after");
+
+    check(decoder.capacity() == WebSocketFrameDecoder::MIN_READ_SIZE, "Starts at the requested capacity");
+
+    // Deliver like a socket would: only as much as fits, then decode
+    size_t offset = 0;
+    std::string received;
+    while (offset < bytes.size())
+    {
+        uint8_t *destination = decoder.write_position();
+        size_t chunk = std::min(decoder.writable(), bytes.size() - offset);
+        std::memcpy(destination, bytes.data() + offset, chunk);
+        decoder.commit(chunk);
+        offset += chunk;
+
+        uint8_t opcode = 0;
+        std::string_view payload;
+        while (decoder.next_message(opcode, payload) == WebSocketFrameDecoder::Status::MESSAGE)
+        {
+            received += payload.size() == snapshot.size() ? std::string("<snapshot>") : std::string(payload);
+        }
+    }
+    check(received == "before<snapshot>after", "Large frame is reassembled in order");
+    check(decoder.capacity() >= snapshot.size(), "Buffer grew to hold the frame");
+}
+
+static void test_invalid()
+{
+    std::cout << "\n[TEST] Testing protocol violations..." << std::endl;
+
+    WebSocketFrameDecoder rsv;
+    std::string frame = make_frame("x");
+    frame[0] = static_cast<char>(frame[0] | 0x40);
+    feed(rsv, frame);
+    check(is_invalid(rsv), "Reserved bit without a negotiated extension");
+
+    WebSocketFrameDecoder control;
+    feed(control, make_frame(std::string(126, 'p'), WebSocketFrameDecoder::OPCODE_PING));
+    check(is_invalid(control), "Control frame over 125 bytes");
+
+    WebSocketFrameDecoder fragmented_control;
+    feed(fragmented_control, make_frame("p", WebSocketFrameDecoder::OPCODE_PING, false));
+    check(is_invalid(fragmented_control), "Fragmented control frame");
+
+    WebSocketFrameDecoder orphan;
+    feed(orphan, make_frame("tail", WebSocketFrameDecoder::OPCODE_CONTINUATION));
+    check(is_invalid(orphan), "Continuation without a first fragment");
+
+    WebSocketFrameDecoder huge;
+    std::string header = "\x81\x7F";
+    uint64_t length = WebSocketFrameDecoder::MAX_MESSAGE_SIZE + 1;
+    for (int shift = 56; shift >= 0; shift -= 8)
+    {
+        header.push_back(static_cast<char>((length >> shift) & 0xFF));
+    }
+    feed(huge, header);
+    check(is_invalid(huge), "Frame over the message size limit");
+
+    huge.reset();
+    feed(huge, make_frame("ok"));
+    check(next_is(huge, WebSocketFrameDecoder::OPCODE_TEXT, "ok"), "Decoder is usable after reset()");
+}
+
+static std::string with_rsv1(std::string frame)
+{
+    frame[0] = static_cast<char>(frame[0] | 0x40);
+    return frame;
+}
+
+static void test_compression_bit()
+{
+    std::cout << "\n[TEST] Testing the permessage-deflate bit..." << std::endl;
+
+    WebSocketFrameDecoder decoder;
+    decoder.set_compression(true);
+    feed(decoder, with_rsv1(make_frame("deflated")) + make_frame("plain") +
+                      with_rsv1(make_frame("part1", WebSocketFrameDecoder::OPCODE_TEXT, false)) +
+                      make_frame("part2", WebSocketFrameDecoder::OPCODE_CONTINUATION));
+
+    check(next_is(decoder, WebSocketFrameDecoder::OPCODE_TEXT, "deflated") && decoder.compressed(),
+          "RSV1 marks a message compressed");
+    check(next_is(decoder, WebSocketFrameDecoder::OPCODE_TEXT, "plain") && !decoder.compressed(),
+          "Messages without RSV1 stay uncompressed");
+    check(next_is(decoder, WebSocketFrameDecoder::OPCODE_TEXT, "part1part2") && decoder.compressed(),
+          "RSV1 on the first fragment covers the whole message");
+
+    WebSocketFrameDecoder continuation;
+    continuation.set_compression(true);
+    feed(continuation, make_frame("a", WebSocketFrameDecoder::OPCODE_TEXT, false) +
+                           with_rsv1(make_frame("b", WebSocketFrameDecoder::OPCODE_CONTINUATION)));
+    check(is_invalid(continuation), "RSV1 on a continuation frame");
+
+    WebSocketFrameDecoder control;
+    control.set_compression(true);
+    feed(control, with_rsv1(make_frame("p", WebSocketFrameDecoder::OPCODE_PING)));
+    check(is_invalid(control), "RSV1 on a control frame");
+}
+
+int main()
+{
+    open_dtc_server::util::log("[TEST] Testing WebSocket frame decoder...");
+
+    test_many_frames_per_read();
+    test_split_reads();
+    test_lengths_and_masking();
+    test_fragmentation();
+    test_growth();
+    test_invalid();
+    test_compression_bit();
+
+    if (failures > 0)
+    {
+        std::cout << "\n[ERROR] " << failures << " frame decoder check(s) failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\n[SUCCESS] All frame decoder tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,132 @@
+#include "coinbase_dtc_core/exchanges/coinbase/frame_decoder.hpp"
+#include "coinbase_dtc_core/exchanges/coinbase/frame_encoder.hpp"
+#include "coinbase_dtc_core/exchanges/coinbase/frame_mask.hpp"
+#include "coinbase_dtc_core/core/util/log.hpp"
+#include "../../test_check.hpp"
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using open_dtc_server::feed::coinbase::mask_websocket_payload;
+using open_dtc_server::feed::coinbase::WebSocketFrameDecoder;
+using open_dtc_server::feed::coinbase::WebSocketFrameEncoder;
+
+static const uint8_t MASK_KEY[4] = {0x37, 0xFA, 0x21, 0x3D};
+
+static std::vector<uint8_t> pattern(size_t size)
+{
+    std::vector<uint8_t> bytes(size);
+    for (size_t i = 0; i < size; i++)
+    {
+        bytes[i] = static_cast<uint8_t>(i * 31 + 7);
+    }
+    return bytes;
+}
+
+static void test_mask()
+{
+    std::cout << "\n[TEST] Testing payload masking..." << std::endl;
+
+    // Every size around the 8/16/32-byte block boundaries, from unaligned addresses
+    bool copy_ok = true;
+    bool in_place_ok = true;
+    for (size_t offset = 0; offset < 4; offset++)
+    {
+        for (size_t size = 0; size <= 100; size++)
+        {
+            std::vector<uint8_t> source = pattern(size + offset);
+            std::vector<uint8_t> out(size + offset, 0);
+            const uint8_t *in = source.data() + offset;
+
+            mask_websocket_payload(out.data() + offset, in, size, MASK_KEY);
+            for (size_t i = 0; i < size; i++)
+            {
+                copy_ok = copy_ok && out[offset + i] == (in[i] ^ MASK_KEY[i & 3]);
+            }
+
+            std::vector<uint8_t> in_place = source;
+            mask_websocket_payload(in_place.data() + offset, in_place.data() + offset, size, MASK_KEY);
+            mask_websocket_payload(in_place.data() + offset, in_place.data() + offset, size, MASK_KEY);
+            in_place_ok = in_place_ok && in_place == source;
+        }
+    }
+    check(copy_ok, "Masked copy matches the byte-wise definition");
+    check(in_place_ok, "Masking twice in place restores the payload");
+}
+
+static void test_encode()
+{
+    std::cout << "\n[TEST] Testing frame encoding..." << std::endl;
+
+    WebSocketFrameEncoder encoder;
+    std::string_view frame = encoder.encode("Hello", WebSocketFrameDecoder::OPCODE_TEXT, MASK_KEY);
+    const uint8_t expected[] = {0x81, 0x85, 0x37, 0xFA, 0x21, 0x3D, 'H' ^ 0x37, 'e' ^ 0xFA, 'l' ^ 0x21, 'l' ^ 0x3D, 'o' ^ 0x37};
+    check(frame.size() == sizeof(expected) && std::memcmp(frame.data(), expected, sizeof(expected)) == 0,
+          "Small masked text frame byte for byte");
+
+    frame = encoder.encode("", WebSocketFrameDecoder::OPCODE_PING, MASK_KEY);
+    check(frame.size() == 6 && static_cast<uint8_t>(frame[0]) == 0x89 && static_cast<uint8_t>(frame[1]) == 0x80,
+          "Empty ping frame");
+
+    frame = encoder.encode(std::string(126, 'x'), WebSocketFrameDecoder::OPCODE_TEXT, MASK_KEY);
+    check(frame.size() == 4 + 4 + 126 && static_cast<uint8_t>(frame[1]) == (0x80 | 126) &&
+              static_cast<uint8_t>(frame[2]) == 0 && static_cast<uint8_t>(frame[3]) == 126,
+          "126 bytes use the 16-bit length");
+
+    frame = encoder.encode(std::string(65536, 'x'), WebSocketFrameDecoder::OPCODE_TEXT, MASK_KEY);
+    check(frame.size() == 10 + 4 + 65536 && static_cast<uint8_t>(frame[1]) == (0x80 | 127) &&
+              static_cast<uint8_t>(frame[7]) == 1 && static_cast<uint8_t>(frame[8]) == 0,
+          "65536 bytes use the 64-bit length");
+
+    std::string_view first = encoder.encode("abc", WebSocketFrameDecoder::OPCODE_TEXT);
+    std::string key_one(first.substr(2, 4));
+    std::string_view second = encoder.encode("abc", WebSocketFrameDecoder::OPCODE_TEXT);
+    check(key_one != std::string(second.substr(2, 4)), "Each frame gets a fresh masking key");
+}
+
+static void test_round_trip()
+{
+    std::cout << "\n[TEST] Testing encoder/decoder round trip..." << std::endl;
+
+    WebSocketFrameEncoder encoder;
+    WebSocketFrameDecoder decoder;
+    bool all = true;
+    for (size_t size : {size_t(0), size_t(1), size_t(15), size_t(33), size_t(125), size_t(126), size_t(4099), size_t(70000)})
+    {
+        std::string payload(size, '\0');
+        for (size_t i = 0; i < size; i++)
+        {
+            payload[i] = static_cast<char>('a' + i % 26);
+        }
+
+        std::string_view frame = encoder.encode(payload, WebSocketFrameDecoder::OPCODE_TEXT);
+        std::memcpy(decoder.write_position(), frame.data(), frame.size());
+        decoder.commit(frame.size());
+
+        uint8_t opcode = 0;
+        std::string_view decoded;
+        all = all && decoder.next_message(opcode, decoded) == WebSocketFrameDecoder::Status::MESSAGE &&
+              opcode == WebSocketFrameDecoder::OPCODE_TEXT && decoded == payload;
+    }
+    check(all, "Encoded frames decode to the original payload");
+}
+
+int main()
+{
+    open_dtc_server::util::log("[TEST] Testing WebSocket frame encoder...");
+
+    test_mask();
+    test_encode();
+    test_round_trip();
+
+    if (failures > 0)
+    {
+        std::cout << "\n[ERROR] " << failures << " frame encoder check(s) failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\n[SUCCESS] All frame encoder tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,158 @@
+#include "coinbase_dtc_core/exchanges/coinbase/message_parser.hpp"
+#include "coinbase_dtc_core/core/util/log.hpp"
+#include "../../test_check.hpp"
+#include <iostream>
+#include <string>
+
+using namespace open_dtc_server::feed::coinbase;
+
+static void test_match()
+{
+    std::cout << "\n[TEST] Testing match messages..." << std::endl;
+
+    const std::string json =
+        "{\"type\":\"match\",\"trade_id\":651882194,\"maker_order_id\":\"c9f1e6a2-4b3d-4f0e-9a8c-1f2e3d4c5b6a\","
+        "\"side\":\"sell\",\"size\":\"0.00310000\",\"price\":\"67012.46\",\"product_id\":\"BTC-USD\","
+        "\"sequence\":80765213377,\"time\":\"2024-05-14T13:42:07.104523Z\"}";
+
+    FeedMessage msg;
+    check(parse_feed_message(json, msg), "Match message parses");
+    check(msg.type == FeedMessageType::MATCH, "Type is MATCH");
+    check(msg.product_id == "BTC-USD" && msg.side == "sell", "String fields without quotes");
+    check(msg.price == "67012.46" && msg.size == "0.00310000", "Price and size text");
+    check(msg.trade_id == "651882194" && msg.sequence == "80765213377", "Numeric fields as literal text");
+    check(msg.time == "2024-05-14T13:42:07.104523Z", "Timestamp text");
+    check(msg.changes.empty() && msg.best_bid.empty(), "Absent fields are empty");
+}
+
+static void test_l2update()
+{
+    std::cout << "\n[TEST] Testing l2update messages..." << std::endl;
+
+    const std::string json =
+        "{\"type\":\"l2update\",\"product_id\":\"ETH-USD\","
+        "\"changes\":[[\"buy\",\"3521.17\",\"3.85\"],[\"buy\",\"3521.10\",\"0.40\"],[\"sell\",\"3521.18\",\"0.00\"]],"
+        "\"time\":\"2024-05-14T13:42:07.106774Z\"}";
+
+    FeedMessage msg;
+    check(parse_feed_message(json, msg) && msg.type == FeedMessageType::L2UPDATE, "l2update parses");
+    check(msg.time == "2024-05-14T13:42:07.106774Z", "Fields after the changes array are read");
+
+    FeedArrayReader changes(msg.changes);
+    std::string_view fields[3];
+    check(changes.next(fields, 3) == 3 && fields[0] == "buy" && fields[1] == "3521.17" && fields[2] == "3.85",
+          "First change");
+    check(changes.next(fields, 3) == 3 && fields[1] == "3521.10", "Second change");
+    check(changes.next(fields, 3) == 3 && fields[0] == "sell" && fields[2] == "0.00", "Third change");
+    check(changes.next(fields, 3) == 0, "End of changes");
+}
+
+static void test_snapshot()
+{
+    std::cout << "\n[TEST] Testing snapshot messages..." << std::endl;
+
+    const std::string json =
+        "{ \"type\" : \"snapshot\", \"product_id\" : \"BTC-USD\",\n"
+        "  \"bids\" : [ [\"67012.45\", \"0.521\"], [\"67012.44\", \"0.0015\"] ],\n"
+        "  \"asks\" : [ [\"67012.46\", \"0.31\"] ] }";
+
+    FeedMessage msg;
+    check(parse_feed_message(json, msg) && msg.type == FeedMessageType::SNAPSHOT, "Snapshot with whitespace parses");
+
+    FeedArrayReader bids(msg.bids);
+    std::string_view fields[2];
+    int count = 0;
+    while (bids.next(fields, 2) == 2)
+    {
+        count++;
+    }
+    check(count == 2, "Two bid levels");
+
+    FeedArrayReader asks(msg.asks);
+    check(asks.next(fields, 2) == 2 && fields[0] == "67012.46" && fields[1] == "0.31", "Ask level");
+    check(asks.next(fields, 2) == 0, "End of asks");
+
+    FeedArrayReader empty("[]");
+    check(empty.next(fields, 2) == 0, "Empty array has no rows");
+}
+
+static void test_ticker_and_heartbeat()
+{
+    std::cout << "\n[TEST] Testing ticker and heartbeat messages..." << std::endl;
+
+    FeedMessage msg;
+    check(parse_feed_message("{\"type\":\"ticker\",\"product_id\":\"BTC-USD\",\"price\":\"67012.46\","
+                             "\"best_bid\":\"67012.45\",\"best_bid_size\":\"0.491\",\"best_ask\":\"67012.61\","
+                             "\"best_ask_size\":\"0.12\",\"trade_id\":651882194}",
+                             msg) &&
+              msg.type == FeedMessageType::TICKER,
+          "Ticker parses");
+    check(msg.best_bid == "67012.45" && msg.best_bid_size == "0.491" && msg.best_ask == "67012.61" &&
+              msg.best_ask_size == "0.12",
+          "Best bid/ask fields");
+
+    check(parse_feed_message("{\"type\":\"heartbeat\",\"last_trade_id\":371044128,\"product_id\":\"ETH-USD\","
+                             "\"sequence\":49120876513,\"time\":\"2024-05-14T13:42:07.120001Z\"}",
+                             msg) &&
+              msg.type == FeedMessageType::HEARTBEAT && msg.last_trade_id == "371044128",
+          "Heartbeat parses");
+}
+
+static void test_other_and_malformed()
+{
+    std::cout << "\n[TEST] Testing other and malformed messages..." << std::endl;
+
+    FeedMessage msg;
+    check(parse_feed_message("{\"type\":\"subscriptions\",\"channels\":[{\"name\":\"matches\",\"product_ids\":[\"BTC-USD\"]}]}",
+                             msg) &&
+              msg.type == FeedMessageType::SUBSCRIPTIONS,
+          "Nested objects are skipped");
+    check(parse_feed_message("{\"type\":\"error\",\"message\":\"Failed to subscribe\",\"reason\":\"bad \\\"product\\\"\"}",
+                             msg) &&
+              msg.type == FeedMessageType::ERROR_MESSAGE && msg.message == "Failed to subscribe",
+          "Error message with escaped quotes");
+    check(parse_feed_message("{\"type\":\"last_match\",\"product_id\":\"BTC-USD\"}", msg) &&
+              msg.type == FeedMessageType::UNKNOWN,
+          "Unhandled type is UNKNOWN");
+    check(parse_feed_message("{\"price\":\"1.0\",\"other\":null,\"flag\":true}", msg) &&
+              msg.type == FeedMessageType::UNKNOWN && msg.price == "1.0",
+          "Message without a type");
+
+    check(!parse_feed_message("", msg), "Empty text is rejected");
+    check(!parse_feed_message("[1,2]", msg), "Non-object is rejected");
+    check(!parse_feed_message("{\"type\":\"match\",\"price\":\"1.0", msg), "Unterminated string is rejected");
+    check(!parse_feed_message("{\"type\":\"l2update\",\"changes\":[[\"buy\",\"1\",\"2\"]", msg),
+          "Unterminated array is rejected");
+    check(!parse_feed_message("{\"type\" \"match\"}", msg), "Missing colon is rejected");
+
+    // The message itself is well formed; the reader stops at the row it cannot read
+    std::string_view fields[3];
+    check(parse_feed_message("{\"type\":\"l2update\",\"product_id\":\"BTC-USD\",\"changes\":[[\"buy\",\"1\",{}]]}", msg),
+          "Object inside a change row parses");
+    FeedArrayReader object_row(msg.changes);
+    check(object_row.next(fields, 3) == 0 && object_row.next(fields, 3) == 0, "Object inside a row ends the changes");
+    FeedArrayReader stray_close("[[\"buy\",}],[\"sell\",\"1\",\"2\"]]");
+    check(stray_close.next(fields, 3) == 0 && stray_close.next(fields, 3) == 0, "Stray close brace ends the changes");
+    FeedArrayReader nested("[[\"buy\",[\"1\"],\"2\"]]");
+    check(nested.next(fields, 3) == 0, "Nested array ends the changes");
+}
+
+int main()
+{
+    open_dtc_server::util::log("[TEST] Testing Coinbase feed message parser...");
+
+    test_match();
+    test_l2update();
+    test_snapshot();
+    test_ticker_and_heartbeat();
+    test_other_and_malformed();
+
+    if (failures > 0)
+    {
+        std::cout << "\n[ERROR] " << failures << " parser check(s) failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\n[SUCCESS] All feed message parser tests passed!" << std::endl;
+    return 0;
+}
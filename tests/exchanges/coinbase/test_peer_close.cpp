@@ -0,0 +1,78 @@
+#include "coinbase_dtc_core/exchanges/coinbase/websocket_client.hpp"
+#include "coinbase_dtc_core/core/util/log.hpp"
+#include "feed_stand_in.hpp"
+#include "../../test_check.hpp"
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+// The feed closing the connection must leave the client able to reconnect and
+// to be destroyed: its worker, parser and ping threads still need joining.
+
+using open_dtc_server::feed::coinbase::WebSocketClient;
+using coinbase_test::FeedStandIn;
+
+// Wait up to 5 s for the client's worker to notice the peer close
+static bool wait_for_close(const WebSocketClient &client)
+{
+    for (int i = 0; i < 50 && client.is_connected(); i++)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    return !client.is_connected();
+}
+
+static void test_peer_close()
+{
+    std::cout << "\n[TEST] Testing peer close..." << std::endl;
+
+    auto client = std::make_unique<WebSocketClient>(); // initializes Winsock first
+    client->set_tls_enabled(false);
+    client->set_compression_enabled(false);
+
+    FeedStandIn first;
+    FeedStandIn second;
+    if (!first.start() || !second.start())
+    {
+        check(false, "Start the feed stand-ins");
+        return;
+    }
+
+    check(client->connect("127.0.0.1", first.port()), "Connect to the first stand-in");
+    first.close_client();
+    check(wait_for_close(*client), "Peer close noticed");
+    first.stop();
+
+    // Reconnecting replaces the threads left over from the closed connection
+    check(client->connect("127.0.0.1", second.port()), "Reconnect after peer close");
+    check(client->is_connected(), "Connected again");
+    check(client->subscribe_trades("CLOSE-USD"), "Subscribe on the new connection");
+    auto messages = second.wait_for_messages(1);
+    check(messages.size() == 1 && messages[0].find("CLOSE-USD") != std::string::npos,
+          "New connection carries the subscription");
+
+    second.close_client();
+    check(wait_for_close(*client), "Second peer close noticed");
+
+    // Destroying after a peer close joins the threads instead of terminating
+    client.reset();
+    check(true, "Client destroyed after peer close");
+    second.stop();
+}
+
+int main()
+{
+    open_dtc_server::util::log("[TEST] Testing Coinbase peer close...");
+
+    test_peer_close();
+
+    if (failures > 0)
+    {
+        std::cout << "\n[ERROR] " << failures << " peer close check(s) failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\n[SUCCESS] All peer close tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,190 @@
+#include "coinbase_dtc_core/exchanges/coinbase/permessage_deflate.hpp"
+#include "coinbase_dtc_core/core/util/log.hpp"
+#include "../../test_check.hpp"
+#include <zlib.h>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+using open_dtc_server::feed::coinbase::DeflateParameters;
+using open_dtc_server::feed::coinbase::MessageInflater;
+using open_dtc_server::feed::coinbase::parse_permessage_deflate;
+
+// Server side of permessage-deflate: raw deflate, sync flush, 00 00 FF FF tail stripped
+class Deflater
+{
+public:
+    explicit Deflater(bool context_takeover = true) : context_takeover_(context_takeover)
+    {
+        deflateInit2(&stream_, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY);
+    }
+    ~Deflater() { deflateEnd(&stream_); }
+
+    std::string compress(const std::string &message, bool final_block = false)
+    {
+        std::string out(deflateBound(&stream_, static_cast<uLong>(message.size())) + 16, '\0');
+        stream_.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(message.data()));
+        stream_.avail_in = static_cast<uInt>(message.size());
+        stream_.next_out = reinterpret_cast<Bytef *>(&out[0]);
+        stream_.avail_out = static_cast<uInt>(out.size());
+        deflate(&stream_, final_block ? Z_FINISH : Z_SYNC_FLUSH);
+        out.resize(out.size() - stream_.avail_out);
+
+        if (final_block || !context_takeover_)
+        {
+            deflateReset(&stream_);
+        }
+        if (!final_block)
+        {
+            out.resize(out.size() - 4);
+        }
+        return out;
+    }
+
+private:
+    z_stream stream_{};
+    bool context_takeover_;
+};
+
+static const std::string MATCH =
+    "{\"type\":\"match\",\"trade_id\":651882194,\"side\":\"sell\",\"size\":\"0.00310000\",\"price\":\"67012.46\","
+    "\"product_id\":\"BTC-USD\",\"sequence\":80765213377,\"time\":\"2024-05-14T13:42:07.104523Z\"}";
+
+static const std::string L2UPDATE =
+    "{\"type\":\"l2update\",\"product_id\":\"BTC-USD\",\"changes\":[[\"buy\",\"67012.45\",\"0.51200000\"]],"
+    "\"time\":\"2024-05-14T13:42:07.105112Z\"}";
+
+static void test_negotiation()
+{
+    std::cout << "\n[TEST] Testing Sec-WebSocket-Extensions parsing..." << std::endl;
+
+    DeflateParameters params;
+    check(parse_permessage_deflate("permessage-deflate", params) && !params.server_no_context_takeover &&
+              params.server_max_window_bits == 15,
+          "Bare permessage-deflate uses the defaults");
+
+    check(parse_permessage_deflate("permessage-deflate; server_no_context_takeover; client_max_window_bits=12", params) &&
+              params.server_no_context_takeover && params.client_max_window_bits == 12,
+          "Parameters are read");
+
+    check(parse_permessage_deflate("permessage-deflate;server_max_window_bits=\"10\"", params) &&
+              params.server_max_window_bits == 10,
+          "Quoted window bits without spaces");
+
+    DeflateParameters untouched;
+    untouched.server_max_window_bits = 9;
+    check(!parse_permessage_deflate("", untouched) && !parse_permessage_deflate("x-webkit-deflate-frame", untouched) &&
+              untouched.server_max_window_bits == 9,
+          "Other extensions are rejected and leave the parameters alone");
+    check(!parse_permessage_deflate("permessage-deflate; server_max_window_bits=7", params) &&
+              !parse_permessage_deflate("permessage-deflate; server_max_window_bits=16", params) &&
+              !parse_permessage_deflate("permessage-deflate; server_max_window_bits", params),
+          "Window bits outside 8-15");
+    check(!parse_permessage_deflate("permessage-deflate; unknown_parameter", params) &&
+              !parse_permessage_deflate("permessage-deflate; server_no_context_takeover=1", params) &&
+              !parse_permessage_deflate("permessage-deflate; server_no_context_takeover; server_no_context_takeover", params) &&
+              !parse_permessage_deflate("permessage-deflate, permessage-deflate", params),
+          "Unknown, valued or repeated parameters and repeated extensions");
+}
+
+static void test_context_takeover()
+{
+    std::cout << "\n[TEST] Testing context takeover..." << std::endl;
+
+    Deflater deflater;
+    std::string first = deflater.compress(MATCH);
+    std::string second = deflater.compress(MATCH);
+    std::string third = deflater.compress(L2UPDATE);
+    check(second.size() < first.size() / 4, "Repeated message compresses against the previous one");
+
+    MessageInflater inflater;
+    check(inflater.start(DeflateParameters()), "Inflater starts");
+
+    std::string_view message;
+    check(inflater.inflate(first, message) && message == MATCH, "First message");
+    check(inflater.inflate(second, message) && message == MATCH, "Second message uses the shared window");
+    check(inflater.inflate(third, message) && message == L2UPDATE, "Third message");
+
+    MessageInflater fresh;
+    fresh.start(DeflateParameters());
+    check(!fresh.inflate(second, message) || message != MATCH, "Second message alone cannot be inflated");
+}
+
+static void test_no_context_takeover()
+{
+    std::cout << "\n[TEST] Testing server_no_context_takeover..." << std::endl;
+
+    Deflater deflater(false);
+    DeflateParameters params;
+    params.server_no_context_takeover = true;
+    MessageInflater inflater;
+    inflater.start(params);
+
+    std::string_view message;
+    bool all = true;
+    for (int i = 0; i < 3; i++)
+    {
+        all = all && inflater.inflate(deflater.compress(i % 2 ? L2UPDATE : MATCH), message) &&
+              message == (i % 2 ? L2UPDATE : MATCH);
+    }
+    check(all, "Independently compressed messages inflate");
+
+    // A sender may also end a message with a final block and start a new stream
+    Deflater finishing;
+    MessageInflater takeover;
+    takeover.start(DeflateParameters());
+    check(takeover.inflate(finishing.compress(MATCH, true), message) && message == MATCH &&
+              takeover.inflate(finishing.compress(L2UPDATE, true), message) && message == L2UPDATE,
+          "Messages ending in a final block");
+}
+
+static void test_large_and_corrupt()
+{
+    std::cout << "\n[TEST] Testing large and corrupt messages..." << std::endl;
+
+    std::string snapshot = "{\"type\":\"snapshot\",\"product_id\":\"BTC-USD\",\"bids\":[";
+    for (int i = 0; i < 20000; i++)
+    {
+        snapshot += (i ? ",[\"" : "[\"") + std::to_string(67000 - i) + ".00\",\"" + std::to_string(i % 97) + ".5\"]";
+    }
+    snapshot += "],\"asks\":[]}";
+
+    Deflater deflater;
+    MessageInflater inflater;
+    inflater.start(DeflateParameters());
+    std::string_view message;
+    check(inflater.inflate(deflater.compress(snapshot), message) && message == snapshot,
+          "Snapshot larger than the initial output buffer");
+
+    std::string corrupt = deflater.compress(MATCH);
+    corrupt[0] = static_cast<char>(0xFF);
+    MessageInflater broken;
+    broken.start(DeflateParameters());
+    check(!broken.inflate(corrupt, message), "Corrupt data is rejected");
+
+    broken.start(DeflateParameters());
+    Deflater restarted;
+    check(broken.inflate(restarted.compress(MATCH), message) && message == MATCH, "start() recovers the inflater");
+
+    MessageInflater idle;
+    check(!idle.inflate(deflater.compress(MATCH), message), "inflate() before start() fails");
+}
+
+int main()
+{
+    open_dtc_server::util::log("[TEST] Testing permessage-deflate...");
+
+    test_negotiation();
+    test_context_takeover();
+    test_no_context_takeover();
+    test_large_and_corrupt();
+
+    if (failures > 0)
+    {
+        std::cout << "\n[ERROR] " << failures << " permessage-deflate check(s) failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\n[SUCCESS] All permessage-deflate tests passed!" << std::endl;
+    return 0;
+}
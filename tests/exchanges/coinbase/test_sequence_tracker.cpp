@@ -0,0 +1,210 @@
+#include "coinbase_dtc_core/exchanges/coinbase/sequence_tracker.hpp"
+#include "coinbase_dtc_core/exchanges/coinbase/websocket_client.hpp"
+#include "coinbase_dtc_core/core/util/log.hpp"
+#include "coinbase_dtc_core/core/util/symbol_table.hpp"
+#include "feed_stand_in.hpp"
+#include "../../test_check.hpp"
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// The end-to-end test runs a plain ws:// stand-in for the Coinbase feed that
+// replays the exchange's real message shapes (level2 messages carry no
+// sequence, matches do), loses an update that leaves one book crossed, and
+// answers the client's level2 resubscribe with a new snapshot.
+
+using open_dtc_server::exchanges::base::MarketDepthUpdate;
+using open_dtc_server::exchanges::base::MarketTrade;
+using open_dtc_server::feed::coinbase::SequenceTracker;
+using open_dtc_server::feed::coinbase::WebSocketClient;
+using open_dtc_server::util::SymbolTable;
+using coinbase_test::FeedStandIn;
+
+static void test_tracker()
+{
+    std::cout << "\n[TEST] Testing sequence classification..." << std::endl;
+
+    SequenceTracker tracker;
+    check(tracker.check(1, 100) == SequenceTracker::Result::FIRST, "First sequence sets the baseline");
+    check(tracker.check(1, 101) == SequenceTracker::Result::NEXT, "Consecutive sequence");
+    check(tracker.check(1, 101) == SequenceTracker::Result::DUPLICATE, "Repeated sequence is a duplicate");
+    check(tracker.check(1, 90) == SequenceTracker::Result::DUPLICATE, "Older sequence is a duplicate");
+    check(tracker.check(1, 105) == SequenceTracker::Result::GAP, "Skipped sequences are a gap");
+    check(tracker.check(1, 106) == SequenceTracker::Result::NEXT, "Gap moves the baseline forward");
+    check(tracker.check(2, 7) == SequenceTracker::Result::FIRST, "Products are tracked separately");
+
+    tracker.reset(1, 200);
+    check(tracker.check(1, 150) == SequenceTracker::Result::DUPLICATE && tracker.check(1, 201) == SequenceTracker::Result::NEXT,
+          "Snapshot sequence becomes the baseline");
+    tracker.forget(1);
+    check(tracker.check(1, 5) == SequenceTracker::Result::FIRST, "Forgotten product starts over");
+
+    uint64_t sequence = 0;
+    check(SequenceTracker::parse("80765213377", sequence) && sequence == 80765213377ULL, "Parses a sequence field");
+    check(!SequenceTracker::parse("", sequence) && !SequenceTracker::parse("12a", sequence) &&
+              !SequenceTracker::parse("-1", sequence),
+          "Rejects missing or malformed sequences");
+}
+
+static std::string snapshot(const std::string &product, const std::string &bid, const std::string &ask)
+{
+    return "{\"type\":\"snapshot\",\"product_id\":\"" + product + "\",\"bids\":[[\"" + bid +
+           "\",\"1.0\"]],\"asks\":[[\"" + ask + "\",\"2.0\"]]}";
+}
+
+static std::string update(const std::string &product, const std::string &side, const std::string &price)
+{
+    return "{\"type\":\"l2update\",\"product_id\":\"" + product + "\",\"changes\":[[\"" + side + "\",\"" +
+           price + "\",\"0.5\"]],\"time\":\"2024-05-14T13:42:07.104523Z\"}";
+}
+
+static std::string match(const std::string &product, uint64_t trade_id, uint64_t sequence)
+{
+    return "{\"type\":\"match\",\"trade_id\":" + std::to_string(trade_id) +
+           ",\"maker_order_id\":\"ac928c66-ca53-498f-9c13-a110027a60e8\","
+           "\"taker_order_id\":\"132fb6ae-456b-4654-b4e0-d681ac05cea1\",\"side\":\"buy\",\"size\":\"0.01\","
+           "\"price\":\"3000.50\",\"product_id\":\"" +
+           product + "\",\"sequence\":" + std::to_string(sequence) + ",\"time\":\"2024-05-14T13:42:07.104523Z\"}";
+}
+
+// Whether the client unsubscribed and then resubscribed product's level2 channel
+static bool resubscribed(const std::vector<std::string> &messages, const std::string &product)
+{
+    bool unsubscribed = false;
+    for (const auto &message : messages)
+    {
+        bool level2 = message.find("\"level2\"") != std::string::npos && message.find(product) != std::string::npos;
+        if (level2 && message.find("\"unsubscribe\"") != std::string::npos)
+        {
+            unsubscribed = true;
+        }
+        else if (level2 && unsubscribed && message.find("\"subscribe\"") != std::string::npos)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Snapshots are identified by their best bid, updates by their one change
+struct DepthEvent
+{
+    std::string product;
+    bool is_snapshot;
+    double price;
+};
+
+static void test_resync()
+{
+    std::cout << "\n[TEST] Testing crossed book detection and resync..." << std::endl;
+
+    WebSocketClient client; // initializes Winsock before the stand-in opens sockets
+    FeedStandIn server;
+    if (!server.start())
+    {
+        check(false, "Start the feed stand-in");
+        return;
+    }
+
+    std::mutex mutex;
+    std::vector<DepthEvent> events;
+    int trades = 0;
+    client.set_tls_enabled(false);
+    client.set_compression_enabled(false);
+    client.subscribe_level2("BTC-USD");
+    client.subscribe_level2("ETH-USD");
+    client.set_depth_callback([&](const MarketDepthUpdate &depth)
+                              {
+                                  std::lock_guard<std::mutex> lock(mutex);
+                                  events.push_back({SymbolTable::symbols().name(depth.symbol_id), depth.is_snapshot,
+                                                    depth.changes.empty() ? 0.0 : depth.changes.front().price});
+                              });
+    client.set_trade_callback([&](const MarketTrade &)
+                              {
+                                  std::lock_guard<std::mutex> lock(mutex);
+                                  trades++;
+                              });
+
+    check(client.connect("127.0.0.1", server.port()), "Connect to the stand-in");
+
+    // ETH-USD streams cleanly (with one replayed match). BTC-USD loses the
+    // update that removed its 60005 bid, so the 60004 ask crosses the book.
+    for (const auto &message : {snapshot("BTC-USD", "60000.00", "60010.00"), snapshot("ETH-USD", "3000.00", "3010.00"),
+                                update("BTC-USD", "buy", "60005.00"), update("ETH-USD", "buy", "3001.00"),
+                                match("ETH-USD", 7001, 500), update("BTC-USD", "sell", "60004.00"),
+                                update("BTC-USD", "buy", "60001.00"), update("ETH-USD", "buy", "3002.00"),
+                                match("ETH-USD", 7001, 500)})
+    {
+        server.send_text(message);
+    }
+
+    auto messages = server.wait_for_messages([](const std::vector<std::string> &sent)
+                                             { return resubscribed(sent, "BTC-USD"); });
+    bool resynced = resubscribed(messages, "BTC-USD");
+    check(resynced, "Crossed book resubscribes the product's level2 channel");
+    if (resynced)
+    {
+        server.send_text(update("ETH-USD", "buy", "3003.00"));
+        server.send_text(snapshot("BTC-USD", "61000.00", "61010.00"));
+        server.send_text(update("BTC-USD", "buy", "61001.00"));
+    }
+
+    auto seen = [&](const std::string &product, bool is_snapshot, double price)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto &event : events)
+        {
+            if (event.product == product && event.is_snapshot == is_snapshot && event.price == price)
+            {
+                return true;
+            }
+        }
+        return false;
+    };
+    for (int i = 0; i < 50 && !seen("BTC-USD", false, 61001.00); i++)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+    bool other_resubscribed = false;
+    for (const auto &message : server.messages())
+    {
+        other_resubscribed = other_resubscribed || message.find("ETH-USD") != std::string::npos;
+    }
+    check(!other_resubscribed, "Other products are not resubscribed");
+    check(seen("BTC-USD", false, 60005.00), "Updates before the loss applied");
+    check(!seen("BTC-USD", false, 60004.00), "Update that crossed the book is not published");
+    check(!seen("BTC-USD", false, 60001.00), "Updates are not applied to the dropped book");
+    check(seen("BTC-USD", true, 61000.00) && seen("BTC-USD", false, 61001.00),
+          "Fresh snapshot rebuilds the book and updates resume");
+    check(seen("ETH-USD", false, 3002.00) && seen("ETH-USD", false, 3003.00), "Other product keeps streaming");
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        check(trades == 1, "Replayed match dropped");
+    }
+    check(client.get_status().find("1 book resyncs") != std::string::npos, "Resync counted in the status");
+
+    client.disconnect();
+    server.stop();
+}
+
+int main()
+{
+    open_dtc_server::util::log("[TEST] Testing sequence tracking...");
+
+    test_tracker();
+    test_resync();
+
+    if (failures > 0)
+    {
+        std::cout << "\n[ERROR] " << failures << " sequence check(s) failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\n[SUCCESS] All sequence tracking tests passed!" << std::endl;
+    return 0;
+}
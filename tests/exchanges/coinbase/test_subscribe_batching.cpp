@@ -0,0 +1,144 @@
+#include "coinbase_dtc_core/exchanges/coinbase/websocket_client.hpp"
+#include "coinbase_dtc_core/core/util/log.hpp"
+#include "feed_stand_in.hpp"
+#include "../../test_check.hpp"
+#include <algorithm>
+#include <iostream>
+#include <set>
+#include <string>
+#include <vector>
+
+// A plain ws:// stand-in for the Coinbase feed records every frame the client
+// sends, so the tests can count subscribe/unsubscribe frames and their products.
+
+using open_dtc_server::feed::coinbase::WebSocketClient;
+using coinbase_test::FeedStandIn;
+
+// Product IDs listed in a subscription message
+static std::vector<std::string> products_in(const std::string &message)
+{
+    std::vector<std::string> products;
+    size_t begin = message.find("\"product_ids\":[");
+    if (begin == std::string::npos)
+    {
+        return products;
+    }
+    size_t end = message.find(']', begin);
+    for (size_t pos = message.find('"', begin + 15); pos < end; pos = message.find('"', pos + 1))
+    {
+        size_t close = message.find('"', pos + 1);
+        products.push_back(message.substr(pos + 1, close - pos - 1));
+        pos = close;
+    }
+    return products;
+}
+
+static std::vector<std::string> make_products(size_t count, const std::string &prefix)
+{
+    std::vector<std::string> products;
+    for (size_t i = 0; i < count; i++)
+    {
+        products.push_back(prefix + std::to_string(i) + "-USD");
+    }
+    return products;
+}
+
+// Checks that messages[first, first + frames) carry exactly products on channels
+static void check_batch(const std::vector<std::string> &messages, size_t first, size_t frames, const std::string &type,
+                        const std::string &channels, const std::vector<std::string> &products, const std::string &what)
+{
+    check(messages.size() >= first + frames, what + ": sent in " + std::to_string(frames) + " frames");
+    if (messages.size() < first + frames)
+    {
+        return;
+    }
+
+    std::set<std::string> seen;
+    size_t listed = 0;
+    bool well_formed = true;
+    bool within_limits = true;
+    for (size_t i = first; i < first + frames; i++)
+    {
+        const std::string &message = messages[i];
+        well_formed = well_formed && message.rfind("{\"type\":\"" + type + "\"", 0) == 0 &&
+                      message.find("\"channels\":[" + channels + "]}") != std::string::npos;
+        auto listed_products = products_in(message);
+        within_limits = within_limits && listed_products.size() <= WebSocketClient::MAX_PRODUCTS_PER_MESSAGE &&
+                        message.size() <= WebSocketClient::MAX_SUBSCRIPTION_MESSAGE_BYTES;
+        listed += listed_products.size();
+        seen.insert(listed_products.begin(), listed_products.end());
+    }
+
+    check(well_formed, what + ": every frame names the type and all channels");
+    check(within_limits, what + ": every frame within the product and size limits");
+    check(listed == products.size() && seen == std::set<std::string>(products.begin(), products.end()),
+          what + ": every product listed exactly once");
+}
+
+static void test_batching()
+{
+    std::cout << "\n[TEST] Testing batched subscriptions..." << std::endl;
+
+    WebSocketClient client; // initializes Winsock before the stand-in opens sockets
+    FeedStandIn server;
+    if (!server.start())
+    {
+        check(false, "Start the feed stand-in");
+        return;
+    }
+
+    client.set_tls_enabled(false);
+    client.set_compression_enabled(false);
+
+    // Not connected: recorded, nothing sent
+    check(client.subscribe_channels({"matches"}, {"OFFLINE-USD"}), "Subscribe while disconnected succeeds");
+    auto subscribed = client.get_subscribed_symbols();
+    check(std::find(subscribed.begin(), subscribed.end(), "OFFLINE-USD") != subscribed.end(),
+          "Subscription recorded while disconnected");
+
+    check(client.connect("127.0.0.1", server.port()), "Connect to the stand-in");
+
+    auto products = make_products(300, "P");
+    check(client.subscribe_channels({"matches", "level2"}, products), "Subscribe 300 products to two channels");
+    auto messages = server.wait_for_messages(3);
+    check_batch(messages, 0, 3, "subscribe", "\"matches\",\"level2\"", products, "300-product subscribe");
+
+    subscribed = client.get_subscribed_symbols();
+    check(subscribed.size() == 301, "Every product recorded once");
+
+    // Long product IDs hit the byte limit before the product limit
+    auto long_products = make_products(100, std::string(100, 'L'));
+    check(client.subscribe_channels({"level2"}, long_products), "Subscribe 100 long product IDs");
+    messages = server.wait_for_messages(5);
+    check_batch(messages, 3, 2, "subscribe", "\"level2\"", long_products, "Long product subscribe");
+
+    check(client.unsubscribe_channels({"matches", "level2"}, products), "Unsubscribe 300 products");
+    messages = server.wait_for_messages(8);
+    check_batch(messages, 5, 3, "unsubscribe", "\"matches\",\"level2\"", products, "300-product unsubscribe");
+    check(client.get_subscribed_symbols().size() == 101, "Unsubscribed products forgotten");
+
+    check(client.unsubscribe("OFFLINE-USD"), "Unsubscribe one product");
+    messages = server.wait_for_messages(9);
+    check(messages.size() == 9 && messages[8] == "{\"type\":\"unsubscribe\",\"product_ids\":[\"OFFLINE-USD\"],"
+                                                "\"channels\":[\"matches\",\"level2\"]}",
+          "Single unsubscribe covers trades and level2");
+
+    client.disconnect();
+    server.stop();
+}
+
+int main()
+{
+    open_dtc_server::util::log("[TEST] Testing subscription batching...");
+
+    test_batching();
+
+    if (failures > 0)
+    {
+        std::cout << "\n[ERROR] " << failures << " subscription batching check(s) failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\n[SUCCESS] All subscription batching tests passed!" << std::endl;
+    return 0;
+}
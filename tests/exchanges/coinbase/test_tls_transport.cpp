@@ -0,0 +1,232 @@
+#include "coinbase_dtc_core/exchanges/coinbase/websocket_client.hpp"
+#include "coinbase_dtc_core/core/util/log.hpp"
+#include "feed_stand_in.hpp"
+#include "../../test_check.hpp"
+#include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/ssl.h>
+#include <openssl/x509.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <thread>
+
+// Local TLS WebSocket stand-in for ws-feed.exchange.coinbase.com: a self-signed
+// certificate for "localhost", the upgrade response and one match message per
+// connection.
+
+using open_dtc_server::feed::coinbase::WebSocketClient;
+using coinbase_test::close_socket;
+
+static const char *CA_FILE = "tls_transport_test_cert.pem";
+
+static const std::string MATCH_MESSAGE =
+    "{\"type\":\"match\",\"trade_id\":1,\"side\":\"sell\",\"size\":\"0.5\",\"price\":\"67012.46\","
+    "\"product_id\":\"BTC-USD\",\"sequence\":1,\"time\":\"2024-05-14T13:42:07.104523Z\"}";
+
+class TlsStandIn
+{
+public:
+    bool start(int connections)
+    {
+        if (!create_certificate())
+        {
+            return false;
+        }
+
+        listen_fd_ = coinbase_test::listen_on_loopback(4, port_);
+        if (listen_fd_ == -1)
+        {
+            return false;
+        }
+
+        thread_ = std::thread([this, connections]()
+                              {
+                                  for (int i = 0; i < connections; i++)
+                                  {
+                                      serve_one();
+                                  }
+                              });
+        return true;
+    }
+
+    void stop()
+    {
+        if (thread_.joinable())
+        {
+            thread_.join();
+        }
+        if (listen_fd_ != -1)
+        {
+            close_socket(listen_fd_);
+        }
+        SSL_CTX_free(ctx_);
+        std::remove(CA_FILE);
+    }
+
+    uint16_t port() const { return port_; }
+    int handshakes() const { return handshakes_.load(); }
+
+private:
+    bool create_certificate()
+    {
+        EVP_PKEY *key = nullptr;
+        EVP_PKEY_CTX *key_ctx = EVP_PKEY_CTX_new_id(EVP_PKEY_EC, nullptr);
+        if (!key_ctx || EVP_PKEY_keygen_init(key_ctx) != 1 ||
+            EVP_PKEY_CTX_set_ec_paramgen_curve_nid(key_ctx, NID_X9_62_prime256v1) != 1 ||
+            EVP_PKEY_keygen(key_ctx, &key) != 1)
+        {
+            EVP_PKEY_CTX_free(key_ctx);
+            return false;
+        }
+        EVP_PKEY_CTX_free(key_ctx);
+
+        X509 *cert = X509_new();
+        X509_set_version(cert, 2);
+        ASN1_INTEGER_set(X509_get_serialNumber(cert), 1);
+        X509_gmtime_adj(X509_getm_notBefore(cert), -60);
+        X509_gmtime_adj(X509_getm_notAfter(cert), 3600);
+        X509_set_pubkey(cert, key);
+        X509_NAME *name = X509_get_subject_name(cert);
+        X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC, reinterpret_cast<const unsigned char *>("localhost"),
+                                   -1, -1, 0);
+        X509_set_issuer_name(cert, name);
+        X509_sign(cert, key, EVP_sha256());
+
+        FILE *file = std::fopen(CA_FILE, "w");
+        bool written = file && PEM_write_X509(file, cert) == 1;
+        if (file)
+        {
+            std::fclose(file);
+        }
+
+        ctx_ = SSL_CTX_new(TLS_server_method());
+        bool loaded = ctx_ && SSL_CTX_use_certificate(ctx_, cert) == 1 && SSL_CTX_use_PrivateKey(ctx_, key) == 1;
+        X509_free(cert);
+        EVP_PKEY_free(key);
+        return written && loaded;
+    }
+
+    void serve_one()
+    {
+        int fd = static_cast<int>(accept(listen_fd_, nullptr, nullptr));
+        if (fd < 0)
+        {
+            return;
+        }
+
+        SSL *ssl = SSL_new(ctx_);
+        SSL_set_fd(ssl, fd);
+        if (SSL_accept(ssl) == 1)
+        {
+            handshakes_++;
+
+            // Upgrade request
+            std::string request;
+            char buffer[4096];
+            while (request.find("\r\n\r\n") == std::string::npos)
+            {
+                int count = SSL_read(ssl, buffer, sizeof(buffer));
+                if (count <= 0)
+                {
+                    break;
+                }
+                request.append(buffer, count);
+            }
+
+            std::string response = coinbase_test::UPGRADE_RESPONSE + coinbase_test::text_frame(MATCH_MESSAGE);
+            SSL_write(ssl, response.data(), static_cast<int>(response.size()));
+
+            // Swallow client frames (pings) until the client goes away
+            while (SSL_read(ssl, buffer, sizeof(buffer)) > 0)
+            {
+            }
+            SSL_shutdown(ssl);
+        }
+        SSL_free(ssl);
+        close_socket(fd);
+    }
+
+    SSL_CTX *ctx_ = nullptr;
+    int listen_fd_ = -1;
+    uint16_t port_ = 0;
+    std::atomic<int> handshakes_{0};
+    std::thread thread_;
+};
+
+static bool wait_for(const std::atomic<int> &counter, int expected)
+{
+    for (int i = 0; i < 50 && counter.load() < expected; i++)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    return counter.load() >= expected;
+}
+
+static void test_connect_and_resume(TlsStandIn &server)
+{
+    std::cout << "\n[TEST] Testing wss:// connection and session resumption..." << std::endl;
+
+    std::atomic<int> trades{0};
+    double price = 0.0;
+
+    WebSocketClient client;
+    client.set_tls_ca_file(CA_FILE);
+    client.subscribe_trades("BTC-USD");
+    client.set_trade_callback([&](const open_dtc_server::exchanges::base::MarketTrade &trade)
+                              {
+                                  price = trade.price;
+                                  trades++;
+                              });
+
+    check(client.connect("localhost", server.port()), "TLS connection to the stand-in");
+    check(!client.tls_session_reused(), "First connection runs a full handshake");
+    check(wait_for(trades, 1) && price == 67012.46, "Match message arrives over TLS");
+    client.disconnect();
+
+    check(client.connect("localhost", server.port()), "Reconnect");
+    check(client.tls_session_reused(), "Reconnect resumes the cached session");
+    check(wait_for(trades, 2), "Messages arrive after resumption");
+    client.disconnect();
+
+    check(server.handshakes() == 2, "Stand-in saw both handshakes");
+}
+
+static void test_untrusted_certificate(TlsStandIn &server)
+{
+    std::cout << "\n[TEST] Testing certificate verification..." << std::endl;
+
+    // System trust store: the self-signed certificate must be rejected
+    WebSocketClient client;
+    check(!client.connect("localhost", server.port()), "Self-signed certificate is rejected by default");
+}
+
+int main()
+{
+    open_dtc_server::util::log("[TEST] Testing TLS transport...");
+
+    TlsStandIn server;
+    WebSocketClient startup; // initializes Winsock before the stand-in opens sockets
+    if (!server.start(3))
+    {
+        std::cout << "[ERROR] Failed to start the TLS stand-in" << std::endl;
+        return 1;
+    }
+
+    test_connect_and_resume(server);
+    test_untrusted_certificate(server);
+    server.stop();
+
+    if (failures > 0)
+    {
+        std::cout << "\n[ERROR] " << failures << " TLS check(s) failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\n[SUCCESS] All TLS transport tests passed!" << std::endl;
+    return 0;
+}
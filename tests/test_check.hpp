@@ -0,0 +1,22 @@
+#pragma once
+
+#include <iostream>
+#include <string>
+
+// Assertion helper for the standalone test executables: each check prints
+// [OK] or [ERROR] with its description, and main() fails if any did.
+
+inline int failures = 0;
+
+inline void check(bool condition, const std::string &description)
+{
+    if (condition)
+    {
+        std::cout << "[OK] " << description << std::endl;
+    }
+    else
+    {
+        std::cout << "[ERROR] " << description << std::endl;
+        failures++;
+    }
+}
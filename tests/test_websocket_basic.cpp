@@ -1,5 +1,6 @@
 #include "coinbase_dtc_core/exchanges/coinbase/websocket_client.hpp"
 #include "coinbase_dtc_core/core/util/log.hpp"
+#include "coinbase_dtc_core/core/util/symbol_table.hpp"
 #include <iostream>
 #include <thread>
 #include <chrono>
@@ -10,7 +11,7 @@ int main()
 
     auto trade_callback = [](const open_dtc_server::exchanges::base::MarketTrade &trade)
     {
-        std::cout << "[TRADE] Symbol: " << trade.symbol
+        std::cout << "[TRADE] Symbol: " << open_dtc_server::util::SymbolTable::symbols().name(trade.symbol_id)
                   << ", Price: " << trade.price
                   << ", Volume: " << trade.volume
                   << ", Side: " << trade.side << std::endl;
@@ -18,7 +19,7 @@ int main()
 
     auto level2_callback = [](const open_dtc_server::exchanges::base::MarketLevel2 &level2)
     {
-        std::cout << "[L2] Symbol: " << level2.symbol
+        std::cout << "[L2] Symbol: " << open_dtc_server::util::SymbolTable::symbols().name(level2.symbol_id)
                   << ", Bid: " << level2.bid_price << "@" << level2.bid_size
                   << ", Ask: " << level2.ask_price << "@" << level2.ask_size << std::endl;
     };